@@ -97,6 +97,13 @@ void CActorComponent::Initialize()
 	// Manage our snaplocks.
 	m_pSnaplockComponent = m_pEntity->GetOrCreateComponent<CSnaplockComponent>();
 
+	// Attachments we query every frame for the eye and hand positions.
+	m_cameraBinding = m_characterBindings.AddAttachment("Camera");
+	m_leftEyeBinding = m_characterBindings.AddAttachment("LeftEye");
+	m_rightEyeBinding = m_characterBindings.AddAttachment("RightEye");
+	m_leftHandBinding = m_characterBindings.AddAttachment("LeftHand");
+	m_rightHandBinding = m_characterBindings.AddAttachment("RightHand");
+
 	// HACK: Need a way to add the default snaplocks in place. For now, I'm going to hard code them to test.
 	m_pSnaplockComponent->AddSnaplock(ISnaplock(SLT_ACTOR_HEAD, false));
 	m_pSnaplockComponent->AddSnaplock(ISnaplock(SLT_ACTOR_FACE, false));
@@ -190,26 +197,23 @@ const Vec3 CActorComponent::GetLocalEyePos() const
 		return eyePosition;
 
 	// Determine the position of the left and right eyes, using their average for eyePosition.
-	const IAttachmentManager* pAttachmentManager = pCharacter->GetIAttachmentManager();
-	if (pAttachmentManager)
+	m_characterBindings.Refresh(pCharacter);
+	if (pCharacter->GetIAttachmentManager())
 	{
 		// Did the animators define a camera for us to use?
-		const auto eyeCamera = pAttachmentManager->GetIndexByName("Camera");
-		const IAttachment* pCameraAttachment = pAttachmentManager->GetInterfaceByIndex(eyeCamera);
+		const IAttachment* pCameraAttachment = m_characterBindings.GetAttachment(m_cameraBinding);
 		if (pCameraAttachment)
 		{
 			// Early out and use the camera.
 			return GetEntity()->GetRotation() * pCameraAttachment->GetAttModelRelative().t;
 		}
 
-		const auto eyeLeft = pAttachmentManager->GetIndexByName("LeftEye");
-		const auto eyeRight = pAttachmentManager->GetIndexByName("RightEye");
 		Vec3 eyeLeftPosition;
 		Vec3 eyeRightPosition;
 		int eyeFlags = 0;
 
 		// Is there a left eye?
-		const IAttachment* pEyeLeftAttachment = pAttachmentManager->GetInterfaceByIndex(eyeLeft);
+		const IAttachment* pEyeLeftAttachment = m_characterBindings.GetAttachment(m_leftEyeBinding);
 		if (pEyeLeftAttachment)
 		{
 			eyeLeftPosition = GetEntity()->GetRotation() * pEyeLeftAttachment->GetAttModelRelative().t;
@@ -217,7 +221,7 @@ const Vec3 CActorComponent::GetLocalEyePos() const
 		}
 
 		// Is there a right eye?
-		const IAttachment* pEyeRightAttachment = pAttachmentManager->GetInterfaceByIndex(eyeRight);
+		const IAttachment* pEyeRightAttachment = m_characterBindings.GetAttachment(m_rightEyeBinding);
 		if (pEyeRightAttachment)
 		{
 			eyeRightPosition = GetEntity()->GetRotation() * pEyeRightAttachment->GetAttModelRelative().t;
@@ -263,22 +267,11 @@ Vec3 CActorComponent::GetLocalLeftHandPos() const
 	// A terrible default, in case we can't find the actual hand position.
 	const Vec3 handPosition { -0.2f, 0.3f, 1.3f };
 
-	// Get their character or bail early.
-	auto pCharacter = m_pAdvancedAnimationComponent->GetCharacter();
-	if (pCharacter)
+	// Did the animators define a hand bone for us to use?
+	if (const IAttachment* pAttachment = GetBoundAttachment(m_leftHandBinding))
 	{
-		const IAttachmentManager* pAttachmentManager = pCharacter->GetIAttachmentManager();
-		if (pAttachmentManager)
-		{
-			// Did the animators define a hand bone for us to use?
-			const auto handBone = pAttachmentManager->GetIndexByName("LeftHand");
-			const IAttachment* pAttachment = pAttachmentManager->GetInterfaceByIndex(handBone);
-			if (pAttachment)
-			{
-				// We have an exact position to return.
-				return GetEntity()->GetRotation() * pAttachment->GetAttModelRelative().t;
-			}
-		}
+		// We have an exact position to return.
+		return GetEntity()->GetRotation() * pAttachment->GetAttModelRelative().t;
 	}
 
 	return handPosition;
@@ -290,28 +283,30 @@ Vec3 CActorComponent::GetLocalRightHandPos() const
 	// A terrible default, in case we can't find the actual hand position.
 	const Vec3 handPosition { 0.2f, 0.3f, 1.3f };
 
-	// Get their character or bail early.
-	auto pCharacter = m_pAdvancedAnimationComponent->GetCharacter();
-	if (pCharacter)
+	// Did the animators define a hand bone for us to use?
+	if (const IAttachment* pAttachment = GetBoundAttachment(m_rightHandBinding))
 	{
-		const IAttachmentManager* pAttachmentManager = pCharacter->GetIAttachmentManager();
-		if (pAttachmentManager)
-		{
-			// Did the animators define a hand bone for us to use?
-			const auto handBone = pAttachmentManager->GetIndexByName("RightHand");
-			const IAttachment* pAttachment = pAttachmentManager->GetInterfaceByIndex(handBone);
-			if (pAttachment)
-			{
-				// We have an exact position to return.
-				return GetEntity()->GetRotation() * pAttachment->GetAttModelRelative().t;
-			}
-		}
+		// We have an exact position to return.
+		return GetEntity()->GetRotation() * pAttachment->GetAttModelRelative().t;
 	}
 
 	return handPosition;
 }
 
 
+const IAttachment* CActorComponent::GetBoundAttachment(CCharacterBindings::THandle handle) const
+{
+	// Get their character or bail early.
+	auto pCharacter = m_pAdvancedAnimationComponent->GetCharacter();
+	if (!pCharacter)
+		return nullptr;
+
+	m_characterBindings.Refresh(pCharacter);
+
+	return m_characterBindings.GetAttachment(handle);
+}
+
+
 bool CActorComponent::IsViewFirstPerson() const
 {
 	// The view is always considered third person, unless the local player is controlling this actor, and their view is
@@ -461,6 +456,9 @@ void CActorComponent::OnToggleFirstPerson()
 
 void CActorComponent::OnResetState()
 {
+	// The character may have been reloaded, and a new one can end up at the same address.
+	m_characterBindings.Invalidate();
+
 	// HACK: the CAdvancedAnimation doesn't allow us access to the action controller. This is a workaround.
 	m_pActionController = gEnv->pGameFramework->GetMannequinInterface().FindActionController(*GetEntity());
 	
@@ -590,9 +588,9 @@ void CActorComponent::OnActionItemDrop()
 
 		if (auto pInteractor = pTargetEntity->GetComponent<CEntityInteractionComponent>())
 		{
-			if (auto pInteraction = pInteractor->GetInteraction("interaction_drop").lock())
+			if (auto interaction = pInteractor->GetInteraction("interaction_drop"))
 			{
-				pInteraction->OnInteractionStart(*this);
+				interaction.OnInteractionStart(*this);
 			}
 		}
 	}
@@ -611,9 +609,9 @@ void CActorComponent::OnActionItemToss()
 
 		if (auto pInteractor = pTargetEntity->GetComponent<CEntityInteractionComponent>())
 		{
-			if (auto pInteraction = pInteractor->GetInteraction("interaction_toss").lock())
+			if (auto interaction = pInteractor->GetInteraction("interaction_toss"))
 			{
-				pInteraction->OnInteractionStart(*this);
+				interaction.OnInteractionStart(*this);
 			}
 		}
 	}
@@ -627,21 +625,20 @@ void CActorComponent::OnActionBarUse(int actionBarId)
 {
 	if (m_pAwareness)
 	{
-		auto results = m_pAwareness->GetNearDotFiltered();
-		if (results.size() > 0)
+		const EntityId targetId = m_pAwareness->GetBestInteractive();
+		if (targetId != INVALID_ENTITYID)
 		{
-			auto pTargetEntity = gEnv->pEntitySystem->GetEntity(results [0]);
+			auto pTargetEntity = gEnv->pEntitySystem->GetEntity(targetId);
 
 			if (auto pInteractor = pTargetEntity->GetComponent<CEntityInteractionComponent>())
 			{
 				// There's an interactor component, so this is an interactive entity.
-				auto verbs = pInteractor->GetVerbs();
+				const auto& verbs = pInteractor->GetVerbs();
 				if (verbs.size() >= actionBarId)
 				{
-					auto verb = verbs [actionBarId - 1];
-					auto pInteraction = pInteractor->GetInteraction(verb).lock();
-
-					pInteraction->OnInteractionStart(*this);
+					const auto& verb = verbs [actionBarId - 1];
+					if (auto interaction = pInteractor->GetInteraction(verb.c_str()))
+						interaction.OnInteractionStart(*this);
 				}
 				else
 				{
@@ -663,27 +660,27 @@ void CActorComponent::OnActionInspect()
 {
 	if (m_pAwareness)
 	{
-		auto results = m_pAwareness->GetNearDotFiltered();
-		if (results.size() > 0)
+		const EntityId targetId = m_pAwareness->GetBestInteractive();
+		if (targetId != INVALID_ENTITYID)
 		{
-			m_interactionEntityId = results [0];
+			m_interactionEntityId = targetId;
 			auto pInteractionEntity = gEnv->pEntitySystem->GetEntity(m_interactionEntityId);
 
 			if (auto pInteractor = pInteractionEntity->GetComponent<CEntityInteractionComponent>())
 			{
 				// There's an interactor component, so this is an interactive entity.
-				auto verbs = pInteractor->GetVerbs();
+				const auto& verbs = pInteractor->GetVerbs();
 				if (verbs.size() > 0)
 				{
-					auto verb = verbs [0];
+					const auto& verb = verbs [0];
 
 					// HACK: TEST making a call to the DRS system
 					auto pDrsProxy = crycomponent_cast<IEntityDynamicResponseComponent*> (pInteractionEntity->CreateProxy(ENTITY_PROXY_DYNAMICRESPONSE));
 					pDrsProxy->GetResponseActor()->QueueSignal(verb);
 
 					// #HACK: Another test - just calling the interaction directly instead.
-					auto pInteraction = pInteractor->GetInteraction(verb).lock();
-					pInteraction->OnInteractionStart(*this);
+					if (auto interaction = pInteractor->GetInteraction(verb.c_str()))
+						interaction.OnInteractionStart(*this);
 				}
 			}
 		}
@@ -700,16 +697,16 @@ void CActorComponent::OnActionInspectEnd()
 void CActorComponent::OnActionInteractionStart()
 {
 	// You shouldn't be allowed to start another interaction before the last one is completed.
-	//if (m_pInteraction != nullptr)
+	//if (m_interaction)
 	if (isBusyInInteraction)
 		return;
 
 	if (m_pAwareness)
 	{
-		auto results = m_pAwareness->GetNearDotFiltered();
-		if (results.size() > 0)
+		const EntityId targetId = m_pAwareness->GetBestInteractive();
+		if (targetId != INVALID_ENTITYID)
 		{
-			m_interactionEntityId = results [0];
+			m_interactionEntityId = targetId;
 			auto pInteractionEntity = gEnv->pEntitySystem->GetEntity(m_interactionEntityId);
 
 			// HACK: Another test, this time of the slaved animation code.
@@ -726,7 +723,7 @@ void CActorComponent::OnActionInteractionStart()
 			{
 				// There's an interactor component, so this is an interactive entity.
 				// #TODO: We should really only process an 'interact' verb - not simply the first entry.
-				auto verbs = pInteractor->GetVerbs();
+				const auto& verbs = pInteractor->GetVerbs();
 				if (verbs.size() > 0)
 				{
 					// Display the verbs in a cheap manner.
@@ -738,12 +735,15 @@ void CActorComponent::OnActionInteractionStart()
 						index++;
 					}
 
-					auto verb = verbs [0];
+					const auto& verb = verbs [0];
 
 					// #HACK: Another test - just calling the interaction directly instead.
-					m_pInteraction = pInteractor->GetInteraction(verb).lock();
-					CryLogAlways("Player started interacting with: %s", m_pInteraction->GetVerbUI());
-					m_pInteraction->OnInteractionStart(*this);
+					m_interaction = pInteractor->GetInteraction(verb.c_str());
+					if (m_interaction)
+					{
+						CryLogAlways("Player started interacting with: %s", m_interaction.GetVerbUI());
+						m_interaction.OnInteractionStart(*this);
+					}
 				}
 			}
 		}
@@ -753,10 +753,10 @@ void CActorComponent::OnActionInteractionStart()
 
 void CActorComponent::OnActionInteractionTick()
 {
-	if (m_pInteraction)
+	if (m_interaction)
 	{
-		CryWatch("Interacting with: %s", m_pInteraction->GetVerbUI());
-		m_pInteraction->OnInteractionTick(*this);
+		CryWatch("Interacting with: %s", m_interaction.GetVerbUI());
+		m_interaction.OnInteractionTick(*this);
 	}
 	else
 	{
@@ -767,10 +767,10 @@ void CActorComponent::OnActionInteractionTick()
 
 void CActorComponent::OnActionInteractionEnd()
 {
-	if (m_pInteraction)
+	if (m_interaction)
 	{
-		CryLogAlways("Player stopped interacting with: %s", m_pInteraction->GetVerbUI());
-		m_pInteraction->OnInteractionComplete(*this);
+		CryLogAlways("Player stopped interacting with: %s", m_interaction.GetVerbUI());
+		m_interaction.OnInteractionComplete(*this);
 	}
 	else
 	{
@@ -779,22 +779,22 @@ void CActorComponent::OnActionInteractionEnd()
 }
 
 
-void CActorComponent::InteractionStart(IInteraction* pInteraction)
+void CActorComponent::InteractionStart(const IInteraction* pInteraction)
 {
 	isBusyInInteraction = true;
 }
 
 
-void CActorComponent::InteractionTick(IInteraction* pInteraction)
+void CActorComponent::InteractionTick(const IInteraction* pInteraction)
 {
 }
 
 
-void CActorComponent::InteractionEnd(IInteraction* pInteraction)
+void CActorComponent::InteractionEnd(const IInteraction* pInteraction)
 {
 	// No longer valid.
 	isBusyInInteraction = false;
-	m_pInteraction = nullptr;
+	m_interaction = CBoundInteraction();
 	m_interactionEntityId = INVALID_ENTITYID; // HACK: FIX: This seems weak, look for a better way to handle keeping an entity Id for later.
 }
 
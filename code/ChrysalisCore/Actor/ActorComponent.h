@@ -9,6 +9,7 @@
 #include <Components/Player/Input/PlayerInputComponent.h>
 #include <Actor/ActorControllerComponent.h>
 #include <Entities/Interaction/IEntityInteraction.h>
+#include <Utility/CharacterBindings.h>
 
 
 namespace Chrysalis
@@ -225,7 +226,7 @@ public:
 	
 	\param [in,out]	pInteraction If non-null, the interaction.
 	**/
-	virtual void InteractionStart(IInteraction* pInteraction) = 0;
+	virtual void InteractionStart(const IInteraction* pInteraction) = 0;
 
 
 	/**
@@ -233,7 +234,7 @@ public:
 	
 	\param [in,out]	pInteraction If non-null, the interaction.
 	**/
-	virtual void InteractionTick(IInteraction* pInteraction) = 0;
+	virtual void InteractionTick(const IInteraction* pInteraction) = 0;
 
 
 	/**
@@ -242,7 +243,7 @@ public:
 	
 	\param [in,out]	pInteraction If non-null, the interaction.
 	**/
-	virtual void InteractionEnd(IInteraction* pInteraction) = 0;
+	virtual void InteractionEnd(const IInteraction* pInteraction) = 0;
 
 
 	/**
@@ -525,6 +526,24 @@ private:
 	/** The pre-determined fate for this actor. */
 	CFate m_fate;
 
+	/** The camera, eye and hand attachments, bound once for each character so the position queries don't look them up
+	by name every frame. */
+	mutable CCharacterBindings m_characterBindings;
+	CCharacterBindings::THandle m_cameraBinding { CCharacterBindings::InvalidHandle };
+	CCharacterBindings::THandle m_leftEyeBinding { CCharacterBindings::InvalidHandle };
+	CCharacterBindings::THandle m_rightEyeBinding { CCharacterBindings::InvalidHandle };
+	CCharacterBindings::THandle m_leftHandBinding { CCharacterBindings::InvalidHandle };
+	CCharacterBindings::THandle m_rightHandBinding { CCharacterBindings::InvalidHandle };
+
+	/**
+	Gets one of the actor's bound attachments, binding them again first if the character has changed.
+
+	\param	handle	The handle of the binding.
+
+	\return	The attachment, or null if there's no character or it doesn't have the attachment.
+	**/
+	const IAttachment* GetBoundAttachment(CCharacterBindings::THandle handle) const;
+
 
 	// ***
 	// *** AI / Player Control
@@ -563,7 +582,7 @@ public:
 	bool IsJogging() const override { return m_pActorControllerComponent->IsJogging(); };
 
 	/** Is the actor currently interacting with another entity? */
-	bool IsInteracting() const { return m_pInteraction != nullptr; }
+	bool IsInteracting() const { return static_cast<bool>(m_interaction); }
 
 	/**
 	Call this to place the actor into "interaction mode". This should be called by any section of code that wants to
@@ -571,20 +590,20 @@ public:
 	has completed. Generally, you will want whatever process is kicked off by the 'OnActionInteractionStart' function to
 	make a call to this at the start of it's specific interaction.
 	**/
-	void InteractionStart(IInteraction* pInteraction) override;
+	void InteractionStart(const IInteraction* pInteraction) override;
 
 	/** Received at intervals during an on-going interaction. */
-	void InteractionTick(IInteraction* pInteraction) override;
+	void InteractionTick(const IInteraction* pInteraction) override;
 
 	/** Call this to remove the actor from "interaction mode". This will open the actor up to accepting interactions again. */
-	void InteractionEnd(IInteraction* pInteraction) override;
+	void InteractionEnd(const IInteraction* pInteraction) override;
 
 private:
 	/** If we are interacting with an entity, it is this entity. */
 	EntityId m_interactionEntityId { INVALID_ENTITYID };
 
 	/** If we're interacting with something, this is the actual interaction. */
-	IInteractionPtr m_pInteraction;
+	CBoundInteraction m_interaction;
 
 	/** True when the actor is busy interaction with something, and shouldn't be allowed to start a new interaction until
 	the first is finished. */
@@ -51,9 +51,6 @@ void CCharacterComponent::ProcessEvent(const SEntityEvent& event)
 		case EEntityEvent::TransformChangeFinishedInEditor:
 			OnResetState();
 			break;
-
-		case EEntityEvent::Update:
-			break;
 	}
 }
 
@@ -22,7 +22,7 @@ protected:
 	// IEntityComponent
 	void Initialize() override;
 	void ProcessEvent(const SEntityEvent& event) override;
-	Cry::Entity::EntityEventMask GetEventMask() const override { return EventToMask(EEntityEvent::Update); }
+	Cry::Entity::EntityEventMask GetEventMask() const override { return EventToMask(EEntityEvent::LevelStarted) | EventToMask(EEntityEvent::Reset) | EventToMask(EEntityEvent::EditorPropertyChanged) | EventToMask(EEntityEvent::TransformChangeFinishedInEditor); }
 	// ~IEntityComponent
 
 public:
@@ -40,9 +40,6 @@ void CMountComponent::ProcessEvent(const SEntityEvent& event)
 		case EEntityEvent::TransformChangeFinishedInEditor:
 			OnResetState();
 			break;
-
-		case EEntityEvent::Update:
-			break;
 	}
 }
 
@@ -166,7 +166,8 @@ const CActorStateMovement::TStateIndex CActorStateMovement::Root(CActorControlle
 		case STATE_EVENT_DEBUG:
 		{
 			AUTOENUM_BUILDNAMEARRAY(stateFlags, eActorStateFlags);
-			STATE_DEBUG_EVENT_LOG(this, event, false, state_red, "Active: StateMovement: CurrentFlags: %s", AutoEnum_GetStringFromBitfield(m_flags.GetRawFlags(), stateFlags, sizeof(stateFlags) / sizeof(char*)).c_str());
+			char flagsText [512];
+			STATE_DEBUG_EVENT_LOG(this, event, false, state_red, "Active: StateMovement: CurrentFlags: %s", AutoEnum_FormatBitfield(flagsText, sizeof(flagsText), m_flags.GetRawFlags(), stateFlags, sizeof(stateFlags) / sizeof(char*)));
 		}
 		break;
 	}
@@ -40,9 +40,6 @@ void CPetComponent::ProcessEvent(const SEntityEvent& event)
 		case EEntityEvent::TransformChangeFinishedInEditor:
 			OnResetState();
 			break;
-
-		case EEntityEvent::Update:
-			break;
 	}
 }
 
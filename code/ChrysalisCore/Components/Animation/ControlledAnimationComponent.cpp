@@ -129,25 +129,12 @@ void CControlledAnimationComponent::ProcessEvent(const SEntityEvent& event)
 			ResetObject();
 		}
 		break;
-
-		case EEntityEvent::Update:
-		{
-			SEntityUpdateContext* pCtx = (SEntityUpdateContext*)event.nParam [0];
-			Update(pCtx);
-		}
-		break;
 	}
 
 	CBaseMeshComponent::ProcessEvent(event);
 }
 
 
-void CControlledAnimationComponent::Update(SEntityUpdateContext* pCtx)
-{
-	const float frameTime = pCtx->fFrameTime;
-}
-
-
 void CControlledAnimationComponent::SeekFrame(float frameTime)
 {
 	// Hang on to this, we may want to lerp in future.
@@ -18,7 +18,7 @@ protected:
 	// IEntityComponent
 	virtual void Initialize() final;
 	void ProcessEvent(const SEntityEvent& event) override;
-	Cry::Entity::EntityEventMask GetEventMask() const override { return Cry::DefaultComponents::CBaseMeshComponent::GetEventMask() | EntityEventMask(EEntityEvent::Update); }
+	Cry::Entity::EntityEventMask GetEventMask() const override { return Cry::DefaultComponents::CBaseMeshComponent::GetEventMask(); }
 	// ~IEntityComponent
 
 	// IEditorEntityComponent
@@ -62,8 +62,6 @@ public:
 	virtual void SetMeshType(Cry::DefaultComponents::EMeshType type) { SetType(type); }
 
 protected:
-	virtual void Update(SEntityUpdateContext* pCtx);
-
 	CryCharAnimationParams m_animationParams;
 	Schematyc::MaterialFileName m_materialPath;
 	//Schematyc::CharacterFileName m_filePath;
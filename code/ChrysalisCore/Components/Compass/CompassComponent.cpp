@@ -36,9 +36,9 @@ void CCompassComponent::Initialize()
 	m_interactor = GetEntity()->GetOrCreateComponent<CEntityInteractionComponent>();
 	if (m_interactor)
 	{
-		m_interactor->AddInteraction(std::make_shared<CInteractionItemInspect>(this));
-		m_interactor->AddInteraction(std::make_shared<CInteractionItemPickup>(this));
-		m_interactor->AddInteraction(std::make_shared<CInteractionItemDrop>(this));
+		m_interactor->AddInteraction<CInteractionItemInspect>(this);
+		m_interactor->AddInteraction<CInteractionItemPickup>(this);
+		m_interactor->AddInteraction<CInteractionItemDrop>(this);
 	}
 }
 
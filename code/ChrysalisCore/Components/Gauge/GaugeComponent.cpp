@@ -1,6 +1,7 @@
 #include <StdAfx.h>
 
 #include "GaugeComponent.h"
+#include <Plugin/ChrysalisCorePlugin.h>
 
 
 namespace Chrysalis
@@ -47,11 +48,30 @@ void CGaugeComponent::ReflectType(Schematyc::CTypeDesc<CGaugeComponent>& desc)
 
 void CGaugeComponent::Initialize()
 {
+	m_needleBinding = m_characterBindings.AddAttachment("hours"); // TODO: switch this to needle or have a widget to pick it out of a list
+
+	if (auto pNeedleSystem = CChrysalisCorePlugin::Get()->GetNeedleSystem())
+		m_needleOwnerId = pNeedleSystem->Register(this);
+
 	LoadFromDisk();
 	ResetObject();
 }
 
 
+void CGaugeComponent::OnShutDown()
+{
+	if (m_needleOwnerId != CNeedleSystem::InvalidOwnerId)
+	{
+		if (auto pNeedleSystem = CChrysalisCorePlugin::Get()->GetNeedleSystem())
+			pNeedleSystem->Unregister(m_needleOwnerId);
+
+		m_needleOwnerId = CNeedleSystem::InvalidOwnerId;
+	}
+
+	CBaseMeshComponent::OnShutDown();
+}
+
+
 void CGaugeComponent::ProcessEvent(const SEntityEvent& event)
 {
 	switch (event.event)
@@ -63,13 +83,6 @@ void CGaugeComponent::ProcessEvent(const SEntityEvent& event)
 			ResetObject();
 		}
 		break;
-
-		case EEntityEvent::Update:
-		{
-			SEntityUpdateContext* pCtx = (SEntityUpdateContext*)event.nParam [0];
-			Update(pCtx);
-		}
-		break;
 	}
 
 	CBaseMeshComponent::ProcessEvent(event);
@@ -86,6 +99,15 @@ void CGaugeComponent::LoadFromDisk()
 	{
 		m_pCachedCharacter = nullptr;
 	}
+
+	m_characterBindings.Invalidate();
+
+	// The needle needs binding to the new character.
+	if (m_needleOwnerId != CNeedleSystem::InvalidOwnerId)
+	{
+		if (auto pNeedleSystem = CChrysalisCorePlugin::Get()->GetNeedleSystem())
+			pNeedleSystem->RebuildNeedles(m_needleOwnerId);
+	}
 }
 
 
@@ -98,27 +120,37 @@ void CGaugeComponent::ResetObject()
 	}
 
 	m_pEntity->SetCharacter(m_pCachedCharacter, GetOrMakeEntitySlotId() | ENTITY_SLOT_ACTUAL, false);
+	PushValue();
 }
 
 
-void CGaugeComponent::Update(SEntityUpdateContext* pCtx)
+IEntity* CGaugeComponent::GetNeedles(std::vector<SNeedleBinding>& needles, int& slotId)
 {
-	if (m_pCachedCharacter)
+	slotId = GetEntitySlotId();
+
+	// Bind to whatever is in the slot, which the needle system checks against each frame.
+	if (ICharacterInstance* pCharacter = (slotId >= 0) ? m_pEntity->GetCharacter(slotId) : nullptr)
 	{
-		// If we can access the attachments, we can try and find the rotation for each hand.
-		const IAttachmentManager* pAttachmentManager = m_pCachedCharacter->GetIAttachmentManager();
-		if (pAttachmentManager)
-		{
-			// Is there a needle joint?
-			const auto needleIndex = pAttachmentManager->GetIndexByName("hours"); // TODO: switch this to needle or have a widget to pick it out of a list
-			if (IAttachment* pNeedleAttachment = pAttachmentManager->GetInterfaceByIndex(needleIndex))
-			{
-				QuatT trans = pNeedleAttachment->GetAttAbsoluteDefault();
-				const float radians = DEG2RAD(m_gaugeProperties.needleValue);
-				trans.q = Quat::CreateRotationXYZ(m_gaugeProperties.axis * radians);
-				pNeedleAttachment->SetAttAbsoluteDefault(trans);
-			}
-		}
+		m_characterBindings.Refresh(pCharacter);
+
+		// The value is in degrees.
+		SNeedleBinding needle;
+		needle.pAttachment = m_characterBindings.GetAttachment(m_needleBinding);
+		needle.axis = m_gaugeProperties.axis;
+		needle.degreesPerInput = Vec3(1.0f, 0.0f, 0.0f);
+		needles.push_back(needle);
+	}
+
+	return GetEntity();
+}
+
+
+void CGaugeComponent::PushValue()
+{
+	if (m_needleOwnerId != CNeedleSystem::InvalidOwnerId)
+	{
+		if (auto pNeedleSystem = CChrysalisCorePlugin::Get()->GetNeedleSystem())
+			pNeedleSystem->SetInputs(m_needleOwnerId, Vec3(m_gaugeProperties.needleValue, 0.0f, 0.0f));
 	}
 }
 
@@ -2,6 +2,8 @@
 
 #include "Entities/Interaction/IEntityInteraction.h"
 #include <DefaultComponents/Geometry/BaseMeshComponent.h>
+#include <Utility/CharacterBindings.h>
+#include <Components/TimePiece/NeedleSystem.h>
 
 
 namespace Chrysalis
@@ -12,6 +14,7 @@ A Gauge extension.
 **/
 class CGaugeComponent
 	: public Cry::DefaultComponents::CBaseMeshComponent
+	, public INeedleOwner
 {
 protected:
 	friend CChrysalisCorePlugin;
@@ -19,10 +22,14 @@ protected:
 
 	// IEntityComponent
 	void Initialize() override;
+	void OnShutDown() override;
 	void ProcessEvent(const SEntityEvent& event) override;
-	Cry::Entity::EntityEventMask GetEventMask() const override { return Cry::DefaultComponents::CBaseMeshComponent::GetEventMask() | EntityEventMask(EEntityEvent::Update); }
 	// ~IEntityComponent
 
+	// INeedleOwner
+	IEntity* GetNeedles(std::vector<SNeedleBinding>& needles, int& slotId) override;
+	// ~INeedleOwner
+
 	// IEditorEntityComponent
 	//virtual bool SetMaterial(int slotId, const char* szMaterial) override;
 	// ~IEditorEntityComponent
@@ -47,8 +54,6 @@ public:
 		Schematyc::Range<0, 360> needleValue = 0.0f;
 	};
 
-	virtual void Update(SEntityUpdateContext* pCtx);
-
 	virtual void SetCharacterFile(const char* szPath) { m_filePath = szPath; };
 	const char* GetCharacterFile() const { return m_filePath.value.c_str(); }
 
@@ -64,6 +69,7 @@ public:
 	void SetNeedle(const float needleValue)
 	{
 		m_gaugeProperties.needleValue = needleValue;
+		PushValue();
 	}
 
 protected:
@@ -71,6 +77,15 @@ protected:
 	Schematyc::MaterialFileName m_materialPath;
 	_smart_ptr<ICharacterInstance> m_pCachedCharacter = nullptr;
 	SGaugeProperties m_gaugeProperties;
+
+	/** The needle attachment, bound once for each character rather than found by name each time it's needed. */
+	CCharacterBindings m_characterBindings;
+	CCharacterBindings::THandle m_needleBinding { CCharacterBindings::InvalidHandle };
+
+	/** Sends the value to the needle system, which poses the needle. */
+	void PushValue();
+
+	CNeedleSystem::TOwnerId m_needleOwnerId { CNeedleSystem::InvalidOwnerId };
 };
 
 
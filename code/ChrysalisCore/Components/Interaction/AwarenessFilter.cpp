@@ -0,0 +1,396 @@
+#include <StdAfx.h>
+
+#include "AwarenessFilter.h"
+#include <functional>
+
+#if CRY_PLATFORM_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace Chrysalis
+{
+/** The number of candidates tested at once by the batch filters. */
+static const size_t batchSize = 4;
+
+
+void CAwarenessCandidates::Build(const std::vector<CAwarenessGrid::SProxy>& proxies)
+{
+	m_count = proxies.size();
+	m_stride = (m_count + batchSize - 1) & ~(batchSize - 1);
+
+	// The padding is zeroed, and any bits it produces are cleared from the masks afterwards.
+	m_data.assign(m_stride * eS_COUNT, 0.0f);
+	ResetMask(m_hasObb);
+
+	float* pMinX = GetStream(eS_MinX);
+	float* pMinY = GetStream(eS_MinY);
+	float* pMaxX = GetStream(eS_MaxX);
+	float* pMaxY = GetStream(eS_MaxY);
+	float* pCentreX = GetStream(eS_CentreX);
+	float* pCentreY = GetStream(eS_CentreY);
+	float* pCentreZ = GetStream(eS_CentreZ);
+	float* pObbCentreX = GetStream(eS_ObbCentreX);
+	float* pObbCentreY = GetStream(eS_ObbCentreY);
+	float* pObbCentreZ = GetStream(eS_ObbCentreZ);
+	float* pAxis [3][3] = {
+		{ GetStream(eS_Axis00), GetStream(eS_Axis01), GetStream(eS_Axis02) },
+		{ GetStream(eS_Axis10), GetStream(eS_Axis11), GetStream(eS_Axis12) },
+		{ GetStream(eS_Axis20), GetStream(eS_Axis21), GetStream(eS_Axis22) },
+	};
+	float* pHalfX = GetStream(eS_HalfX);
+	float* pHalfY = GetStream(eS_HalfY);
+	float* pHalfZ = GetStream(eS_HalfZ);
+
+	for (size_t i = 0; i < m_count; ++i)
+	{
+		const auto& proxy = proxies [i];
+		const Vec3 centre = proxy.worldBounds.GetCenter();
+
+		pMinX [i] = proxy.worldBounds.min.x;
+		pMinY [i] = proxy.worldBounds.min.y;
+		pMaxX [i] = proxy.worldBounds.max.x;
+		pMaxY [i] = proxy.worldBounds.max.y;
+		pCentreX [i] = centre.x;
+		pCentreY [i] = centre.y;
+		pCentreZ [i] = centre.z;
+
+		if (proxy.hasLocalBounds)
+		{
+			// Fold the OBB's own centre offset into its world position, so the filter only needs the one point.
+			const Vec3 obbCentre = proxy.worldPos + proxy.obb.m33 * proxy.obb.c;
+
+			pObbCentreX [i] = obbCentre.x;
+			pObbCentreY [i] = obbCentre.y;
+			pObbCentreZ [i] = obbCentre.z;
+
+			for (int row = 0; row < 3; ++row)
+			{
+				for (int column = 0; column < 3; ++column)
+					pAxis [row][column][i] = proxy.obb.m33(row, column);
+			}
+
+			pHalfX [i] = proxy.obb.h.x;
+			pHalfY [i] = proxy.obb.h.y;
+			pHalfZ [i] = proxy.obb.h.z;
+
+			m_hasObb [i >> 5] |= 1u << (i & 31);
+		}
+	}
+}
+
+
+void CAwarenessCandidates::FilterNearScalar(const Vec3& point, float radius, TCandidateMask& mask) const
+{
+	ResetMask(mask);
+
+	const float* pMinX = GetStream(eS_MinX);
+	const float* pMinY = GetStream(eS_MinY);
+	const float* pMaxX = GetStream(eS_MaxX);
+	const float* pMaxY = GetStream(eS_MaxY);
+	const float radiusSqr = radius * radius;
+
+	for (size_t i = 0; i < m_count; ++i)
+	{
+		// Flatten the bounds to the height of the point, turning the test into a circle rather than a sphere.
+		const AABB aabb(Vec3(pMinX [i], pMinY [i], point.z), Vec3(pMaxX [i], pMaxY [i], point.z));
+
+		if (aabb.GetDistanceSqr(point) <= radiusSqr)
+			mask [i >> 5] |= 1u << (i & 31);
+	}
+}
+
+
+void CAwarenessCandidates::FilterLinesegScalar(const Lineseg& lineseg, TCandidateMask& mask) const
+{
+	ResetMask(mask);
+
+	for (size_t i = 0; i < m_count; ++i)
+	{
+		if (!IsCandidateSet(m_hasObb, i))
+			continue;
+
+		OBB obb;
+		obb.m33 = Matrix33(
+			GetStream(eS_Axis00) [i], GetStream(eS_Axis01) [i], GetStream(eS_Axis02) [i],
+			GetStream(eS_Axis10) [i], GetStream(eS_Axis11) [i], GetStream(eS_Axis12) [i],
+			GetStream(eS_Axis20) [i], GetStream(eS_Axis21) [i], GetStream(eS_Axis22) [i]);
+		obb.h = Vec3(GetStream(eS_HalfX) [i], GetStream(eS_HalfY) [i], GetStream(eS_HalfZ) [i]);
+		obb.c = Vec3(ZERO);
+
+		const Vec3 obbCentre(GetStream(eS_ObbCentreX) [i], GetStream(eS_ObbCentreY) [i], GetStream(eS_ObbCentreZ) [i]);
+
+		if (Overlap::Lineseg_OBB(lineseg, obbCentre, obb))
+			mask [i >> 5] |= 1u << (i & 31);
+	}
+}
+
+
+void CAwarenessCandidates::FilterDotScalar(const Vec3& point, const Vec3& dir, float minDot, float maxDot, TCandidateMask& mask, std::vector<float>& scores) const
+{
+	ResetMask(mask);
+	scores.resize(m_stride);
+
+	for (size_t i = 0; i < m_count; ++i)
+	{
+		const Vec3 centre(GetStream(eS_CentreX) [i], GetStream(eS_CentreY) [i], GetStream(eS_CentreZ) [i]);
+		const Vec3 dirToCentre = (centre - point).normalized();
+		const float dot = dirToCentre.dot(dir);
+
+		if ((dot >= minDot) && (dot <= maxDot))
+		{
+			scores [i] = (1.0f - dot) * (centre - point).len();
+			mask [i >> 5] |= 1u << (i & 31);
+		}
+	}
+}
+
+
+#if CRY_PLATFORM_SSE2
+/** Gets the absolute value of each lane. */
+static inline __m128 AbsPs(__m128 value)
+{
+	return _mm_andnot_ps(_mm_set1_ps(-0.0f), value);
+}
+
+
+void CAwarenessCandidates::FilterNear(const Vec3& point, float radius, TCandidateMask& mask) const
+{
+	ResetMask(mask);
+
+	const float* pMinX = GetStream(eS_MinX);
+	const float* pMinY = GetStream(eS_MinY);
+	const float* pMaxX = GetStream(eS_MaxX);
+	const float* pMaxY = GetStream(eS_MaxY);
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 pointX = _mm_set1_ps(point.x);
+	const __m128 pointY = _mm_set1_ps(point.y);
+	const __m128 radiusSqr = _mm_set1_ps(radius * radius);
+
+	for (size_t i = 0; i < m_stride; i += batchSize)
+	{
+		// Distance from the point to the nearest edge on each axis, or zero if it's inside.
+		const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(pMinX + i), pointX), _mm_sub_ps(pointX, _mm_loadu_ps(pMaxX + i))), zero);
+		const __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(pMinY + i), pointY), _mm_sub_ps(pointY, _mm_loadu_ps(pMaxY + i))), zero);
+		const __m128 distanceSqr = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+		mask [i >> 5] |= static_cast<uint32>(_mm_movemask_ps(_mm_cmple_ps(distanceSqr, radiusSqr))) << (i & 31);
+	}
+
+	ClearPadding(mask);
+}
+
+
+void CAwarenessCandidates::FilterLineseg(const Lineseg& lineseg, TCandidateMask& mask) const
+{
+	ResetMask(mask);
+
+	// The separating axis test from Overlap::Lineseg_OBB, with the segment moved into the space of each OBB.
+	const Vec3 segmentCentre = (lineseg.start + lineseg.end) * 0.5f;
+	const Vec3 segmentHalf = (lineseg.end - lineseg.start) * 0.5f;
+
+	const __m128 segmentCentreX = _mm_set1_ps(segmentCentre.x);
+	const __m128 segmentCentreY = _mm_set1_ps(segmentCentre.y);
+	const __m128 segmentCentreZ = _mm_set1_ps(segmentCentre.z);
+	const __m128 segmentHalfX = _mm_set1_ps(segmentHalf.x);
+	const __m128 segmentHalfY = _mm_set1_ps(segmentHalf.y);
+	const __m128 segmentHalfZ = _mm_set1_ps(segmentHalf.z);
+
+	for (size_t i = 0; i < m_stride; i += batchSize)
+	{
+		const __m128 a00 = _mm_loadu_ps(GetStream(eS_Axis00) + i);
+		const __m128 a01 = _mm_loadu_ps(GetStream(eS_Axis01) + i);
+		const __m128 a02 = _mm_loadu_ps(GetStream(eS_Axis02) + i);
+		const __m128 a10 = _mm_loadu_ps(GetStream(eS_Axis10) + i);
+		const __m128 a11 = _mm_loadu_ps(GetStream(eS_Axis11) + i);
+		const __m128 a12 = _mm_loadu_ps(GetStream(eS_Axis12) + i);
+		const __m128 a20 = _mm_loadu_ps(GetStream(eS_Axis20) + i);
+		const __m128 a21 = _mm_loadu_ps(GetStream(eS_Axis21) + i);
+		const __m128 a22 = _mm_loadu_ps(GetStream(eS_Axis22) + i);
+		const __m128 hx = _mm_loadu_ps(GetStream(eS_HalfX) + i);
+		const __m128 hy = _mm_loadu_ps(GetStream(eS_HalfY) + i);
+		const __m128 hz = _mm_loadu_ps(GetStream(eS_HalfZ) + i);
+
+		// Segment centre relative to the OBB, then both it and the half segment into OBB space (transpose multiply).
+		const __m128 wx = _mm_sub_ps(segmentCentreX, _mm_loadu_ps(GetStream(eS_ObbCentreX) + i));
+		const __m128 wy = _mm_sub_ps(segmentCentreY, _mm_loadu_ps(GetStream(eS_ObbCentreY) + i));
+		const __m128 wz = _mm_sub_ps(segmentCentreZ, _mm_loadu_ps(GetStream(eS_ObbCentreZ) + i));
+
+		const __m128 tx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a00, wx), _mm_mul_ps(a10, wy)), _mm_mul_ps(a20, wz));
+		const __m128 ty = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a01, wx), _mm_mul_ps(a11, wy)), _mm_mul_ps(a21, wz));
+		const __m128 tz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a02, wx), _mm_mul_ps(a12, wy)), _mm_mul_ps(a22, wz));
+
+		const __m128 dx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a00, segmentHalfX), _mm_mul_ps(a10, segmentHalfY)), _mm_mul_ps(a20, segmentHalfZ));
+		const __m128 dy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a01, segmentHalfX), _mm_mul_ps(a11, segmentHalfY)), _mm_mul_ps(a21, segmentHalfZ));
+		const __m128 dz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a02, segmentHalfX), _mm_mul_ps(a12, segmentHalfY)), _mm_mul_ps(a22, segmentHalfZ));
+
+		const __m128 adx = AbsPs(dx);
+		const __m128 ady = AbsPs(dy);
+		const __m128 adz = AbsPs(dz);
+
+		// The three face axes of the OBB.
+		__m128 separated = _mm_cmpgt_ps(AbsPs(tx), _mm_add_ps(hx, adx));
+		separated = _mm_or_ps(separated, _mm_cmpgt_ps(AbsPs(ty), _mm_add_ps(hy, ady)));
+		separated = _mm_or_ps(separated, _mm_cmpgt_ps(AbsPs(tz), _mm_add_ps(hz, adz)));
+
+		// The cross products of the segment with each of the face axes.
+		separated = _mm_or_ps(separated, _mm_cmpgt_ps(AbsPs(_mm_sub_ps(_mm_mul_ps(tz, dy), _mm_mul_ps(ty, dz))),
+			_mm_add_ps(AbsPs(_mm_mul_ps(hy, dz)), AbsPs(_mm_mul_ps(hz, dy)))));
+		separated = _mm_or_ps(separated, _mm_cmpgt_ps(AbsPs(_mm_sub_ps(_mm_mul_ps(tx, dz), _mm_mul_ps(tz, dx))),
+			_mm_add_ps(AbsPs(_mm_mul_ps(hx, dz)), AbsPs(_mm_mul_ps(hz, dx)))));
+		separated = _mm_or_ps(separated, _mm_cmpgt_ps(AbsPs(_mm_sub_ps(_mm_mul_ps(ty, dx), _mm_mul_ps(tx, dy))),
+			_mm_add_ps(AbsPs(_mm_mul_ps(hx, dy)), AbsPs(_mm_mul_ps(hy, dx)))));
+
+		mask [i >> 5] |= static_cast<uint32>(~_mm_movemask_ps(separated) & 0xf) << (i & 31);
+	}
+
+	// Candidates without oriented bounds (and the padding) never pass.
+	for (size_t word = 0; word < mask.size(); ++word)
+		mask [word] &= m_hasObb [word];
+}
+
+
+void CAwarenessCandidates::FilterDot(const Vec3& point, const Vec3& dir, float minDot, float maxDot, TCandidateMask& mask, std::vector<float>& scores) const
+{
+	ResetMask(mask);
+	scores.resize(m_stride);
+
+	const float* pCentreX = GetStream(eS_CentreX);
+	const float* pCentreY = GetStream(eS_CentreY);
+	const float* pCentreZ = GetStream(eS_CentreZ);
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 pointX = _mm_set1_ps(point.x);
+	const __m128 pointY = _mm_set1_ps(point.y);
+	const __m128 pointZ = _mm_set1_ps(point.z);
+	const __m128 dirX = _mm_set1_ps(dir.x);
+	const __m128 dirY = _mm_set1_ps(dir.y);
+	const __m128 dirZ = _mm_set1_ps(dir.z);
+	const __m128 minDotPs = _mm_set1_ps(minDot);
+	const __m128 maxDotPs = _mm_set1_ps(maxDot);
+
+	for (size_t i = 0; i < m_stride; i += batchSize)
+	{
+		const __m128 dx = _mm_sub_ps(_mm_loadu_ps(pCentreX + i), pointX);
+		const __m128 dy = _mm_sub_ps(_mm_loadu_ps(pCentreY + i), pointY);
+		const __m128 dz = _mm_sub_ps(_mm_loadu_ps(pCentreZ + i), pointZ);
+
+		const __m128 lengthSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+		const __m128 length = _mm_sqrt_ps(lengthSqr);
+
+		// A centre sitting right on the point has no direction, which gives it a dot product of zero, like Vec3::normalized.
+		const __m128 inverseLength = _mm_and_ps(_mm_cmpgt_ps(lengthSqr, zero), _mm_div_ps(one, length));
+
+		const __m128 dot = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dirX), _mm_mul_ps(dy, dirY)), _mm_mul_ps(dz, dirZ)), inverseLength);
+		const __m128 passed = _mm_and_ps(_mm_cmpge_ps(dot, minDotPs), _mm_cmple_ps(dot, maxDotPs));
+
+		_mm_storeu_ps(&scores [i], _mm_mul_ps(_mm_sub_ps(one, dot), length));
+		mask [i >> 5] |= static_cast<uint32>(_mm_movemask_ps(passed)) << (i & 31);
+	}
+
+	ClearPadding(mask);
+}
+#else
+void CAwarenessCandidates::FilterNear(const Vec3& point, float radius, TCandidateMask& mask) const
+{
+	FilterNearScalar(point, radius, mask);
+}
+
+
+void CAwarenessCandidates::FilterLineseg(const Lineseg& lineseg, TCandidateMask& mask) const
+{
+	FilterLinesegScalar(lineseg, mask);
+}
+
+
+void CAwarenessCandidates::FilterDot(const Vec3& point, const Vec3& dir, float minDot, float maxDot, TCandidateMask& mask, std::vector<float>& scores) const
+{
+	FilterDotScalar(point, dir, minDot, maxDot, mask, scores);
+}
+#endif
+
+
+void CAwarenessCandidates::RunBenchmark(int iterations)
+{
+	iterations = max(iterations, 1);
+
+	const size_t candidateCounts [] = { 10, 100, 1000 };
+	const Vec3 eyePosition(0.0f, 0.0f, 1.7f);
+	const Vec3 eyeDirection = Vec3(1.0f, 0.2f, -0.1f).normalized();
+	const Lineseg lineseg(eyePosition, eyePosition + eyeDirection * 6.0f);
+
+	CryLogAlways("Awareness filter benchmark, %d iterations. Times are in microseconds per call.", iterations);
+	CryLogAlways("%10s  %10s %10s  %10s %10s  %10s %10s  %s", "candidates", "near", "(scalar)", "lineseg", "(scalar)", "dot", "(scalar)", "results");
+
+	for (const size_t candidateCount : candidateCounts)
+	{
+		// Scatter boxes of various sizes and orientations around the eye, roughly how a busy area looks.
+		std::vector<CAwarenessGrid::SProxy> proxies(candidateCount);
+		for (auto& proxy : proxies)
+		{
+			const Vec3 position(cry_random(-6.0f, 6.0f), cry_random(-6.0f, 6.0f), cry_random(0.0f, 2.0f));
+			const AABB localBounds(Vec3(-cry_random(0.1f, 1.0f)), Vec3(cry_random(0.1f, 1.0f)));
+			const Matrix33 rotation = Matrix33::CreateRotationZ(cry_random(0.0f, gf_PI2));
+
+			proxy.worldPos = position;
+			proxy.obb = OBB::CreateOBBfromAABB(rotation, localBounds);
+			proxy.hasLocalBounds = true;
+			proxy.worldBounds = AABB::CreateTransformedAABB(Matrix34(rotation, position), localBounds);
+		}
+
+		CAwarenessCandidates candidates;
+		candidates.Build(proxies);
+
+		TCandidateMask mask;
+		TCandidateMask scalarMask;
+		std::vector<float> scores;
+		bool isMatch = true;
+
+		auto timeFilter = [iterations](const std::function<void()>& filter)
+		{
+			const CTimeValue startTime = gEnv->pTimer->GetAsyncTime();
+			for (int i = 0; i < iterations; ++i)
+				filter();
+
+			return (gEnv->pTimer->GetAsyncTime() - startTime).GetMilliSeconds() * 1000.0f / static_cast<float>(iterations);
+		};
+
+		const float nearTime = timeFilter([&]() { candidates.FilterNear(eyePosition, 3.0f, mask); });
+		const float nearScalar = timeFilter([&]() { candidates.FilterNearScalar(eyePosition, 3.0f, scalarMask); });
+		isMatch &= (mask == scalarMask);
+
+		const float linesegTime = timeFilter([&]() { candidates.FilterLineseg(lineseg, mask); });
+		const float linesegScalar = timeFilter([&]() { candidates.FilterLinesegScalar(lineseg, scalarMask); });
+		isMatch &= (mask == scalarMask);
+
+		const float dotTime = timeFilter([&]() { candidates.FilterDot(eyePosition, eyeDirection, 0.9f, 1.0f, mask, scores); });
+		const float dotScalar = timeFilter([&]() { candidates.FilterDotScalar(eyePosition, eyeDirection, 0.9f, 1.0f, scalarMask, scores); });
+		isMatch &= (mask == scalarMask);
+
+		CryLogAlways("%10" PRISIZE_T "  %10.3f %10.3f  %10.3f %10.3f  %10.3f %10.3f  %s", candidateCount, nearTime, nearScalar,
+			linesegTime, linesegScalar, dotTime, dotScalar, isMatch ? "match" : "MISMATCH");
+	}
+}
+
+
+void CAwarenessCandidates::GetMemoryUsage(ICrySizer* s) const
+{
+	s->AddContainer(m_data);
+	s->AddContainer(m_hasObb);
+}
+
+
+void CAwarenessCandidates::ResetMask(TCandidateMask& mask) const
+{
+	mask.assign((m_stride + 31) >> 5, 0);
+}
+
+
+void CAwarenessCandidates::ClearPadding(TCandidateMask& mask) const
+{
+	if (m_count & 31)
+		mask [m_count >> 5] &= (1u << (m_count & 31)) - 1;
+}
+}
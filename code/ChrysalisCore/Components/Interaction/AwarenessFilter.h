@@ -0,0 +1,140 @@
+/**
+\file	Components\Interaction\AwarenessFilter.h
+
+Batch filters for the awareness queries. The candidates from a proximity query are copied into a structure-of-arrays
+snapshot, and each filter tests four candidates at a time using SSE. The result of a filter is a bit mask with one bit
+per candidate, in the same order as the proxies the snapshot was built from.
+
+Platforms without SSE fall back to the scalar versions, which are also kept as the reference for the benchmark.
+**/
+#pragma once
+
+#include "AwarenessGrid.h"
+
+
+namespace Chrysalis
+{
+/** One bit per candidate, 32 candidates to a word. */
+typedef std::vector<uint32> TCandidateMask;
+
+
+/** Query if the candidate at index passed the filter which produced the mask. */
+inline bool IsCandidateSet(const TCandidateMask& mask, size_t index) { return ((mask [index >> 5] >> (index & 31)) & 1) != 0; }
+
+
+class CAwarenessCandidates
+{
+public:
+	/**
+	Takes a snapshot of the candidates.
+
+	\param	proxies	The proxies returned by an awareness grid query.
+	**/
+	void Build(const std::vector<CAwarenessGrid::SProxy>& proxies);
+
+
+	/** Gets the number of candidates in the snapshot. */
+	size_t Size() const { return m_count; }
+
+
+	/**
+	Finds the candidates whose bounds are within a radius of a point, ignoring height.
+
+	\param	point 	The point.
+	\param	radius	The radius.
+	\param	mask  	The mask of candidates which passed.
+	**/
+	void FilterNear(const Vec3& point, float radius, TCandidateMask& mask) const;
+
+
+	/**
+	Finds the candidates whose oriented bounds are intersected by a line segment. Candidates without local bounds never
+	pass.
+
+	\param	lineseg	The line segment.
+	\param	mask   	The mask of candidates which passed.
+	**/
+	void FilterLineseg(const Lineseg& lineseg, TCandidateMask& mask) const;
+
+
+	/**
+	Finds the candidates whose bounds centres lie within a range of angles from a direction, as the dot product of the
+	direction with the normalised vector to the centre. Each candidate is given a score, lower being a better match.
+
+	\param	point 	The point to measure from.
+	\param	dir   	The direction, which should be normalised.
+	\param	minDot	The minimum dot product.
+	\param	maxDot	The maximum dot product.
+	\param	mask  	The mask of candidates which passed.
+	\param	scores	The scores. Only meaningful for candidates which passed.
+	**/
+	void FilterDot(const Vec3& point, const Vec3& dir, float minDot, float maxDot, TCandidateMask& mask, std::vector<float>& scores) const;
+
+
+	// Scalar versions of the filters, testing one candidate at a time.
+	void FilterNearScalar(const Vec3& point, float radius, TCandidateMask& mask) const;
+	void FilterLinesegScalar(const Lineseg& lineseg, TCandidateMask& mask) const;
+	void FilterDotScalar(const Vec3& point, const Vec3& dir, float minDot, float maxDot, TCandidateMask& mask, std::vector<float>& scores) const;
+
+
+	/**
+	Times the batch filters against the scalar ones over randomly placed candidates, and checks they agree. The results
+	are written to the log.
+
+	\param	iterations	The number of times to run each filter.
+	**/
+	static void RunBenchmark(int iterations);
+
+
+	void GetMemoryUsage(ICrySizer* s) const;
+
+private:
+	// Each stream is a run of m_stride floats in m_data.
+	enum EStream
+	{
+		eS_MinX,
+		eS_MinY,
+		eS_MaxX,
+		eS_MaxY,
+		eS_CentreX,
+		eS_CentreY,
+		eS_CentreZ,
+		eS_ObbCentreX,
+		eS_ObbCentreY,
+		eS_ObbCentreZ,
+		eS_Axis00,
+		eS_Axis01,
+		eS_Axis02,
+		eS_Axis10,
+		eS_Axis11,
+		eS_Axis12,
+		eS_Axis20,
+		eS_Axis21,
+		eS_Axis22,
+		eS_HalfX,
+		eS_HalfY,
+		eS_HalfZ,
+
+		eS_COUNT
+	};
+
+	const float* GetStream(EStream stream) const { return m_data.data() + stream * m_stride; }
+	float* GetStream(EStream stream) { return m_data.data() + stream * m_stride; }
+
+	/** Sizes the mask for the current snapshot and clears it. */
+	void ResetMask(TCandidateMask& mask) const;
+
+	/** Clears any bits set by the padding at the end of the final batch. */
+	void ClearPadding(TCandidateMask& mask) const;
+
+	size_t m_count { 0 };
+
+	// The count rounded up to the batch size.
+	size_t m_stride { 0 };
+
+	std::vector<float> m_data;
+
+	// Candidates which have oriented bounds.
+	TCandidateMask m_hasObb;
+};
+}
@@ -0,0 +1,315 @@
+#include <StdAfx.h>
+
+#include "AwarenessGrid.h"
+
+
+namespace Chrysalis
+{
+/** The size of each grid cell in metres. This should be about the size of a typical awareness query. */
+static const float cellSize = 4.0f;
+
+/** Entities which would cover more than this many cells are kept out of the grid and tested by every query instead. */
+static const int maxCellsPerEntity = 16;
+
+
+CAwarenessGrid::CAwarenessGrid()
+	: m_inverseCellSize(1.0f / cellSize)
+{}
+
+
+void CAwarenessGrid::UpdateEntity(IEntity& entity, uint32 verbMask, bool isInteractive)
+{
+	const EntityId entityId = entity.GetId();
+
+	if (entity.IsHidden())
+	{
+		RemoveEntity(entityId);
+		return;
+	}
+
+	// Refresh the cached spatial data.
+	SProxy proxy;
+	proxy.entityId = entityId;
+	proxy.verbMask = verbMask;
+	proxy.isInteractive = isInteractive;
+	proxy.worldPos = entity.GetWorldPos();
+	entity.GetWorldBounds(proxy.worldBounds);
+
+	AABB localBounds;
+	entity.GetLocalBounds(localBounds);
+	if (!localBounds.IsEmpty())
+	{
+		proxy.obb = OBB::CreateOBBfromAABB(Matrix33(entity.GetWorldTM()), localBounds);
+		proxy.hasLocalBounds = true;
+	}
+
+	// Entities without any bounds can't be found by a query, so there's no need to keep them.
+	if (proxy.worldBounds.IsReset())
+	{
+		RemoveEntity(entityId);
+		return;
+	}
+
+	auto it = m_entryLookup.find(entityId);
+	if (it == m_entryLookup.end())
+	{
+		const uint32 index = static_cast<uint32>(m_entries.size());
+		m_entries.emplace_back();
+		m_entries [index].proxy = proxy;
+		m_entryLookup [entityId] = index;
+
+		LinkEntry(index);
+	}
+	else
+	{
+		// Small movements often leave the entity in the same cells, in which case only the proxy needs to change.
+		const uint32 index = it->second;
+		SEntry& entry = m_entries [index];
+		const SCellRange cells = GetCellRange(proxy.worldBounds);
+
+		if (!entry.isOversized && (entry.cells == cells))
+		{
+			entry.proxy = proxy;
+		}
+		else
+		{
+			UnlinkEntry(index);
+			entry.proxy = proxy;
+			LinkEntry(index);
+		}
+	}
+}
+
+
+void CAwarenessGrid::RemoveEntity(EntityId entityId)
+{
+	auto it = m_entryLookup.find(entityId);
+	if (it == m_entryLookup.end())
+		return;
+
+	const uint32 index = it->second;
+	const uint32 lastIndex = static_cast<uint32>(m_entries.size() - 1);
+
+	UnlinkEntry(index);
+	m_entryLookup.erase(it);
+
+	// Keep the storage dense by moving the last entry into the hole.
+	if (index != lastIndex)
+	{
+		RelinkEntry(lastIndex, index);
+		m_entries [index] = m_entries [lastIndex];
+		m_entryLookup [m_entries [index].proxy.entityId] = index;
+	}
+
+	m_entries.pop_back();
+}
+
+
+void CAwarenessGrid::Clear()
+{
+	m_entries.clear();
+	m_entryLookup.clear();
+	m_cells.clear();
+	m_oversized.clear();
+}
+
+
+template <typename TVisitor>
+void CAwarenessGrid::VisitEntries(const AABB& box, TVisitor&& visitor) const
+{
+	// Start a new query. On the rare occasion the stamp wraps around we need to clear the old stamps.
+	if (++m_queryStamp == 0)
+	{
+		for (auto& entry : m_entries)
+			entry.queryStamp = 0;
+
+		m_queryStamp = 1;
+	}
+
+	auto visit = [this, &visitor](uint32 index)
+	{
+		const SEntry& entry = m_entries [index];
+
+		if (entry.queryStamp != m_queryStamp)
+		{
+			entry.queryStamp = m_queryStamp;
+			visitor(entry.proxy);
+		}
+	};
+
+	const SCellRange cells = GetCellRange(box);
+	for (int x = cells.minX; x <= cells.maxX; ++x)
+	{
+		for (int y = cells.minY; y <= cells.maxY; ++y)
+		{
+			auto it = m_cells.find(GetCellKey(x, y));
+			if (it != m_cells.end())
+			{
+				for (const uint32 index : it->second)
+					visit(index);
+			}
+		}
+	}
+
+	for (const uint32 index : m_oversized)
+		visit(index);
+}
+
+
+size_t CAwarenessGrid::Query(const AABB& box, EntityId excludeId, std::vector<SProxy>& results) const
+{
+	const size_t firstResult = results.size();
+
+	VisitEntries(box, [&box, excludeId, &results](const SProxy& proxy)
+	{
+		if ((proxy.entityId != excludeId) && proxy.worldBounds.IsIntersectBox(box))
+			results.push_back(proxy);
+	});
+
+	return results.size() - firstResult;
+}
+
+
+EntityId CAwarenessGrid::QueryBestWithVerbs(const Vec3& point, const Vec3& dir, float radius, float halfHeight, float minDot, uint32 verbMask, EntityId excludeId) const
+{
+	const Vec3 offset(radius, radius, halfHeight);
+	const AABB box(point - offset, point + offset);
+	const float radiusSqr = radius * radius;
+
+	EntityId bestId = INVALID_ENTITYID;
+	float bestScore = FLT_MAX;
+
+	VisitEntries(box, [&](const SProxy& proxy)
+	{
+		// The verbs are the cheapest test and rule out the most entities, so they go first.
+		if ((verbMask ? ((proxy.verbMask & verbMask) != verbMask) : !proxy.isInteractive) || (proxy.entityId == excludeId))
+			return;
+
+		// Flatten the bounds to the height of the point, turning the test into a circle rather than a sphere.
+		const AABB flatBounds(Vec3(proxy.worldBounds.min.x, proxy.worldBounds.min.y, point.z),
+			Vec3(proxy.worldBounds.max.x, proxy.worldBounds.max.y, point.z));
+		if (flatBounds.GetDistanceSqr(point) > radiusSqr)
+			return;
+
+		const Vec3 toCentre = proxy.worldBounds.GetCenter() - point;
+		const float distance = toCentre.len();
+		const float dot = distance > 0.0f ? toCentre.dot(dir) / distance : 1.0f;
+		if (dot < minDot)
+			return;
+
+		const float score = (1.0f - dot) * distance;
+		if (score < bestScore)
+		{
+			bestScore = score;
+			bestId = proxy.entityId;
+		}
+	});
+
+	return bestId;
+}
+
+
+void CAwarenessGrid::GetMemoryUsage(ICrySizer* s) const
+{
+	s->AddContainer(m_entries);
+	s->AddContainer(m_oversized);
+	s->AddObject(&m_entryLookup, m_entryLookup.size() * (sizeof(EntityId) + sizeof(uint32) + sizeof(void*)));
+
+	for (const auto& cell : m_cells)
+		s->AddContainer(cell.second);
+}
+
+
+CAwarenessGrid::SCellRange CAwarenessGrid::GetCellRange(const AABB& bounds) const
+{
+	SCellRange cells;
+	cells.minX = static_cast<int>(floor(bounds.min.x * m_inverseCellSize));
+	cells.minY = static_cast<int>(floor(bounds.min.y * m_inverseCellSize));
+	cells.maxX = static_cast<int>(floor(bounds.max.x * m_inverseCellSize));
+	cells.maxY = static_cast<int>(floor(bounds.max.y * m_inverseCellSize));
+
+	return cells;
+}
+
+
+void CAwarenessGrid::LinkEntry(uint32 index)
+{
+	SEntry& entry = m_entries [index];
+	const SCellRange cells = GetCellRange(entry.proxy.worldBounds);
+
+	if ((cells.maxX - cells.minX + 1) * (cells.maxY - cells.minY + 1) > maxCellsPerEntity)
+	{
+		entry.isOversized = true;
+		entry.cells = SCellRange();
+		m_oversized.push_back(index);
+
+		return;
+	}
+
+	entry.isOversized = false;
+	entry.cells = cells;
+
+	for (int x = cells.minX; x <= cells.maxX; ++x)
+	{
+		for (int y = cells.minY; y <= cells.maxY; ++y)
+			m_cells [GetCellKey(x, y)].push_back(index);
+	}
+}
+
+
+void CAwarenessGrid::UnlinkEntry(uint32 index)
+{
+	const SEntry& entry = m_entries [index];
+
+	if (entry.isOversized)
+	{
+		m_oversized.erase(std::find(m_oversized.begin(), m_oversized.end(), index));
+		return;
+	}
+
+	for (int x = entry.cells.minX; x <= entry.cells.maxX; ++x)
+	{
+		for (int y = entry.cells.minY; y <= entry.cells.maxY; ++y)
+		{
+			auto it = m_cells.find(GetCellKey(x, y));
+			if (it == m_cells.end())
+				continue;
+
+			// Order within a cell doesn't matter.
+			TCell& cell = it->second;
+			auto found = std::find(cell.begin(), cell.end(), index);
+			if (found != cell.end())
+			{
+				*found = cell.back();
+				cell.pop_back();
+			}
+
+			// Empty cells are dropped so the grid doesn't grow without bound as entities wander the level.
+			if (cell.empty())
+				m_cells.erase(it);
+		}
+	}
+}
+
+
+void CAwarenessGrid::RelinkEntry(uint32 fromIndex, uint32 toIndex)
+{
+	const SEntry& entry = m_entries [fromIndex];
+
+	if (entry.isOversized)
+	{
+		std::replace(m_oversized.begin(), m_oversized.end(), fromIndex, toIndex);
+		return;
+	}
+
+	for (int x = entry.cells.minX; x <= entry.cells.maxX; ++x)
+	{
+		for (int y = entry.cells.minY; y <= entry.cells.maxY; ++y)
+		{
+			auto it = m_cells.find(GetCellKey(x, y));
+			if (it != m_cells.end())
+				std::replace(it->second.begin(), it->second.end(), fromIndex, toIndex);
+		}
+	}
+}
+}
@@ -0,0 +1,168 @@
+/**
+\file	Components\Interaction\AwarenessGrid.h
+
+A uniform spatial hash of the interactable entities in the level, shared by every awareness component. Each entity's
+bounds are cached when it is added and only refreshed when it reports a change to its transform, so awareness queries
+can be answered without a round trip to the entity system for each candidate.
+
+The grid is two dimensional, in the XY plane. Cells are keyed by their integer coordinates and only exist while they
+hold at least one entity, so the grid has no fixed extents. Entities which span too many cells are kept in a separate
+list which is tested by every query.
+
+Each entity also carries a mask of the verbs its interactions currently offer, kept up to date by its interaction
+component, so "what can I do nearby" questions can be answered from the grid alone.
+**/
+#pragma once
+
+#include <unordered_map>
+
+
+namespace Chrysalis
+{
+class CAwarenessGrid
+{
+public:
+	/** The cached spatial data for an entity. */
+	struct SProxy
+	{
+		EntityId entityId { INVALID_ENTITYID };
+
+		/** The world space axis aligned bounds. */
+		AABB worldBounds { AABB::RESET };
+
+		/** The world position of the entity. The OBB is relative to this. */
+		Vec3 worldPos { ZERO };
+
+		/** The local bounds of the entity, oriented by its world transform. Only valid if hasLocalBounds is true. */
+		OBB obb;
+
+		bool hasLocalBounds { false };
+
+		/** A bit for each verb the entity's enabled interactions offer. See CEntityInteractionComponent::GetVerbBit. */
+		uint32 verbMask { 0 };
+
+		/** True if any of the entity's interactions are enabled, including those whose verbs have no bit. */
+		bool isInteractive { false };
+	};
+
+
+	/** Default constructor. */
+	CAwarenessGrid();
+
+
+	/**
+	Adds the entity to the grid, or refreshes its cached bounds and verbs if it's already present. Hidden entities are
+	removed instead.
+
+	\param	entity		 	The entity.
+	\param	verbMask	 	The verbs the entity offers.
+	\param	isInteractive	True if any of the entity's interactions are enabled.
+	**/
+	void UpdateEntity(IEntity& entity, uint32 verbMask, bool isInteractive);
+
+
+	/**
+	Removes the entity from the grid, if present.
+
+	\param	entityId	Identifier for the entity.
+	**/
+	void RemoveEntity(EntityId entityId);
+
+
+	/** Removes all entities. */
+	void Clear();
+
+
+	/**
+	Finds every entity whose bounds overlap a box. Results are appended to the vector, each entity appearing at most
+	once.
+
+	\param	box		  	The box to search.
+	\param	excludeId 	An entity to leave out of the results, typically the one asking.
+	\param	results   	The results.
+
+	\return	The number of results added.
+	**/
+	size_t Query(const AABB& box, EntityId excludeId, std::vector<SProxy>& results) const;
+
+
+	/**
+	Finds the best entity offering all of a set of verbs which is within a radius of a point, ignoring height, and
+	within a range of angles from a direction. Uses the same tests and scoring as the awareness near and dot filters,
+	so the best match is the one nearest to the direction and the point.
+
+	\param	point	 	The point to search from.
+	\param	dir		 	The direction, which should be normalised.
+	\param	radius   	The radius.
+	\param	halfHeight	How far above or below the point an entity's bounds may be.
+	\param	minDot   	The minimum dot product of the direction with the normalised vector to an entity's centre.
+	\param	verbMask 	The verbs an entity must offer. Zero matches any entity with an enabled interaction.
+	\param	excludeId	An entity to leave out of the results, typically the one asking.
+
+	\return	The entity, or INVALID_ENTITYID if none match.
+	**/
+	EntityId QueryBestWithVerbs(const Vec3& point, const Vec3& dir, float radius, float halfHeight, float minDot, uint32 verbMask, EntityId excludeId) const;
+
+
+	/** Gets the number of entities in the grid. */
+	size_t GetEntityCount() const { return m_entries.size(); }
+
+
+	void GetMemoryUsage(ICrySizer* s) const;
+
+private:
+	struct SCellRange
+	{
+		bool operator==(const SCellRange& rhs) const { return (minX == rhs.minX) && (minY == rhs.minY) && (maxX == rhs.maxX) && (maxY == rhs.maxY); }
+
+		int minX { 0 };
+		int minY { 0 };
+		int maxX { -1 };
+		int maxY { -1 };
+	};
+
+	struct SEntry
+	{
+		SProxy proxy;
+
+		/** The cells this entry has been added to. Empty for oversized entries. */
+		SCellRange cells;
+
+		bool isOversized { false };
+
+		/** Stamped by each query which visits this entry, so entries in more than one cell are only returned once. */
+		mutable uint32 queryStamp { 0 };
+	};
+
+	typedef std::vector<uint32> TCell;
+
+
+	SCellRange GetCellRange(const AABB& bounds) const;
+
+	/** Calls the visitor once for each entry in the cells overlapping a box, and each oversized entry. */
+	template <typename TVisitor>
+	void VisitEntries(const AABB& box, TVisitor&& visitor) const;
+
+	static uint64 GetCellKey(int x, int y) { return (static_cast<uint64>(static_cast<uint32>(x)) << 32) | static_cast<uint32>(y); }
+
+	void LinkEntry(uint32 index);
+	void UnlinkEntry(uint32 index);
+	void RelinkEntry(uint32 fromIndex, uint32 toIndex);
+
+	// Dense storage, entries are swapped with the last one on removal.
+	std::vector<SEntry> m_entries;
+
+	// Finds the entry for an entity.
+	std::unordered_map<EntityId, uint32> m_entryLookup;
+
+	// Each cell holds the indices of the entries which overlap it.
+	std::unordered_map<uint64, TCell> m_cells;
+
+	// Indices of the entries which are too large to be worth adding to the cells.
+	std::vector<uint32> m_oversized;
+
+	float m_inverseCellSize;
+
+	mutable uint32 m_queryStamp { 0 };
+};
+}
@@ -0,0 +1,221 @@
+#include <StdAfx.h>
+
+#include "AwarenessRayBatch.h"
+#include "EntityAwarenessComponent.h"
+#include <Console/CVars.h>
+#include <Utility/CryWatch.h>
+
+
+namespace Chrysalis
+{
+CAwarenessRayBatch::CAwarenessRayBatch()
+{
+	m_rayCaster.SetQuota(64);
+}
+
+
+CAwarenessRayBatch::~CAwarenessRayBatch()
+{
+	Reset();
+}
+
+
+CAwarenessRayBatch::TRequestId CAwarenessRayBatch::Request(CEntityAwarenessComponent* pOwner, const Vec3& origin, const Vec3& direction,
+	IPhysicalEntity* pSkipEntity, bool isHighPriority)
+{
+	uint16 slot;
+
+	if (!m_freeSlots.empty())
+	{
+		slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else
+	{
+		if (m_requests.size() > 0xffff)
+		{
+			CRY_ASSERT_MESSAGE(false, "Too many awareness ray requests in flight.");
+			AddDropped();
+			return InvalidRequestId;
+		}
+
+		slot = static_cast<uint16>(m_requests.size());
+		m_requests.emplace_back();
+	}
+
+	SRequest& request = m_requests [slot];
+	request.pOwner = pOwner;
+	request.origin = origin;
+	request.direction = direction;
+	request.pSkipEntity = pSkipEntity;
+	request.queuedRayId = 0;
+	request.frameRequested = m_frame;
+	request.isInUse = true;
+	request.isHighPriority = isHighPriority;
+
+	const TRequestId requestId = MakeRequestId(slot, request.generation);
+	m_pending.push_back(requestId);
+
+	return requestId;
+}
+
+
+void CAwarenessRayBatch::Cancel(TRequestId requestId)
+{
+	if (SRequest* pRequest = GetRequest(requestId))
+	{
+		if (pRequest->queuedRayId)
+		{
+			m_rayCaster.Cancel(pRequest->queuedRayId);
+			m_queuedLookup.erase(pRequest->queuedRayId);
+		}
+
+		++m_statistics.dropped;
+		FreeSlot(GetSlot(requestId));
+	}
+}
+
+
+void CAwarenessRayBatch::CancelAll(CEntityAwarenessComponent* pOwner)
+{
+	// Only called when a component shuts down, so a scan is fine here.
+	for (size_t index = 0; index < m_requests.size(); ++index)
+	{
+		const SRequest& request = m_requests [index];
+		if (request.isInUse && request.pOwner == pOwner)
+			Cancel(MakeRequestId(static_cast<uint16>(index), request.generation));
+	}
+}
+
+
+void CAwarenessRayBatch::Update(float frameTime)
+{
+	const uint32 issuedBefore = m_statistics.issued;
+
+	for (const TRequestId requestId : m_pending)
+	{
+		// Anything cancelled since it was requested no longer matches its slot's generation.
+		SRequest* pRequest = GetRequest(requestId);
+		if (!pRequest)
+			continue;
+
+		const RayCastRequest::Priority priority = pRequest->isHighPriority ? RayCastRequest::HighPriority : RayCastRequest::MediumPriority;
+		const uint8 skipCount = pRequest->pSkipEntity ? 1 : 0;
+
+		// We ask for two hits, so the component can see through glass and other pierceable surfaces.
+		pRequest->queuedRayId = m_rayCaster.Queue(priority,
+			RayCastRequest(pRequest->origin, pRequest->direction, ent_all,
+				rwi_pierceability(PIERCE_GLASS) | rwi_colltype_any,
+				&pRequest->pSkipEntity, skipCount, 2),
+			functor(*this, &CAwarenessRayBatch::OnRayCastResult));
+
+		m_queuedLookup [pRequest->queuedRayId] = GetSlot(requestId);
+		++m_statistics.issued;
+	}
+
+	m_pending.clear();
+	m_rayCaster.Update(frameTime);
+
+	if (g_cvars.m_componentAwarenessStats)
+		DrawStatistics(m_statistics.issued - issuedBefore);
+
+	++m_frame;
+}
+
+
+void CAwarenessRayBatch::Reset()
+{
+	for (const auto& queued : m_queuedLookup)
+		m_rayCaster.Cancel(queued.first);
+
+	m_rayCaster.Reset();
+	m_queuedLookup.clear();
+	m_pending.clear();
+	m_freeSlots.clear();
+
+	// The generations are kept, so any IDs still held by components stay invalid. The owners are told their requests
+	// were dropped, so they can stop waiting on them.
+	for (size_t index = 0; index < m_requests.size(); ++index)
+	{
+		const uint16 slot = static_cast<uint16>(index);
+
+		if (m_requests [slot].isInUse)
+		{
+			CEntityAwarenessComponent* pOwner = m_requests [slot].pOwner;
+			const TRequestId requestId = MakeRequestId(slot, m_requests [slot].generation);
+
+			FreeSlot(slot);
+
+			if (pOwner)
+				pOwner->OnRayCastDropped(requestId);
+		}
+		else
+			m_freeSlots.push_back(slot);
+	}
+
+	ResetStatistics();
+}
+
+
+CAwarenessRayBatch::SRequest* CAwarenessRayBatch::GetRequest(TRequestId requestId)
+{
+	const uint16 slot = GetSlot(requestId);
+
+	if ((requestId == InvalidRequestId) || (slot >= m_requests.size()))
+		return nullptr;
+
+	SRequest& request = m_requests [slot];
+
+	return (request.isInUse && request.generation == GetGeneration(requestId)) ? &request : nullptr;
+}
+
+
+void CAwarenessRayBatch::FreeSlot(uint16 slot)
+{
+	SRequest& request = m_requests [slot];
+	request.pOwner = nullptr;
+	request.pSkipEntity = nullptr;
+	request.queuedRayId = 0;
+	request.isInUse = false;
+
+	// Zero is reserved, so an ID can never be mistaken for InvalidRequestId.
+	if (++request.generation == 0)
+		request.generation = 1;
+
+	m_freeSlots.push_back(slot);
+}
+
+
+void CAwarenessRayBatch::DrawStatistics(uint32 issuedThisFrame) const
+{
+	const float averageLatency = m_statistics.completed > 0
+		? static_cast<float>(m_statistics.latencyFrames) / static_cast<float>(m_statistics.completed) : 0.0f;
+
+	CryWatch("Awareness rays: %u issued this frame, %" PRISIZE_T " in flight", issuedThisFrame, GetInFlightCount());
+	CryWatch("Awareness rays: %u issued, %u dropped, %.2f frames average latency", m_statistics.issued, m_statistics.dropped, averageLatency);
+}
+
+
+void CAwarenessRayBatch::OnRayCastResult(const QueuedRayID& rayId, const RayCastResult& result)
+{
+	auto it = m_queuedLookup.find(rayId);
+	if (it == m_queuedLookup.end())
+		return;
+
+	const uint16 slot = it->second;
+	m_queuedLookup.erase(it);
+
+	SRequest& request = m_requests [slot];
+	CEntityAwarenessComponent* pOwner = request.pOwner;
+	const TRequestId requestId = MakeRequestId(slot, request.generation);
+
+	++m_statistics.completed;
+	m_statistics.latencyFrames += m_frame - request.frameRequested;
+
+	// Free the slot first, so the owner is able to request another ray straight away.
+	FreeSlot(slot);
+
+	if (pOwner)
+		pOwner->OnRayCastDataReceived(requestId, result);
+}
+}
@@ -0,0 +1,165 @@
+/**
+\file	Components\Interaction\AwarenessRayBatch.h
+
+Collects the forward rays requested by awareness components during a frame and submits them together to a deferred
+ray-cast queue. Each request gets an ID made from a slot index and a generation count, so a result can be routed
+straight back to the component that asked for it, and a result for a request which has since been cancelled (or whose
+slot has been reused) is simply dropped.
+
+We own the RayCastQueue rather than borrowing the one in CryAction's physic queues, since CCryAction can't be linked to
+from a plugin. It's the same queue type, with its own ID.
+**/
+#pragma once
+
+#include <CryPhysics/RayCastQueue.h>
+#include <unordered_map>
+
+
+/** Pierceability for the awareness rays, so they pass through glass. */
+#define PIERCE_GLASS (13)
+
+
+namespace Chrysalis
+{
+class CEntityAwarenessComponent;
+
+
+class CAwarenessRayBatch
+{
+public:
+	/** Identifies a request. The low 16 bits are the slot, the high 16 bits are the generation of that slot. */
+	typedef uint32 TRequestId;
+
+	static const TRequestId InvalidRequestId { 0 };
+
+
+	struct SStatistics
+	{
+		/** Number of rays submitted to the ray-cast queue. */
+		uint32 issued { 0 };
+
+		/** Number of rays which were never cast, or whose results were thrown away. */
+		uint32 dropped { 0 };
+
+		/** Number of results routed back to a component. */
+		uint32 completed { 0 };
+
+		/** The total frames between request and result, for all the completed rays. */
+		uint32 latencyFrames { 0 };
+	};
+
+
+	CAwarenessRayBatch();
+	~CAwarenessRayBatch();
+
+
+	/**
+	Requests a ray-cast. It will be submitted with the rest of the batch at the end of the frame, and the result is
+	passed to the owner's OnRayCastDataReceived.
+
+	\param [in]	pOwner		 	The component which wants the result.
+	\param	origin			 	The origin of the ray.
+	\param	direction		 	The direction of the ray, scaled to its length.
+	\param [in]	pSkipEntity	 	If non-null, a physical entity to ignore, typically the owner's.
+	\param	isHighPriority	 	True if the ray should be cast ahead of the others, e.g. for the local player.
+
+	\return	An identifier for the request.
+	**/
+	TRequestId Request(CEntityAwarenessComponent* pOwner, const Vec3& origin, const Vec3& direction, IPhysicalEntity* pSkipEntity, bool isHighPriority);
+
+
+	/**
+	Cancels a request. The owner won't receive a result for it.
+
+	\param	requestId	Identifier for the request.
+	**/
+	void Cancel(TRequestId requestId);
+
+
+	/**
+	Cancels every request for a component. This must be called before the component is destroyed.
+
+	\param [in]	pOwner	The component.
+	**/
+	void CancelAll(CEntityAwarenessComponent* pOwner);
+
+
+	/** Records a ray which the owner chose not to request, e.g. because it already had too many in flight. */
+	void AddDropped() { ++m_statistics.dropped; }
+
+
+	/**
+	Called once per frame, after the awareness components have been updated. Submits this frame's batch.
+
+	\param	frameTime	The frame time.
+	**/
+	void Update(float frameTime);
+
+
+	/** Cancels every request and resets the ray-cast queue and statistics. The owners are told their requests were dropped. */
+	void Reset();
+
+
+	const SStatistics& GetStatistics() const { return m_statistics; }
+
+	void ResetStatistics() { m_statistics = SStatistics(); }
+
+
+	/** Gets the number of rays which have been submitted but haven't returned yet. */
+	size_t GetInFlightCount() const { return m_queuedLookup.size(); }
+
+private:
+	struct SRequest
+	{
+		CEntityAwarenessComponent* pOwner { nullptr };
+		Vec3 origin { ZERO };
+		Vec3 direction { ZERO };
+		IPhysicalEntity* pSkipEntity { nullptr };
+
+		/** The ID given to us by the ray-cast queue, once submitted. */
+		QueuedRayID queuedRayId { 0 };
+
+		/** The frame the request was made on, for the latency statistic. */
+		uint32 frameRequested { 0 };
+
+		/** Bumped each time the slot is freed, which invalidates any IDs issued for it. Never zero. */
+		uint16 generation { 1 };
+
+		bool isInUse { false };
+		bool isHighPriority { false };
+	};
+
+	// Our own ID for the ray-cast queue. CryAction's queue uses 41.
+	typedef RayCastQueue<43> TRayCaster;
+
+	static TRequestId MakeRequestId(uint16 slot, uint16 generation) { return (static_cast<uint32>(generation) << 16) | slot; }
+	static uint16 GetSlot(TRequestId requestId) { return static_cast<uint16>(requestId & 0xffff); }
+	static uint16 GetGeneration(TRequestId requestId) { return static_cast<uint16>(requestId >> 16); }
+
+	/** Gets the request for an ID, or null if the ID is no longer valid. */
+	SRequest* GetRequest(TRequestId requestId);
+
+	void FreeSlot(uint16 slot);
+
+	/** Writes the ray statistics to the screen. */
+	void DrawStatistics(uint32 issuedThisFrame) const;
+
+	/** Receives the results from the ray-cast queue. */
+	void OnRayCastResult(const QueuedRayID& rayId, const RayCastResult& result);
+
+	TRayCaster m_rayCaster;
+
+	std::vector<SRequest> m_requests;
+	std::vector<uint16> m_freeSlots;
+
+	// Requests made this frame, waiting to be submitted. Cancelled requests are skipped when the batch is submitted.
+	std::vector<TRequestId> m_pending;
+
+	// Finds the slot for a result from the ray-cast queue.
+	std::unordered_map<QueuedRayID, uint16> m_queuedLookup;
+
+	SStatistics m_statistics;
+
+	uint32 m_frame { 0 };
+};
+}
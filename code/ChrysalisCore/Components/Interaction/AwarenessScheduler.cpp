@@ -0,0 +1,110 @@
+#include <StdAfx.h>
+
+#include "AwarenessScheduler.h"
+#include "EntityAwarenessComponent.h"
+#include <Actor/ActorComponent.h>
+#include <Components/Player/PlayerComponent.h>
+#include <Console/CVars.h>
+#include <Utility/CryWatch.h>
+
+
+namespace Chrysalis
+{
+void CAwarenessScheduler::Register(CEntityAwarenessComponent* pComponent)
+{
+	// Start each component part way through its interval, so a batch of spawned actors don't all fall due together.
+	const uint32 phase = pComponent->GetEntityId() % max(g_cvars.m_componentAwarenessLodFarInterval, 1);
+
+	m_entries.push_back({ pComponent, m_frame - phase });
+}
+
+
+void CAwarenessScheduler::Unregister(CEntityAwarenessComponent* pComponent)
+{
+	auto it = std::find_if(m_entries.begin(), m_entries.end(), [pComponent](const SEntry& entry) { return entry.pComponent == pComponent; });
+	if (it != m_entries.end())
+	{
+		*it = m_entries.back();
+		m_entries.pop_back();
+	}
+}
+
+
+void CAwarenessScheduler::Update()
+{
+	++m_frame;
+
+	// Distances are measured from the local player, who is always updated.
+	IActorComponent* pLocalActor = CPlayerComponent::GetLocalActor();
+	const EntityId localActorId = pLocalActor ? pLocalActor->GetEntityId() : INVALID_ENTITYID;
+	const Vec3 viewPosition = pLocalActor ? pLocalActor->GetEntity()->GetWorldPos() : Vec3(ZERO);
+
+	const float nearDistanceSqr = sqr(g_cvars.m_componentAwarenessLodNearDistance);
+	const float farDistanceSqr = sqr(g_cvars.m_componentAwarenessLodFarDistance);
+	const uint32 intervals [eLod_COUNT] = { 1,
+		static_cast<uint32>(max(g_cvars.m_componentAwarenessLodMidInterval, 1)),
+		static_cast<uint32>(max(g_cvars.m_componentAwarenessLodFarInterval, 1)) };
+
+	uint32 updated [eLod_COUNT] = { 0, 0, 0 };
+	m_due.clear();
+
+	for (size_t i = 0; i < m_entries.size(); ++i)
+	{
+		SEntry& entry = m_entries [i];
+
+		if (entry.pComponent->GetEntityId() == localActorId)
+		{
+			entry.pComponent->Update();
+			entry.lastUpdateFrame = m_frame;
+			++updated [eLod_Near];
+			continue;
+		}
+
+		const float distanceSqr = pLocalActor ? entry.pComponent->GetEntity()->GetWorldPos().GetSquaredDistance(viewPosition) : 0.0f;
+		const ELod lod = distanceSqr <= nearDistanceSqr ? eLod_Near : (distanceSqr <= farDistanceSqr ? eLod_Mid : eLod_Far);
+
+		const uint32 elapsed = m_frame - entry.lastUpdateFrame;
+		if (elapsed >= intervals [lod])
+			m_due.push_back({ i, elapsed - intervals [lod], lod });
+	}
+
+	// When there's more due than we're allowed to update, the most overdue go first. Near components are always due, so
+	// ties go to them.
+	const size_t maxUpdates = g_cvars.m_componentAwarenessMaxUpdates > 0 ? static_cast<size_t>(g_cvars.m_componentAwarenessMaxUpdates) : m_due.size();
+	const size_t updateCount = min(maxUpdates, m_due.size());
+
+	if (updateCount < m_due.size())
+	{
+		std::partial_sort(m_due.begin(), m_due.begin() + updateCount, m_due.end(), [](const SDueEntry& a, const SDueEntry& b)
+		{
+			return (a.overdue != b.overdue) ? a.overdue > b.overdue : a.lod < b.lod;
+		});
+	}
+
+	for (size_t i = 0; i < updateCount; ++i)
+	{
+		SEntry& entry = m_entries [m_due [i].index];
+		entry.pComponent->Update();
+		entry.lastUpdateFrame = m_frame;
+		++updated [m_due [i].lod];
+	}
+
+	if (g_cvars.m_componentAwarenessStats)
+		DrawStatistics(updated, m_due.size() - updateCount);
+
+	CEntityAwarenessComponent::ResetQueryCount();
+}
+
+
+void CAwarenessScheduler::DrawStatistics(const uint32 updated [eLod_COUNT], size_t deferred)
+{
+	// Queries can also be run on demand outside the scheduled updates, e.g. by input handlers, so this is everything
+	// since the last scheduler update.
+	const uint32 queries = CEntityAwarenessComponent::GetQueryCount();
+	m_averageQueries = m_averageQueries * 0.95f + static_cast<float>(queries) * 0.05f;
+
+	CryWatch("Awareness: %" PRISIZE_T " components, updated %u near / %u mid / %u far, %" PRISIZE_T " deferred",
+		m_entries.size(), updated [eLod_Near], updated [eLod_Mid], updated [eLod_Far], deferred);
+	CryWatch("Awareness: %u queries this frame, %.1f average", queries, m_averageQueries);
+}
+}
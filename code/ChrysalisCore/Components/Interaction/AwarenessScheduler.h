@@ -0,0 +1,85 @@
+/**
+\file	Components\Interaction\AwarenessScheduler.h
+
+Decides which awareness components are updated each frame. The local player's component is updated every frame. The
+rest are given an update interval based on their distance from the local player, and the components which are due are
+updated most overdue first, up to a cap on the number of updates per frame. Anything left over is simply more overdue
+next frame, so the work spreads itself across frames.
+
+The distances, intervals and cap are all set by CVar (component_awareness_lod_*).
+**/
+#pragma once
+
+
+namespace Chrysalis
+{
+class CEntityAwarenessComponent;
+
+
+class CAwarenessScheduler
+{
+public:
+	/**
+	Adds a component to the schedule.
+
+	\param [in]	pComponent	The component.
+	**/
+	void Register(CEntityAwarenessComponent* pComponent);
+
+
+	/**
+	Removes a component from the schedule.
+
+	\param [in]	pComponent	The component.
+	**/
+	void Unregister(CEntityAwarenessComponent* pComponent);
+
+
+	/** Called once per frame. Updates the components which are due this frame. */
+	void Update();
+
+
+	/** Gets the number of registered components. */
+	size_t GetComponentCount() const { return m_entries.size(); }
+
+private:
+	enum ELod
+	{
+		eLod_Near,
+		eLod_Mid,
+		eLod_Far,
+		eLod_COUNT
+	};
+
+	struct SEntry
+	{
+		CEntityAwarenessComponent* pComponent;
+
+		/** The frame on which the component was last updated. */
+		uint32 lastUpdateFrame;
+	};
+
+	struct SDueEntry
+	{
+		size_t index;
+
+		/** How many frames past its interval the component is. */
+		uint32 overdue;
+
+		ELod lod;
+	};
+
+	/** Writes this frame's schedule and query counts to the screen. */
+	void DrawStatistics(const uint32 updated [eLod_COUNT], size_t deferred);
+
+	std::vector<SEntry> m_entries;
+
+	// Scratch space for the components which are due each frame.
+	std::vector<SDueEntry> m_due;
+
+	uint32 m_frame { 0 };
+
+	// A smoothed count of the awareness queries run per frame.
+	float m_averageQueries { 0.0f };
+};
+}
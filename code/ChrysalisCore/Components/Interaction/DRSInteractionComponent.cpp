@@ -34,7 +34,7 @@ void CDRSInteractionComponent::Initialize()
 	// Add new verbs to the interactor.
 	if (m_interactor = GetEntity()->GetOrCreateComponent<CEntityInteractionComponent>())
 	{
-		m_interactor->AddInteraction(std::make_shared<CInteractionDRS>(this));
+		m_interactor->AddInteraction<CInteractionDRS>(this);
 	}
 
 	// Reset the entity.
@@ -61,24 +61,25 @@ void CDRSInteractionComponent::ProcessEvent(const SEntityEvent& event)
 
 void CDRSInteractionComponent::OnResetState()
 {
+	// Default to self as the target entity, and make sure it has a DRS proxy.
+	m_pDrsProxy = crycomponent_cast<IEntityDynamicResponseComponent*> (GetEntity()->CreateProxy(ENTITY_PROXY_DYNAMICRESPONSE));
+
+	// The response is only changed in the editor, and that resets the state.
+	m_drsResponseHash = m_drsResponse.empty() ? CHashedString() : CHashedString(m_drsResponse.c_str());
 }
 
 
 void CDRSInteractionComponent::OnInteractionDRS()
 {
-	if (!m_drsResponse.empty())
+	if ((!m_drsResponse.empty()) && (m_pDrsProxy))
 	{
-		// Default to self as the target entity.
-		auto pTargetEntity = GetEntity();
-
-		// Make sure the target entity has a DRS proxy.
-		auto pDrsProxy = crycomponent_cast<IEntityDynamicResponseComponent*> (pTargetEntity->CreateProxy(ENTITY_PROXY_DYNAMICRESPONSE));
+		static const CHashedString verbName { "Verb" };
 
-		// Create a context variable collection and populate it based on information from the target entity.
-		DRS::IVariableCollectionSharedPtr pContextVariableCollection = gEnv->pDynamicResponseSystem->CreateContextCollection();
+		// Grab a context variable collection and populate it based on information from the target entity.
+		DRS::IVariableCollectionSharedPtr pContextVariableCollection = m_contextPool.Acquire();
 
 		// It might be useful to know which verb triggered the interaction.
-		pContextVariableCollection->CreateVariable("Verb", CHashedString(m_drsResponse.c_str()));
+		pContextVariableCollection->SetVariableValue(verbName, m_drsResponseHash);
 
 		// Add each key, value to the DRS variable collection.
 		//for (auto it : m_drsProperties)
@@ -87,7 +88,7 @@ void CDRSInteractionComponent::OnInteractionDRS()
 		//}
 
 		// Queue it and let the DRS handle it now.
-		pDrsProxy->GetResponseActor()->QueueSignal(m_drsResponse.c_str(), pContextVariableCollection);
+		m_pDrsProxy->GetResponseActor()->QueueSignal(m_drsResponseHash, pContextVariableCollection);
 	}
 }
 
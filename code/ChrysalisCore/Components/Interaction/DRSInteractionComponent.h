@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Entities/Interaction/IEntityInteraction.h"
+#include <Utility/DRS.h>
 
 
 namespace Chrysalis
@@ -71,6 +72,15 @@ private:
 
 	/** Properties. */
 	PropertyCollection m_drsProperties;	
+
+	/** The DRS response, hashed when the state is reset rather than on every interaction. */
+	CHashedString m_drsResponseHash;
+
+	/** Our own DRS proxy, which is the target for the signals. */
+	IEntityDynamicResponseComponent* m_pDrsProxy { nullptr };
+
+	/** Context collections for the signals, reused once the DRS is done with them. */
+	DRSUtility::CContextCollectionPool m_contextPool;
 };
 
 bool Serialize(Serialization::IArchive& archive, CDRSInteractionComponent::SDRSProperties& value, const char* szName, const char* szLabel);
@@ -10,6 +10,8 @@
 #include <Components/Player/Camera/ICameraComponent.h>
 #include <Components/Interaction/EntityInteractionComponent.h>
 #include <Console/CVars.h>
+#include <Plugin/ChrysalisCorePlugin.h>
+#include "AwarenessScheduler.h"
 
 
 namespace Chrysalis
@@ -20,10 +22,9 @@ static const float forwardCastDistance = 300.0f;
 /** Scales the proximity distance for what is considered 'close by' queries. */
 static const float proximityCloseByFactor = 0.5f;
 
-/** Allow previous ray-cast results to still be used for up to this long, in seconds. */
-static const float maxRaycastStaleness = 0.05f;
-
-#define PIERCE_GLASS (13)
+/** Allow previous ray-cast results to still be used for up to this long, in seconds. Results arrive at least a frame
+after they are requested, so this needs to cover a few slow frames. */
+static const float maxRaycastStaleness = 0.1f;
 
 
 void CEntityAwarenessComponent::Register(Schematyc::CEnvRegistrationScope& componentScope)
@@ -51,17 +52,23 @@ void CEntityAwarenessComponent::Initialize()
 {
 	m_pActor = GetEntity()->GetComponent<CActorComponent>();
 	CRY_ASSERT_MESSAGE(m_pActor, "EntityAwareness component requires an actor component.");
+
+	// Rather than every actor updating every frame, the scheduler spreads the updates out based on distance.
+	if (auto pAwarenessScheduler = CChrysalisCorePlugin::Get()->GetAwarenessScheduler())
+		pAwarenessScheduler->Register(this);
 }
 
 
-void CEntityAwarenessComponent::ProcessEvent(const SEntityEvent& event)
+void CEntityAwarenessComponent::OnShutDown()
 {
-	switch (event.event)
-	{
-		case EEntityEvent::Update:
-			Update();
-			break;
-	}
+	if (auto pAwarenessScheduler = CChrysalisCorePlugin::Get()->GetAwarenessScheduler())
+		pAwarenessScheduler->Unregister(this);
+
+	// Any results still to come would be routed to a component which no longer exists.
+	if (auto pAwarenessRayBatch = CChrysalisCorePlugin::Get()->GetAwarenessRayBatch())
+		pAwarenessRayBatch->CancelAll(this);
+
+	m_queuedRayCount = 0;
 }
 
 
@@ -110,8 +117,15 @@ void CEntityAwarenessComponent::Update()
 void CEntityAwarenessComponent::GetMemoryUsage(ICrySizer *pSizer) const
 {
 	pSizer->AddObject(this, sizeof(*this));
-	pSizer->AddObject(m_entitiesInProximity);
-	pSizer->AddObject(m_entitiesInFrontOf);
+	m_entitiesInProximity.GetMemoryUsage(pSizer);
+	m_entitiesNear.GetMemoryUsage(pSizer);
+	m_entitiesNearDotFiltered.GetMemoryUsage(pSizer);
+	m_entitiesInFrontOf.GetMemoryUsage(pSizer);
+	pSizer->AddContainer(m_proximityProxies);
+	pSizer->AddContainer(m_nearMask);
+	pSizer->AddContainer(m_filterMask);
+	pSizer->AddContainer(m_filterScores);
+	m_proximityCandidates.GetMemoryUsage(pSizer);
 }
 
 
@@ -129,66 +143,45 @@ CEntityAwarenessComponent::UpdateQueryFunction CEntityAwarenessComponent::m_upda
 };
 
 
-CEntityAwarenessComponent::CEntityAwarenessComponent()
-{
-	m_rayHitPierceable.dist = -1.0f;
-}
+uint32 CEntityAwarenessComponent::m_queryCount { 0 };
 
 
-CEntityAwarenessComponent::~CEntityAwarenessComponent()
+CEntityAwarenessComponent::CEntityAwarenessComponent()
 {
-	for (int i = 0; i < maxQueuedRays; ++i)
-	{
-		m_queuedRays [i].Reset();
-	}
+	m_rayHitPierceable.dist = -1.0f;
 }
 
 
 void CEntityAwarenessComponent::UpdateRaycastQuery()
 {
-	m_isRayHit = false;
-	m_rayHitPosition = Vec3(ZERO);
-		
 	if (!m_pActor || m_pActor->GetEntity()->IsHidden())
 		return;
 
 	if (m_eyeDirection.IsValid())
 	{
-		IEntity * pEntity = m_pActor->GetEntity();
-		IPhysicalEntity * pPhysEnt = pEntity ? pEntity->GetPhysics() : nullptr;
-		IPhysicalEntity *skipEntities [1];
-		skipEntities [0] = pPhysEnt;
-
-		int raySlot = RequestRaySlotId();
-		CRY_ASSERT(raySlot != -1);
-
-		ray_hit rayHit;
-
-		// Use a synchronous ray-cast.
-		auto hits = gEnv->pPhysicalWorld->RayWorldIntersection(
-			m_eyePosition, m_eyeDirection * FORWARD_DIRECTION * forwardCastDistance,
-			ent_all, rwi_pierceability(PIERCE_GLASS) | rwi_colltype_any,
-			&rayHit, 1,
-			skipEntities, pPhysEnt ? 1 : 0);
-		if (hits > 0)
+		auto pAwarenessRayBatch = CChrysalisCorePlugin::Get()->GetAwarenessRayBatch();
+
+		if (pAwarenessRayBatch)
 		{
-			OnRayCast(rayHit);
-		}
+			// If the results are falling behind there's no point asking for more, the old results will just get stale.
+			if (m_queuedRayCount < maxQueuedRays)
+			{
+				IEntity* pEntity = m_pActor->GetEntity();
+				IPhysicalEntity* pPhysEnt = pEntity ? pEntity->GetPhysics() : nullptr;
+				const bool isLocalActor = m_pActor == CPlayerComponent::GetLocalActor();
 
-		// HACK: Removed asynchronous raycasts because they were using CryAction and that had link problems with 5.3 and
-		// will be removed when 5.4 releases. 
-		// Use an asynchronous ray-cast.
-//		m_queuedRays [raySlot].rayId = static_cast<CCryAction*>(gEnv->pGameFramework)->GetPhysicQueues().GetRayCaster().Queue(
-//			RayCastRequest::HighPriority,
-//			RayCastRequest(m_eyePosition, m_eyeDirection * FORWARD_DIRECTION * forwardCastDistance,
-//				ent_all,
-//				rwi_pierceability(PIERCE_GLASS) | rwi_colltype_any,
-//				skipEntities,
-//				pPhysEnt ? 1 : 0,
-//				2),
-//			functor(*this, &CEntityAwarenessComponent::OnRayCastDataReceived));
-//
-//		m_queuedRays [raySlot].counter = ++m_requestCounter;
+				// The ray is batched with the others this frame, and the result arrives on OnRayCastDataReceived.
+				if (pAwarenessRayBatch->Request(this, m_eyePosition, m_eyeDirection * FORWARD_DIRECTION * forwardCastDistance,
+					pPhysEnt, isLocalActor) != CAwarenessRayBatch::InvalidRequestId)
+				{
+					++m_queuedRayCount;
+				}
+			}
+			else
+			{
+				pAwarenessRayBatch->AddDropped();
+			}
+		}
 
 #if defined(_DEBUG)
 		if (g_cvars.m_componentAwarenessDebug & eDB_RayCast)
@@ -206,19 +199,24 @@ void CEntityAwarenessComponent::UpdateRaycastQuery()
 	if (staleness > maxRaycastStaleness)
 	{
 		m_rayHitAny = false;
+		m_isRayHit = false;
+		m_rayHitPosition = Vec3(ZERO);
 		m_lookAtEntityId = INVALID_ENTITYID;
 	}
 }
 
 
-void CEntityAwarenessComponent::OnRayCastDataReceived(const QueuedRayID& rayID, const RayCastResult& result)
+void CEntityAwarenessComponent::OnRayCastDropped(CAwarenessRayBatch::TRequestId requestId)
 {
-	int raySlot = QueryRaySlotId(rayID);
-	CRY_ASSERT(raySlot != -1);
+	if (m_queuedRayCount > 0)
+		--m_queuedRayCount;
+}
 
-	// Clear out the raycast slot if we used one.
-	if (raySlot != -1)
-		m_queuedRays [raySlot].Reset();
+
+void CEntityAwarenessComponent::OnRayCastDataReceived(CAwarenessRayBatch::TRequestId requestId, const RayCastResult& result)
+{
+	if (m_queuedRayCount > 0)
+		--m_queuedRayCount;
 
 	// Force the distance to a negative value to invalidate the last result.
 	m_rayHitPierceable.dist = -1.0f;
@@ -249,6 +247,14 @@ void CEntityAwarenessComponent::OnRayCastDataReceived(const QueuedRayID& rayID,
 #endif
 		}
 	}
+	else
+	{
+		// A miss is just as current as a hit, so don't leave the last hit around until it goes stale.
+		m_isRayHit = false;
+		m_rayHitPosition = Vec3(ZERO);
+		m_lookAtEntityId = INVALID_ENTITYID;
+		m_timeLastDeferredResult = gEnv->pTimer->GetCurrTime();
+	}
 
 	// Book-keeping.
 	m_rayHitAny = rayHitSucceed;
@@ -311,48 +317,6 @@ void CEntityAwarenessComponent::OnRayCast(const ray_hit & rayHit)
 }
 
 
-int CEntityAwarenessComponent::RequestRaySlotId()
-{
-	for (int i = 0; i < maxQueuedRays; ++i)
-	{
-		if (m_queuedRays [i].rayId == 0)
-		{
-			return i;
-		}
-	}
-
-	// Find the oldest request and remove it.
-	// HACK: This will lead to wrap-around issues, do a better job of getting a slot.
-	uint32 oldestCounter = m_requestCounter + 1;
-	int oldestSlot = 0;
-	for (int i = 0; i < maxQueuedRays; ++i)
-	{
-		if (m_queuedRays [i].counter < oldestCounter)
-		{
-			oldestCounter = m_queuedRays [i].counter;
-			oldestSlot = i;
-		}
-	}
-
-	m_queuedRays [oldestSlot].Reset();
-
-	return oldestSlot;
-}
-
-
-int CEntityAwarenessComponent::QueryRaySlotId(const QueuedRayID& rayId) const
-{
-	for (int i = 0; i < maxQueuedRays; ++i)
-	{
-		if (m_queuedRays [i].rayId == rayId)
-		{
-			return i;
-		}
-	}
-
-	return -1;
-}
-
 
 void CEntityAwarenessComponent::UpdateProximityQuery()
 {
@@ -365,50 +329,41 @@ void CEntityAwarenessComponent::UpdateProximityQuery()
 	// Clear previous results. We could resize(0) at this point, but rather than thrash memory, I'll see how well
 	// it works just growing when needing and remaining at that size.
 	m_entitiesInProximity.clear();
+	m_proximityProxies.clear();
 
 	// Set up the bounding box query.
-	SEntityProximityQuery qry;
-	qry.box.min = m_eyePosition - positionOffset;
-	qry.box.max = m_eyePosition + positionOffset;
+	const AABB box(m_eyePosition - positionOffset, m_eyePosition + positionOffset);
 
 #if defined(_DEBUG)
 	if (g_cvars.m_componentAwarenessDebug & eDB_ProximalEntities)
 	{
 		// DEBUG: Render the grid for debug purposes.
-		gEnv->pRenderer->GetIRenderAuxGeom()->DrawAABB(qry.box, false, ColorB(255, 0, 0), EBoundingBoxDrawStyle::eBBD_Extremes_Color_Encoded);
+		gEnv->pRenderer->GetIRenderAuxGeom()->DrawAABB(box, false, ColorB(255, 0, 0), EBoundingBoxDrawStyle::eBBD_Extremes_Color_Encoded);
 	}
 #endif
 
-	// Run the query and prepare to populate a list of the results, if they pass muster.
-	gEnv->pEntitySystem->QueryProximity(qry);
-	m_entitiesInProximity.reserve(qry.nCount);
-
-	// Check each result.
-	for (int i = 0; i < qry.nCount; ++i)
-	{
-		IEntity* pEntity = qry.pEntities [i];
-		EntityId entityId = pEntity ? pEntity->GetId() : INVALID_ENTITYID;
+	// Run the query against the shared grid. The results come with cached bounds, so none of the queries built on this
+	// one need to touch the entities again.
+	if (auto pAwarenessGrid = CChrysalisCorePlugin::Get()->GetAwarenessGrid())
+		pAwarenessGrid->Query(box, ownerActorId, m_proximityProxies);
 
-		// Skip this entity.
-		if ((entityId == INVALID_ENTITYID) || (entityId == ownerActorId))
-			continue;
+	m_proximityCandidates.Build(m_proximityProxies);
+	m_entitiesInProximity.reserve(m_proximityProxies.size());
 
+	for (const auto& proxy : m_proximityProxies)
+	{
 #if defined(_DEBUG)
 		if (g_cvars.m_componentAwarenessDebug & eDB_ProximalEntities)
 		{
-			if (strcmp(pEntity->GetName(), "TestMe") == 0)
-				int a = 1;
-
 			// DEBUG: Highlight each entity within the range.
-			AABB bbox;
-			pEntity->GetWorldBounds(bbox);
+			AABB bbox = proxy.worldBounds;
 			bbox.Expand(Vec3(0.01f, 0.01f, 0.01f));
 			gEnv->pRenderer->GetIRenderAuxGeom()->DrawAABB(bbox, true, ColorB(0, 64, 0), EBoundingBoxDrawStyle::eBBD_Extremes_Color_Encoded);
 		}
 #endif
 
 		// Add to the collection.
-		m_entitiesInProximity.push_back(entityId);
+		m_entitiesInProximity.push_back(proxy.entityId);
 	}
 }
 
@@ -417,7 +372,6 @@ void CEntityAwarenessComponent::UpdateNearQuery()
 {
 	// We extend the grid out based on a scaling factor to give it extra reach.
 	const float proximityRadius = m_proximityRadius * proximityCloseByFactor;
-	const float flatDistanceSqr = proximityRadius * proximityRadius;
 
 #if defined(_DEBUG)
 	if (g_cvars.m_componentAwarenessDebug & eDB_NearEntities)
@@ -433,40 +387,31 @@ void CEntityAwarenessComponent::UpdateNearQuery()
 	m_entitiesNear.reserve(m_entitiesInProximity.size());
 	m_entitiesNear.clear();
 
-	// Retrieve the actor EntityId so we can exclude ourselves from the results.
-	EntityId ownerActorId = m_pActor ? m_pActor->GetEntityId() : INVALID_ENTITYID;
+	// #TODO: The near query should really be based off distance from the actor, eye position is currently the camera in TP modes.
 
-	// We parse the results of the latest proximity query, just selecting the ones that match our strict criteria.
-	for (auto& entityId : m_entitiesInProximity)
+	// Filter the results of the latest proximity query, discarding anything too far based on radius. The height is
+	// ignored, turning the cube into a flat circle. The proximity query has already excluded the actor.
+	m_proximityCandidates.FilterNear(m_eyePosition, proximityRadius, m_nearMask);
+
+	for (size_t i = 0; i < m_proximityProxies.size(); ++i)
 	{
-		// Skip this entity.
-		if ((entityId == INVALID_ENTITYID) || (entityId == ownerActorId))
+		if (!IsCandidateSet(m_nearMask, i))
 			continue;
 
-		IEntity* pEntity = gEnv->pEntitySystem->GetEntity(entityId);
-
-		// #TODO: The near query should really be based off distance from the actor, eye position is currently the camera in TP modes.
-
-		// Seems to discard anything too far based on radius, turning the cube into a flat circle.
-		AABB aabb;
-		pEntity->GetWorldBounds(aabb);
-		aabb.min.z = aabb.max.z = m_eyePosition.z;
-		if (aabb.GetDistanceSqr(m_eyePosition) > flatDistanceSqr)
-			continue;
+		const auto& proxy = m_proximityProxies [i];
 
 #if defined(_DEBUG)
 		if (g_cvars.m_componentAwarenessDebug & eDB_NearEntities)
 		{
 			// DEBUG: Highlight the entity.
-			AABB bbox;
-			pEntity->GetWorldBounds(bbox);
+			AABB bbox = proxy.worldBounds;
 			bbox.Expand(Vec3(0.02f, 0.02f, 0.02f));
 			gEnv->pRenderer->GetIRenderAuxGeom()->DrawAABB(bbox, true, ColorB(0, 196, 0), EBoundingBoxDrawStyle::eBBD_Extremes_Color_Encoded);
 		}
 #endif
 
 		// Acceptable result, add to the collection.
-		m_entitiesNear.push_back(entityId);
+		m_entitiesNear.push_back(proxy.entityId);
 	}
 }
 
@@ -490,51 +435,31 @@ void CEntityAwarenessComponent::UpdateInFrontOfQuery()
 	}
 #endif
 
-	// Retrieve the actor EntityId so we can exclude ourselves from the results.
-	EntityId ownerActorId = m_pActor ? m_pActor->GetEntityId() : INVALID_ENTITYID;
+	// We filter the results of the latest proximity query, just selecting those whose oriented bounds are hit by the
+	// line segment. The proximity query has already excluded the actor.
+	m_proximityCandidates.FilterLineseg(lineseg, m_filterMask);
 
-	// We parse the results of the latest proximity query, just selecting the ones that match our strict criteria.
-	for (auto& entityId : m_entitiesInProximity)
+	for (size_t i = 0; i < m_proximityProxies.size(); ++i)
 	{
-		// Skip this entity.
-		if ((entityId == INVALID_ENTITYID) || (entityId == ownerActorId))
+		if (!IsCandidateSet(m_filterMask, i))
 			continue;
 
-		IEntity* pEntity = gEnv->pEntitySystem->GetEntity(entityId);
-
-		AABB bbox;
-		pEntity->GetLocalBounds(bbox);
-		if (!bbox.IsEmpty())
-		{
-			OBB obb(OBB::CreateOBBfromAABB(Matrix33(pEntity->GetWorldTM()), bbox));
+		const auto& proxy = m_proximityProxies [i];
 
-			if (Overlap::Lineseg_OBB(lineseg, pEntity->GetWorldPos(), obb))
-			{
 #if defined(_DEBUG)
-				if (g_cvars.m_componentAwarenessDebug & eDB_InFront)
-				{
-					// DEBUG: let's see those boxes.
-					gEnv->pRenderer->GetIRenderAuxGeom()->DrawOBB(obb, pEntity->GetWorldTM(), true, ColorB(0, 0, 196), EBoundingBoxDrawStyle::eBBD_Extremes_Color_Encoded);
-				}
+		if (g_cvars.m_componentAwarenessDebug & eDB_InFront)
+		{
+			// DEBUG: let's see those boxes.
+			gEnv->pRenderer->GetIRenderAuxGeom()->DrawOBB(proxy.obb, proxy.worldPos, true, ColorB(0, 0, 196), EBoundingBoxDrawStyle::eBBD_Extremes_Color_Encoded);
+		}
 #endif
 
-				// #HACK: TEST: wrong place for this test - move it to somewhere i can see it try all the entities near us.
-				auto pInteractor = pEntity->GetComponent<CEntityInteractionComponent>();
-				if (pInteractor)
-				{
-					// There's an interactor component, so this is an interactive entity.
-					// 
-					auto verbs = pInteractor->GetVerbs();
-				}
-
-				m_entitiesInFrontOf.push_back(pEntity->GetId());
-			}
-		}
+		m_entitiesInFrontOf.push_back(proxy.entityId);
 	}
 }
 
 
-const Entities& CEntityAwarenessComponent::GetNearDotFiltered(float minDot, float maxDot)
+Entities CEntityAwarenessComponent::GetNearDotFiltered(float minDot, float maxDot)
 {
 	int resultIndex = 0;
 	int bestResultIndex = 0;
@@ -545,47 +470,39 @@ const Entities& CEntityAwarenessComponent::GetNearDotFiltered(float minDot, floa
 	m_entitiesNearDotFiltered.clear();
 
 	// Refresh the list of near entities.
-	auto entities = NearQuery();
+	NearQuery();
+
+	// Batch filter every proximity candidate by angle, then keep only those which are also near.
+	const Vec3 dirLooking = (m_eyeDirection * FORWARD_DIRECTION).normalized();
+	m_proximityCandidates.FilterDot(m_eyePosition, dirLooking, minDot, maxDot, m_filterMask, m_filterScores);
 
 	// Check each entity to see which is the best fit.
-	for (auto& entityId : entities)
+	for (size_t i = 0; i < m_proximityProxies.size(); ++i)
 	{
-		IEntity *pEntity = gEnv->pEntitySystem->GetEntity(entityId);
-		if (!pEntity)
+		if (!IsCandidateSet(m_nearMask, i) || !IsCandidateSet(m_filterMask, i))
 			continue;
 
-		AABB bbox;
-		pEntity->GetWorldBounds(bbox);
-
-		Vec3 itemPos = bbox.GetCenter();
-		Vec3 dirToItem = (itemPos - m_eyePosition).normalized();
-		Vec3 dirLooking = (m_eyeDirection * FORWARD_DIRECTION).normalized();
-		float dotToItem = dirToItem.dot(dirLooking);
-
-		if ((dotToItem >= minDot) && (dotToItem <= maxDot))
-		{
 #if defined(_DEBUG)
-			if (g_cvars.m_componentAwarenessDebug & eDB_DotFiltered)
-			{
-				// DEBUG: Highlight the entity.
-				bbox.Expand(Vec3(0.03f, 0.03f, 0.03f));
-				gEnv->pRenderer->GetIRenderAuxGeom()->DrawAABB(bbox, true, ColorB(0, 0, 64), EBoundingBoxDrawStyle::eBBD_Extremes_Color_Encoded);
-			}
+		if (g_cvars.m_componentAwarenessDebug & eDB_DotFiltered)
+		{
+			// DEBUG: Highlight the entity.
+			AABB bbox = m_proximityProxies [i].worldBounds;
+			bbox.Expand(Vec3(0.03f, 0.03f, 0.03f));
+			gEnv->pRenderer->GetIRenderAuxGeom()->DrawAABB(bbox, true, ColorB(0, 0, 64), EBoundingBoxDrawStyle::eBBD_Extremes_Color_Encoded);
+		}
 #endif
 
-			// Provide a score for this result to qualify how good a match it is.
-			float distance = (itemPos - m_eyePosition).len();
-			float score = (1.0f - dotToItem) * distance;
-			if (score < bestScore)
-			{
-				bestResultIndex = resultIndex;
-				bestScore = score;
-			}
-
-			// Acceptable result, add to the collection.
-			m_entitiesNearDotFiltered.push_back(entityId);
-			resultIndex++;
+		// The score qualifies how good a match it is, based on the angle and distance.
+		const float score = m_filterScores [i];
+		if (score < bestScore)
+		{
+			bestResultIndex = resultIndex;
+			bestScore = score;
 		}
+
+		// Acceptable result, add to the collection.
+		m_entitiesNearDotFiltered.push_back(m_proximityProxies [i].entityId);
+		resultIndex++;
 	}
 
 	// Before returning the result we should swap the best result into the first element.
@@ -606,6 +523,40 @@ const Entities& CEntityAwarenessComponent::GetNearDotFiltered(float minDot, floa
 	}
 #endif
 
-	return m_entitiesNearDotFiltered;
+	return m_entitiesNearDotFiltered.GetSpan();
+}
+
+
+EntityId CEntityAwarenessComponent::GetBestWithVerb(CryHashStringId verbId, float radius, float minDot) const
+{
+	// A verb without a bit can't be offered by anything in the grid.
+	const uint32 verbBit = CEntityInteractionComponent::GetVerbBit(verbId, false);
+	if (verbBit == 0)
+		return INVALID_ENTITYID;
+
+	auto pAwarenessGrid = CChrysalisCorePlugin::Get()->GetAwarenessGrid();
+	if (!pAwarenessGrid)
+		return INVALID_ENTITYID;
+
+	const Vec3 dirLooking = (m_eyeDirection * FORWARD_DIRECTION).normalized();
+	const EntityId ownerActorId = m_pActor ? m_pActor->GetEntityId() : INVALID_ENTITYID;
+
+	return pAwarenessGrid->QueryBestWithVerbs(m_eyePosition, dirLooking, radius, radius, minDot, verbBit, ownerActorId);
+}
+
+
+EntityId CEntityAwarenessComponent::GetBestInteractive(float minDot) const
+{
+	auto pAwarenessGrid = CChrysalisCorePlugin::Get()->GetAwarenessGrid();
+	if (!pAwarenessGrid)
+		return INVALID_ENTITYID;
+
+	const Vec3 dirLooking = (m_eyeDirection * FORWARD_DIRECTION).normalized();
+	const EntityId ownerActorId = m_pActor ? m_pActor->GetEntityId() : INVALID_ENTITYID;
+
+	// The same extents as the proximity query then the near filter: flattened to the close by radius, but reaching the
+	// full proximity radius above and below the eyes. A verb mask of zero matches anything with an enabled interaction.
+	return pAwarenessGrid->QueryBestWithVerbs(m_eyePosition, dirLooking, m_proximityRadius * proximityCloseByFactor, m_proximityRadius, minDot, 0,
+		ownerActorId);
 }
 }
\ No newline at end of file
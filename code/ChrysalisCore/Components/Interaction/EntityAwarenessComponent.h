@@ -11,6 +11,10 @@ with which the actor might wish to or need to interact.
 #include <CryPhysics/RayCastQueue.h>
 #include <CryAction.h>
 #include <CryActionPhysicQueues.h>
+#include "AwarenessFilter.h"
+#include "AwarenessRayBatch.h"
+#include <Utility/CryHash.h>
+#include <Utility/SmallBuffer.h>
 
 struct ray_hit;
 
@@ -19,7 +23,8 @@ namespace Chrysalis
 {
 class IActorComponent;
 
-typedef std::vector<EntityId> Entities;
+/** A view over the results of an awareness query. It's only valid until the next time the query is refreshed. */
+typedef CSpan<EntityId> Entities;
 
 class CEntityAwarenessComponent
 	: public IEntityComponent
@@ -30,14 +35,13 @@ protected:
 
 	// IEntityComponent
 	void Initialize() override;
-	void ProcessEvent(const SEntityEvent& event) override;
-	Cry::Entity::EntityEventMask GetEventMask() const override { return EventToMask(EEntityEvent::Update); }
+	void OnShutDown() override;
 	virtual void GetMemoryUsage(ICrySizer* pSizer) const;
 	// ~IEntityComponent
 
 public:
 	CEntityAwarenessComponent();
-	virtual ~CEntityAwarenessComponent();
+	virtual ~CEntityAwarenessComponent() {}
 
 	static void ReflectType(Schematyc::CTypeDesc<CEntityAwarenessComponent>& desc);
 
@@ -62,17 +66,33 @@ public:
 	};
 
 
-	/** Updates this instance. */
+	/** Updates this instance. This is called by the awareness scheduler, which decides how often each actor is updated. */
 	void Update();
 
 
+	/** Gets the number of queries run by all awareness components since the count was last reset. */
+	static uint32 GetQueryCount() { return m_queryCount; }
+
+
+	/** Resets the query count. */
+	static void ResetQueryCount() { m_queryCount = 0; }
+
+
+	/**
+	Receives the results of the deferred ray-casts requested from the awareness ray batch.
+
+	\param	requestId Identifier for the request.
+	\param	result    The result.
+	**/
+	void OnRayCastDataReceived(CAwarenessRayBatch::TRequestId requestId, const RayCastResult& result);
+
+
 	/**
-	Functor that receives the results of deferred ray-cast operations.
+	Called by the awareness ray batch when it drops a request without a result, e.g. when it is reset.
 
-	\param	rayID  Identifier for the ray.
-	\param	result The result.
+	\param	requestId Identifier for the request.
 	**/
-	void OnRayCastDataReceived(const QueuedRayID& rayID, const RayCastResult& result);
+	void OnRayCastDropped(CAwarenessRayBatch::TRequestId requestId);
 
 
 	/**
@@ -99,24 +119,25 @@ public:
 	ILINE void SetProximityRadius(float proximityRadius)
 	{
 		m_proximityRadius = proximityRadius;
-		m_validQueries &= ~(eWQ_Proximity | eWQ_InFrontOf);
+		// Everything filtered from the proximity candidates is now stale too.
+		m_validQueries &= ~((1u << eWQ_Proximity) | (1u << eWQ_CloseBy) | (1u << eWQ_InFrontOf));
 	}
 
 
-	ILINE Entities& ProximityQuery()
+	ILINE Entities ProximityQuery()
 	{
 		RefreshQueryCache(eWQ_Proximity);
 
-		return m_entitiesInProximity;
+		return m_entitiesInProximity.GetSpan();
 	}
 
 
-	ILINE Entities& NearQuery()
+	ILINE Entities NearQuery()
 	{
 		RefreshQueryCache(eWQ_Proximity);
 		RefreshQueryCache(eWQ_CloseBy);
 
-		return m_entitiesNear;
+		return m_entitiesNear.GetSpan();
 	}
 
 
@@ -141,7 +162,7 @@ public:
 
 	\return The entities in front of the actor.
 	**/
-	ILINE const Entities& GetEntitiesInFrontOf()
+	ILINE Entities GetEntitiesInFrontOf()
 	{
 		return InFrontOfQuery();
 	}
@@ -155,7 +176,7 @@ public:
 	**/
 	ILINE IEntity* GetEntityInFrontOf()
 	{
-		auto entities = InFrontOfQuery();
+		const Entities entities = InFrontOfQuery();
 
 		// #TODO: This should probably be more precise about what it returns, rather than just the first element of the vector.
 		return entities.empty() ? nullptr : gEnv->pEntitySystem->GetEntity(entities [0]);
@@ -173,7 +194,33 @@ public:
 
 	\return The near dot filtered.
 	**/
-	const Entities& GetNearDotFiltered(float minDot = 0.9f, float maxDot = 1.0f);
+	Entities GetNearDotFiltered(float minDot = 0.9f, float maxDot = 1.0f);
+
+
+	/**
+	Finds the entity which best matches where the actor is looking from those offering a verb, e.g. the nearest thing
+	in view that can be picked up. This is answered straight from the awareness grid in a single pass, so it needs no
+	component lookups and doesn't depend on the cached queries being up to date.
+
+	\param	verbId	The verb.
+	\param	radius	(Optional) The furthest the entity can be from the actor's eyes, ignoring height.
+	\param	minDot	(Optional) The minimum dot product of the gaze with the direction to the entity. 0.866 is 30 degrees.
+
+	\return The entity, or INVALID_ENTITYID if none match.
+	**/
+	EntityId GetBestWithVerb(CryHashStringId verbId, float radius = 2.0f, float minDot = 0.866f) const;
+
+
+	/**
+	Finds the entity which best matches where the actor is looking from those with an enabled interaction. It covers the
+	same area as GetNearDotFiltered, the close by radius around the eyes and the proximity radius above and below them,
+	but skips anything which can't be interacted with and is answered in a single pass through the awareness grid.
+
+	\param	minDot	(Optional) The minimum dot product of the gaze with the direction to the entity.
+
+	\return The entity, or INVALID_ENTITYID if none match.
+	**/
+	EntityId GetBestInteractive(float minDot = 0.9f) const;
 
 
 	/**
@@ -239,26 +286,6 @@ private:
 	};
 
 
-	struct SRayInfo
-	{
-		void Reset()
-		{
-			if (rayId != 0)
-			{
-				// #HACK: Massive issue, removed due to problems linking to CryAction in 5.3. It's hard to tell why this is even
-				// here now. Reseting the whole queue seems like a terrible idea in a function like this.
-				// static_cast<CCryAction*>(gEnv->pGameFramework)->GetPhysicQueues().GetRayCaster().Reset(); 
-			}
-
-			rayId = 0;
-			counter = 0;
-		}
-
-		QueuedRayID rayId = 0;
-		uint32 counter = 0;
-	};
-
-
 	/**
 	Checks to see if we have a query result that is still valid for this FrameId. If no fresh query result is found
 	it will run a query update and mark the new result as being useable within this FrameId. This works like a simple
@@ -289,6 +316,7 @@ private:
 		// Run the query the caller was interested in.
 		// Results are returned as a side-effect of the function that is run.
 		(this->*(m_updateQueryFunctions [query]))();
+		++m_queryCount;
 
 		// Mark that query as now being valid for this FrameId.
 		m_validQueries |= queryMask;
@@ -298,8 +326,13 @@ private:
 	// Ensure all update query routines conform to this definition.
 	typedef void (CEntityAwarenessComponent::*UpdateQueryFunction)();
 
-	// Limit the size of the array used to track the raycasts.
-	static const int maxQueuedRays { 6 };
+	// Limit the number of rays we can have waiting on a result.
+	static const uint32 maxQueuedRays { 6 };
+
+	// Query results up to this size are held inside the component, larger ones spill to storage which is reused.
+	static const size_t inlineResults { 16 };
+
+	typedef CSmallBuffer<EntityId, inlineResults> TEntityBuffer;
 
 	/** The proximity radius defines the maximum distance we will search for entities that are considered
 	"in-proximity". It is used to restrict both proximity queries and ray-cast queries. */
@@ -331,12 +364,11 @@ private:
 	// An array of functors which run the update queries.
 	static UpdateQueryFunction m_updateQueryFunctions [];
 
-	// #TODO: Maybe use a vector for this?
-	SRayInfo m_queuedRays [maxQueuedRays];
+	// The number of queries run by every awareness component, for the statistics.
+	static uint32 m_queryCount;
 
-	// Keep a track of how many rays we have queued.
-	// #TODO: Is there a safer way to handle all of this?
-	uint32 m_requestCounter { 0 };
+	// The number of rays we have requested which haven't returned a result yet.
+	uint32 m_queuedRayCount { 0 };
 
 	/** Track the time of the last deferred ray-cast. */
 	float m_timeLastDeferredResult { 0.0f };
@@ -355,16 +387,30 @@ private:
 
 	// The entities within proximity of the AABB surrounding the actor. It may be worth highlighting these as being
 	// interactive for the player.
-	Entities m_entitiesInProximity;
+	TEntityBuffer m_entitiesInProximity;
+
+	// Cached bounds for each of the entities in proximity, in the same order. The other queries filter these rather than
+	// going back to the entity system.
+	std::vector<CAwarenessGrid::SProxy> m_proximityProxies;
+
+	// A structure-of-arrays copy of the proximity proxies, which the other queries are batch filtered against.
+	CAwarenessCandidates m_proximityCandidates;
 
 	// The entities which are close enough to the actor to be interactable or worth highlighting.
-	Entities m_entitiesNear;
+	TEntityBuffer m_entitiesNear;
+
+	// Which of the proximity candidates are near.
+	TCandidateMask m_nearMask;
+
+	// Scratch space for the in-front and dot product filters.
+	TCandidateMask m_filterMask;
+	std::vector<float> m_filterScores;
 
 	// Dot product filtered version of the near entities.
-	Entities m_entitiesNearDotFiltered;
+	TEntityBuffer m_entitiesNearDotFiltered;
 
 	// The entities which are in front of the actor.
-	Entities m_entitiesInFrontOf;
+	TEntityBuffer m_entitiesInFrontOf;
 
 
 	/**
@@ -375,9 +421,10 @@ private:
 
 
 	/**
-	Creates an AABB around the actor and performs a query on entities within that box. The size of the box is based
-	on m_proximityRadius. Any entities which are within the box will be made available in the m_entitiesInProximity
-	container as a side effect of running this query. No culling is performed on the entities returned from the query.
+	Creates an AABB around the actor and performs a query on the interactive entities within that box, using the shared
+	awareness grid. The size of the box is based on m_proximityRadius. Any entities which are within the box will be
+	made available in the m_entitiesInProximity container as a side effect of running this query. No culling is
+	performed on the entities returned from the query.
 
 	You can use this as a base on which to build more nuanced and precise queries.
 	**/
@@ -405,40 +452,21 @@ private:
 	A proximity based query that limits the results to only those entities which are considered to be in front of the
 	actor. These are limited based on a line segment from the actor's eyes, forward in the direction they are looking.
 
-	\return A reference to a const Entities.
+	\return A view of the entities in front of the actor.
 	**/
-	ILINE const Entities& InFrontOfQuery()
+	ILINE Entities InFrontOfQuery()
 	{
 		RefreshQueryCache(eWQ_Proximity);
 		RefreshQueryCache(eWQ_InFrontOf);
 
-		return m_entitiesInFrontOf;
+		return m_entitiesInFrontOf.GetSpan();
 	}
 
 	/**
-	Internally process the result of the ray-cast. This is shared between synchronous and asynchronous results.
+	Internally process a solid hit from the ray-cast.
 
 	\param	rayHit The ray hit.
 	**/
 	void OnRayCast(const ray_hit& rayHit);
-
-
-	/**
-	Runs through the raycast queue and finds a free slot, if available. If none is available it will kill the oldest
-	slot.
-
-	\return The ray slot Id.
-	**/
-	int RequestRaySlotId();
-
-
-	/**
-	Queries the queue to find the slot Id for a queued raycast.
-
-	\param	rayId Identifier for the ray.
-
-	\return The ray slot identifier.
-	**/
-	int QueryRaySlotId(const QueuedRayID& rayId) const;
 };
 }
\ No newline at end of file
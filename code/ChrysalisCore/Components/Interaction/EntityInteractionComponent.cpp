@@ -2,6 +2,8 @@
 
 #include "EntityInteractionComponent.h"
 #include "Components/Player/PlayerComponent.h"
+#include "Components/Interaction/AwarenessGrid.h"
+#include <Plugin/ChrysalisCorePlugin.h>
 
 
 namespace Chrysalis
@@ -30,6 +32,31 @@ void CEntityInteractionComponent::ReflectType(Schematyc::CTypeDesc<CEntityIntera
 
 void CEntityInteractionComponent::Initialize()
 {
+	// Interactive entities are tracked by the awareness grid so actors can find them without querying the entity system.
+	UpdateAwarenessGrid();
+}
+
+
+void CEntityInteractionComponent::ProcessEvent(const SEntityEvent& event)
+{
+	switch (event.event)
+	{
+		// Keep the awareness grid in step with any change to our bounds or visibility.
+		case EEntityEvent::TransformChanged:
+		case EEntityEvent::Hidden:
+		case EEntityEvent::Unhidden:
+		case EEntityEvent::Reset:
+		case EEntityEvent::LevelStarted:
+			UpdateAwarenessGrid();
+			break;
+	}
+}
+
+
+void CEntityInteractionComponent::OnShutDown()
+{
+	if (auto pAwarenessGrid = CChrysalisCorePlugin::Get()->GetAwarenessGrid())
+		pAwarenessGrid->RemoveEntity(GetEntityId());
 }
 
 
@@ -38,93 +65,210 @@ void CEntityInteractionComponent::Initialize()
 // ***
 
 
-void CEntityInteractionComponent::AddInteraction(IInteractionPtr interaction)
+uint32 CEntityInteractionComponent::GetVerbBit(CryHashStringId verbId, bool canAdd)
+{
+	static CryHash verbs [32];
+	static uint32 verbCount { 0 };
+
+	for (uint32 i = 0; i < verbCount; ++i)
+	{
+		if (verbs [i] == verbId.id)
+			return 1u << i;
+	}
+
+	if (canAdd)
+	{
+		if (verbCount < CRY_ARRAY_COUNT(verbs))
+		{
+			verbs [verbCount] = verbId.id;
+			return 1u << verbCount++;
+		}
+
+		CryWarning(VALIDATOR_MODULE_GAME, VALIDATOR_WARNING, "There are no verb bits left for %s. Entities offering it can't be searched for by that verb.",
+			verbId.GetDebugName());
+	}
+
+	return 0;
+}
+
+
+void CEntityInteractionComponent::OnInteractionsChanged()
+{
+	++m_version;
+
+	uint32 verbMask = 0;
+	bool isInteractive = false;
+	for (auto& it : m_Interactions)
+	{
+		if (it.isEnabled)
+		{
+			verbMask |= it.verbBit;
+			isInteractive = true;
+		}
+	}
+
+	if ((verbMask != m_verbMask) || (isInteractive != m_isInteractive))
+	{
+		m_verbMask = verbMask;
+		m_isInteractive = isInteractive;
+		UpdateAwarenessGrid();
+	}
+}
+
+
+void CEntityInteractionComponent::UpdateAwarenessGrid()
 {
-	m_Interactions.push_back(interaction);
+	if (auto pAwarenessGrid = CChrysalisCorePlugin::Get()->GetAwarenessGrid())
+		pAwarenessGrid->UpdateEntity(*GetEntity(), m_verbMask, m_isInteractive);
 }
 
 
-void CEntityInteractionComponent::RemoveInteraction(string verb)
+void CEntityInteractionComponent::AddInteraction(const IInteraction& interaction, void* pSubject, bool isEnabled, bool isHidden)
 {
+	const CryHashStringId verbId(interaction.GetVerb().c_str());
+
+	m_Interactions.push_back({ verbId, GetVerbBit(verbId), &interaction, pSubject, isEnabled, isHidden });
+
+	OnInteractionsChanged();
+}
+
+
+void CEntityInteractionComponent::RemoveInteraction(CryHashStringId verbId)
+{
+	const auto oldSize = m_Interactions.size();
+
 	m_Interactions.erase(std::remove_if(m_Interactions.begin(), m_Interactions.end(),
-		[&](IInteractionPtr i) { return i->GetVerb().compare(verb) == 0; }),
+		[&](const SInteractionEntry& entry) { return entry.verbId == verbId; }),
 		m_Interactions.end());
+
+	if (m_Interactions.size() != oldSize)
+		OnInteractionsChanged();
 }
 
 
-std::vector<string> CEntityInteractionComponent::GetVerbs(bool includeHidden)
+void CEntityInteractionComponent::SetInteractionEnabled(CryHashStringId verbId, bool isEnabled)
 {
-	std::vector<string> verbs;
+	bool isChanged = false;
 
 	for (auto& it : m_Interactions)
 	{
-		if (it->IsEnabled())
+		if ((it.verbId == verbId) && (it.isEnabled != isEnabled))
 		{
-			if ((!it->IsHidden()) || ((it->IsHidden()) && includeHidden))
-			{
-				verbs.push_back(it->GetVerb());
-			}
+			it.isEnabled = isEnabled;
+			isChanged = true;
 		}
 	}
 
-	return verbs;
+	if (isChanged)
+		OnInteractionsChanged();
 }
 
 
-IInteractionWeakPtr CEntityInteractionComponent::GetInteraction(string verb)
+void CEntityInteractionComponent::SetInteractionHidden(CryHashStringId verbId, bool isHidden)
 {
+	bool isChanged = false;
+
 	for (auto& it : m_Interactions)
 	{
-		if ((it->GetVerb().compare(verb) == 0) && (it->IsEnabled()))
+		if ((it.verbId == verbId) && (it.isHidden != isHidden))
 		{
-			return it;
+			it.isHidden = isHidden;
+			isChanged = true;
 		}
 	}
 
-	CryLogAlways("There's no interaction verb for %s", verb);
+	if (isChanged)
+		OnInteractionsChanged();
+}
+
+
+const std::vector<string>& CEntityInteractionComponent::GetVerbs(bool includeHidden)
+{
+	SVerbCache& cache = m_verbCache [includeHidden ? 1 : 0];
 
-	return std::weak_ptr<IInteraction>();
+	if ((!cache.isValid) || (cache.version != m_version))
+	{
+		cache.verbs.clear();
+
+		for (auto& it : m_Interactions)
+		{
+			if (it.isEnabled)
+			{
+				if ((!it.isHidden) || includeHidden)
+				{
+					cache.verbs.push_back(it.pInteraction->GetVerb());
+				}
+			}
+		}
+
+		cache.version = m_version;
+		cache.isValid = true;
+	}
+
+	return cache.verbs;
 }
 
 
-IInteractionWeakPtr CEntityInteractionComponent::SelectInteractionVerb(string verb)
+const CEntityInteractionComponent::SInteractionEntry* CEntityInteractionComponent::FindInteraction(CryHashStringId verbId) const
 {
 	for (auto& it : m_Interactions)
 	{
-		if ((it->GetVerb().compare(verb) == 0) && (it->IsEnabled()))
+		if ((it.verbId == verbId) && (it.isEnabled))
 		{
-			m_selectedInteraction = it;
-			return it;
+			return &it;
 		}
 	}
 
-	return std::weak_ptr<IInteraction>();
+	return nullptr;
+}
+
+
+CBoundInteraction CEntityInteractionComponent::GetInteraction(CryHashStringId verbId)
+{
+	if (auto pEntry = FindInteraction(verbId))
+		return CBoundInteraction(pEntry->pInteraction, pEntry->pSubject);
+
+	CryLogAlways("There's no interaction verb for %u %s", verbId.id, verbId.GetDebugName());
+
+	return CBoundInteraction();
+}
+
+
+CBoundInteraction CEntityInteractionComponent::SelectInteractionVerb(CryHashStringId verbId)
+{
+	if (auto pEntry = FindInteraction(verbId))
+	{
+		m_selectedInteraction = CBoundInteraction(pEntry->pInteraction, pEntry->pSubject);
+		return m_selectedInteraction;
+	}
+
+	return CBoundInteraction();
 }
 
 
 void CEntityInteractionComponent::ClearInteractionVerb()
 {
-	m_selectedInteraction = nullptr;
+	m_selectedInteraction = CBoundInteraction();
 }
 
 
 void CEntityInteractionComponent::OnInteractionStart(IActorComponent& actor)
 {
 	CRY_ASSERT_MESSAGE(m_selectedInteraction, "Be sure to set an interaction before attempting to call it.");
-	m_selectedInteraction->OnInteractionStart(actor);
+	m_selectedInteraction.OnInteractionStart(actor);
 }
 
 
 void CEntityInteractionComponent::OnInteractionTick(IActorComponent& actor)
 {
 	CRY_ASSERT_MESSAGE(m_selectedInteraction, "Be sure to set an interaction before attempting to call it.");
-	m_selectedInteraction->OnInteractionTick(actor);
+	m_selectedInteraction.OnInteractionTick(actor);
 }
 
 
 void CEntityInteractionComponent::OnInteractionComplete(IActorComponent& actor)
 {
 	CRY_ASSERT_MESSAGE(m_selectedInteraction, "Be sure to set an interaction before attempting to call it.");
-	m_selectedInteraction->OnInteractionComplete(actor);
+	m_selectedInteraction.OnInteractionComplete(actor);
 }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Entities/Interaction/IEntityInteraction.h>
+#include <Utility/CryHash.h>
 
 
 namespace Chrysalis
@@ -21,6 +22,10 @@ protected:
 
 	// IEntityComponent
 	void Initialize() override;
+	void ProcessEvent(const SEntityEvent& event) override;
+	Cry::Entity::EntityEventMask GetEventMask() const override { return EventToMask(EEntityEvent::TransformChanged) | EventToMask(EEntityEvent::Hidden)
+		| EventToMask(EEntityEvent::Unhidden) | EventToMask(EEntityEvent::Reset) | EventToMask(EEntityEvent::LevelStarted); }
+	void OnShutDown() override;
 	// ~IEntityComponent
 
 public:
@@ -35,12 +40,61 @@ public:
 		return id;
 	}
 
-	std::vector<string> GetVerbs(bool includeHidden = false);
+	/**
+	Gets the verbs for the enabled interactions, in the order the interactions were added. The list is cached and only
+	rebuilt after interactions are added or removed, or one of them is enabled, disabled, hidden or unhidden.
 
-	void AddInteraction(IInteractionPtr interaction);
-	void RemoveInteraction(string verb);
-	IInteractionWeakPtr GetInteraction(string verb);
-	IInteractionWeakPtr SelectInteractionVerb(string verb);
+	\param	includeHidden	True to include the verbs for hidden interactions.
+
+	\return	The verbs. The reference remains valid until the next change to the interactions.
+	**/
+	const std::vector<string>& GetVerbs(bool includeHidden = false);
+
+
+	/**
+	Gets a version number for the verbs. It changes each time the verbs might have changed, so it can be stored with
+	anything derived from them to tell when they need refreshing.
+
+	\return	The verbs version.
+	**/
+	uint32 GetVerbsVersion() const { return m_version; }
+
+
+	/** Gets a bit for each verb offered by an enabled interaction. See GetVerbBit. */
+	uint32 GetVerbMask() const { return m_verbMask; }
+
+
+	/**
+	Gets the bit used for a verb in the verb masks kept by the awareness grid. Bits are handed out to verbs in the order
+	they are first seen, and once all 32 are taken any further verbs get no bit and can't be searched for.
+
+	\param	verbId	The verb.
+	\param	canAdd	(Optional) False to only look up verbs which already have a bit, e.g. when searching.
+
+	\return	The bit for the verb, or zero if it doesn't have one.
+	**/
+	static uint32 GetVerbBit(CryHashStringId verbId, bool canAdd = true);
+
+	/**
+	Adds an interaction of the given type. Every entity shares the one instance of each type of interaction, so this
+	only adds a small record with the subject and its state.
+
+	\param [in,out]	pSubject 	The subject the interaction acts on.
+	\param 			isEnabled	(Optional) True if the interaction starts enabled.
+	\param 			isHidden 	(Optional) True if the interaction starts hidden.
+	**/
+	template <class TInteractionType>
+	void AddInteraction(typename TInteractionType::TSubjectType* pSubject, bool isEnabled = true, bool isHidden = false)
+	{
+		static const TInteractionType interaction {};
+		AddInteraction(interaction, pSubject, isEnabled, isHidden);
+	}
+
+	void RemoveInteraction(CryHashStringId verbId);
+	void SetInteractionEnabled(CryHashStringId verbId, bool isEnabled);
+	void SetInteractionHidden(CryHashStringId verbId, bool isHidden);
+	CBoundInteraction GetInteraction(CryHashStringId verbId);
+	CBoundInteraction SelectInteractionVerb(CryHashStringId verbId);
 	void ClearInteractionVerb();
 
 	void OnInteractionStart(IActorComponent& actor);
@@ -48,7 +102,50 @@ public:
 	void OnInteractionComplete(IActorComponent& actor);
 
 private:
-	std::vector<IInteractionPtr> m_Interactions;
-	IInteractionPtr m_selectedInteraction { IInteractionPtr() };
+	/** An interaction, with its verb hashed once when it is added so lookups only need to compare the hashes. */
+	struct SInteractionEntry
+	{
+		CryHashStringId verbId;
+		uint32 verbBit;
+		const IInteraction* pInteraction;
+		void* pSubject;
+		bool isEnabled;
+		bool isHidden;
+	};
+
+	void AddInteraction(const IInteraction& interaction, void* pSubject, bool isEnabled, bool isHidden);
+
+	/** Finds the first enabled interaction for a verb. */
+	const SInteractionEntry* FindInteraction(CryHashStringId verbId) const;
+
+	/** Called whenever the set of interactions or their state changes. */
+	void OnInteractionsChanged();
+
+	/** Passes our bounds and verbs on to the awareness grid. */
+	void UpdateAwarenessGrid();
+
+	/** The verbs we last built, and the version they were built for. */
+	struct SVerbCache
+	{
+		std::vector<string> verbs;
+		uint32 version { 0 };
+		bool isValid { false };
+	};
+
+	std::vector<SInteractionEntry> m_Interactions;
+
+	/** Cached verbs, with and without the hidden interactions. */
+	SVerbCache m_verbCache [2];
+
+	/** Bumped whenever an interaction is added, removed or changes state. */
+	uint32 m_version { 0 };
+
+	/** A bit for each verb offered by an enabled interaction. */
+	uint32 m_verbMask { 0 };
+
+	/** True if any interaction is enabled. Verbs without a bit don't show in the mask, so this is tracked separately. */
+	bool m_isInteractive { false };
+
+	CBoundInteraction m_selectedInteraction;
 };
 }
\ No newline at end of file
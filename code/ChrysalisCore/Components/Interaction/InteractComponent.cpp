@@ -83,19 +83,19 @@ void CInteractComponent::Initialize()
 	m_interactor = GetEntity()->GetOrCreateComponent<CEntityInteractionComponent>();
 	if (m_interactor)
 	{
-		m_interactPtr = std::make_shared<CInteractionInteract>(this);
-		m_interactor->AddInteraction(m_interactPtr);
+		m_interactor->AddInteraction<CInteractionInteract>(this);
 	}
 }
 
 
 void CInteractComponent::OnResetState()
 {
-	m_interactPtr->SetEnabled(m_isEnabled);
+	if (m_interactor)
+		m_interactor->SetInteractionEnabled("interaction_interact", m_isEnabled);
 }
 
 
-void CInteractComponent::OnInteractionInteractStart(IInteraction& pInteraction, IActorComponent& actor)
+void CInteractComponent::OnInteractionInteractStart(const IInteraction& pInteraction, IActorComponent& actor)
 {
 	if (m_isEnabled)
 	{
@@ -131,7 +131,7 @@ void CInteractComponent::OnInteractionInteractStart(IInteraction& pInteraction,
 }
 
 
-void CInteractComponent::OnInteractionInteractTick(IInteraction& pInteraction, IActorComponent& actor)
+void CInteractComponent::OnInteractionInteractTick(const IInteraction& pInteraction, IActorComponent& actor)
 {
 	if (m_isEnabled)
 	{
@@ -145,7 +145,7 @@ void CInteractComponent::OnInteractionInteractTick(IInteraction& pInteraction, I
 }
 
 
-void CInteractComponent::OnInteractionInteractComplete(IInteraction& pInteraction, IActorComponent& actor)
+void CInteractComponent::OnInteractionInteractComplete(const IInteraction& pInteraction, IActorComponent& actor)
 {
 	if (m_isEnabled)
 	{
@@ -223,8 +223,14 @@ void CInteractComponent::OnActionAnimationEvent(ICharacterInstance * pCharacter,
 }
 
 
-void CInteractComponent::InformAllLinkedEntities(string verb, bool isInteractedOn)
+void CInteractComponent::InformAllLinkedEntities(const CHashedString& verb, bool isInteractedOn)
 {
+	static const CHashedString verbName { "Verb" };
+	static const CHashedString isInteractedOnName { "IsInteractedOn" };
+
+	// The same signal goes to every linked entity, so only hash it once.
+	const CHashedString queueSignalVerb = m_queueSignal.empty() ? kQueueSignal : CHashedString(m_queueSignal.c_str());
+
 	// Notify every linked entity.
 	auto* entityLinks = GetEntity()->GetEntityLinks();
 	while (entityLinks)
@@ -232,17 +238,16 @@ void CInteractComponent::InformAllLinkedEntities(string verb, bool isInteractedO
 		auto pTargetEntity = gEnv->pEntitySystem->GetEntity(entityLinks->entityId);
 		auto pDrsProxy = crycomponent_cast<IEntityDynamicResponseComponent*> (pTargetEntity->CreateProxy(ENTITY_PROXY_DYNAMICRESPONSE));
 
-		// Create a context variable collection and populate it based on information from the target entity.
-		DRS::IVariableCollectionSharedPtr pContextVariableCollection = gEnv->pDynamicResponseSystem->CreateContextCollection();
+		// Grab a context variable collection and populate it based on information from the target entity.
+		DRS::IVariableCollectionSharedPtr pContextVariableCollection = m_contextPool.Acquire();
 
 		// It might be useful to know which verb triggered the interaction.
-		pContextVariableCollection->CreateVariable("Verb", CHashedString(verb));
+		pContextVariableCollection->SetVariableValue(verbName, verb);
 
 		// The Interact value is always set, regardless of which verb was triggered.
-		pContextVariableCollection->CreateVariable("IsInteractedOn", isInteractedOn);
+		pContextVariableCollection->SetVariableValue(isInteractedOnName, isInteractedOn);
 
 		// Queue it and let the DRS handle it now.
-		const string queueSignalVerb = m_queueSignal.empty() ? kQueueSignal : m_queueSignal.c_str();
 		pDrsProxy->GetResponseActor()->QueueSignal(queueSignalVerb, pContextVariableCollection);
 
 		// Next please.
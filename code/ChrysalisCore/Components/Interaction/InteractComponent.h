@@ -2,6 +2,7 @@
 
 #include <Components/Interaction/EntityInteractionComponent.h>
 #include <Actor/Animation/Actions/ActorAnimationActionInteration.h>
+#include <Utility/DRS.h>
 
 
 namespace Chrysalis
@@ -47,15 +48,15 @@ public:
 		return id;
 	}
 
-	const string kQueueSignal { "interaction_interact" };
-	const string kInteractStartVerb { "interaction_interact_start" };
-	const string kInteractTickVerb { "interaction_interact_tick" };
-	const string kInteractCompleteVerb { "interaction_interact_complete" };
+	const CHashedString kQueueSignal { "interaction_interact" };
+	const CHashedString kInteractStartVerb { "interaction_interact_start" };
+	const CHashedString kInteractTickVerb { "interaction_interact_tick" };
+	const CHashedString kInteractCompleteVerb { "interaction_interact_complete" };
 
-	const string kInteractAnimationEnterVerb { "interaction_animation_enter" };
-	const string kInteractAnimationFailVerb { "interaction_animation_fail" };
-	const string kInteractAnimationExitVerb { "interaction_animation_exit" };
-	const string kInteractAnimationEventVerb { "interaction_animation_event" };
+	const CHashedString kInteractAnimationEnterVerb { "interaction_animation_enter" };
+	const CHashedString kInteractAnimationFailVerb { "interaction_animation_fail" };
+	const CHashedString kInteractAnimationExitVerb { "interaction_animation_exit" };
+	const CHashedString kInteractAnimationEventVerb { "interaction_animation_event" };
 
 	/** A signal that indicates the user has pressed down the interact key. */
 	struct SInteractStartSignal
@@ -138,9 +139,9 @@ public:
 
 
 	// IInteractionInteract
-	virtual void OnInteractionInteractStart(IInteraction& pInteraction, IActorComponent& actor) override;
-	virtual void OnInteractionInteractTick(IInteraction& pInteraction, IActorComponent& actor) override;
-	virtual void OnInteractionInteractComplete(IInteraction& pInteraction, IActorComponent& actor) override;
+	virtual void OnInteractionInteractStart(const IInteraction& pInteraction, IActorComponent& actor) override;
+	virtual void OnInteractionInteractTick(const IInteraction& pInteraction, IActorComponent& actor) override;
+	virtual void OnInteractionInteractComplete(const IInteraction& pInteraction, IActorComponent& actor) override;
 	// ~IInteractionInteract
 
 	// IAnimationEventListener
@@ -172,7 +173,7 @@ protected:
 	\param	verb		   The DRS verb.
 	\param	isInteractedOn True if this instance is interacted on.
 	**/
-	virtual void InformAllLinkedEntities(string verb, bool isInteractedOn);
+	virtual void InformAllLinkedEntities(const CHashedString& verb, bool isInteractedOn);
 
 	virtual void OnResetState();
 
@@ -182,9 +183,6 @@ protected:
 	/** True if this Interact can only be used once. */
 	bool m_isSingleUseOnly { false };
 
-	/** Keep track of these so we can enable / disable as needed. */
-	CInteractionInteractPtr m_interactPtr { nullptr };
-
 	/** This entity should be interactive. */
 	CEntityInteractionComponent* m_interactor { nullptr };
 
@@ -196,7 +194,10 @@ protected:
 	IActorComponent* m_pInteractionActor { nullptr };
 
 	/** The interaction being run by this component. */
-	IInteraction* m_interaction { nullptr };
+	const IInteraction* m_interaction { nullptr };
+
+	/** Context collections for the DRS signals, reused once the DRS is done with them. */
+	DRSUtility::CContextCollectionPool m_contextPool;
 
 	/** A set of tags which will be added to the fragment when it plays. */
 	TagCollection m_tags;
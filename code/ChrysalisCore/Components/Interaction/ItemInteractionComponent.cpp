@@ -36,10 +36,10 @@ void CItemInteractionComponent::Initialize()
 	m_interactor = GetEntity()->GetOrCreateComponent<CEntityInteractionComponent>();
 	if (m_interactor)
 	{
-		m_interactor->AddInteraction(std::make_shared<CInteractionItemInspect>(this));
-		m_interactor->AddInteraction(std::make_shared<CInteractionItemPickup>(this));
-		m_interactor->AddInteraction(std::make_shared<CInteractionItemDrop>(this, true, true));
-		m_interactor->AddInteraction(std::make_shared<CInteractionItemToss>(this, true, true));
+		m_interactor->AddInteraction<CInteractionItemInspect>(this);
+		m_interactor->AddInteraction<CInteractionItemPickup>(this);
+		m_interactor->AddInteraction<CInteractionItemDrop>(this, true, true);
+		m_interactor->AddInteraction<CInteractionItemToss>(this, true, true);
 	}
 
 	// Reset the entity.
@@ -68,7 +68,7 @@ void CItemInteractionComponent::OnInteractionItemInspect(IActorComponent& actor)
 	}
 
 	CryLogAlways("OnInteractionItemInspect fired.");
-	m_inspectionState = InspectionState::eInspecting;
+	SetInspectionState(InspectionState::eInspecting);
 
 	if (auto pActorComponent = CPlayerComponent::GetLocalActor())
 	{
@@ -97,7 +97,7 @@ void CItemInteractionComponent::OnInteractionItemPickup(IActorComponent& actor)
 	}
 
 	CryLogAlways("OnInteractionItemPickup fired.");
-	m_inspectionState = InspectionState::ePickingUp;
+	SetInspectionState(InspectionState::ePickingUp);
 
 	if (auto pActorComponent = CPlayerComponent::GetLocalActor())
 	{
@@ -118,7 +118,7 @@ void CItemInteractionComponent::OnInteractionItemPickup(IActorComponent& actor)
 void CItemInteractionComponent::OnInteractionItemDrop(IActorComponent& actor)
 {
 	CryLogAlways("OnInteractionItemDrop fired.");
-	m_inspectionState = InspectionState::eDroping;
+	SetInspectionState(InspectionState::eDroping);
 
 	if (auto pActorComponent = CPlayerComponent::GetLocalActor())
 	{
@@ -141,7 +141,7 @@ void CItemInteractionComponent::OnInteractionItemDrop(IActorComponent& actor)
 void CItemInteractionComponent::OnInteractionItemToss(IActorComponent& actor)
 {
 	CryLogAlways("OnInteractionItemToss fired.");
-	m_inspectionState = InspectionState::eTossing;
+	SetInspectionState(InspectionState::eTossing);
 
 	if (auto pActorComponent = CPlayerComponent::GetLocalActor())
 	{
@@ -174,6 +174,16 @@ void CItemInteractionComponent::OnResetState()
 }
 
 
+void CItemInteractionComponent::SetInspectionState(InspectionState inspectionState)
+{
+	const bool wasUpdateRequired = IsUpdateRequired();
+	m_inspectionState = inspectionState;
+
+	if (IsUpdateRequired() != wasUpdateRequired)
+		GetEntity()->UpdateComponentEventMask(this);
+}
+
+
 void CItemInteractionComponent::Update()
 {
 	const float frameTime = gEnv->pTimer->GetFrameTime();
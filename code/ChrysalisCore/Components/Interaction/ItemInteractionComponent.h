@@ -22,7 +22,7 @@ protected:
 
 	// IEntityComponent
 	void Initialize() override;
-	Cry::Entity::EntityEventMask GetEventMask() const override { return EventToMask(EEntityEvent::Update); }
+	Cry::Entity::EntityEventMask GetEventMask() const override { return IsUpdateRequired() ? EventToMask(EEntityEvent::Update) : Cry::Entity::EntityEventMask(); }
 	void ProcessEvent(const SEntityEvent& event) override;
 	// ~IEntityComponent
 
@@ -79,6 +79,11 @@ protected:
 	virtual void OnResetState();
 	void Update();
 
+	/** Changes the inspection state, subscribing to updates only while the item is being inspected or picked up. */
+	void SetInspectionState(InspectionState inspectionState);
+
+	bool IsUpdateRequired() const { return (m_inspectionState == InspectionState::eInspecting) || (m_inspectionState == InspectionState::ePickingUp); }
+
 	void OnPickingUpUpdate(const float frameTime);
 
 	void OnInspectingUpdate(const float frameTime);
@@ -20,7 +20,7 @@ protected:
 	// IEntityComponent
 	void Initialize() override;
 	void ProcessEvent(const SEntityEvent& event) override;
-	Cry::Entity::EntityEventMask GetEventMask() const override { return ENTITY_EVENT_BIT(ENTITY_EVENT_UPDATE) | ENTITY_EVENT_BIT(ENTITY_EVENT_PREPHYSICSUPDATE); }
+	Cry::Entity::EntityEventMask GetEventMask() const override { return EventToMask(EEntityEvent::LevelStarted) | EventToMask(EEntityEvent::Reset) | EventToMask(EEntityEvent::EditorPropertyChanged) | EventToMask(EEntityEvent::TransformChangeFinishedInEditor); }
 	// ~IEntityComponent
 
 public:
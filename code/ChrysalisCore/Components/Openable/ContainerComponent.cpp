@@ -43,10 +43,10 @@ void CContainerComponent::Initialize()
 	m_interactor = m_pEntity->GetOrCreateComponent<CEntityInteractionComponent>();
 	if (m_interactor)
 	{
-		m_interactor->AddInteraction(std::make_shared<CInteractionOpenableOpen>(this));
-		m_interactor->AddInteraction(std::make_shared<CInteractionOpenableClose>(this));
-		m_interactor->AddInteraction(std::make_shared<CInteractionLockableLock>(this));
-		m_interactor->AddInteraction(std::make_shared<CInteractionLockableUnlock>(this));
+		m_interactor->AddInteraction<CInteractionOpenableOpen>(this);
+		m_interactor->AddInteraction<CInteractionOpenableClose>(this);
+		m_interactor->AddInteraction<CInteractionLockableLock>(this);
+		m_interactor->AddInteraction<CInteractionLockableUnlock>(this);
 	}
 
 	OnResetState();
@@ -3,7 +3,6 @@
 #include "ActionRPGCameraComponent.h"
 #include "Components/Player/PlayerComponent.h"
 #include <Components/Player/Input/PlayerInputComponent.h>
-#include <Utility/StringConversions.h>
 #include <Console/CVars.h>
 #include <Actor/ActorComponent.h>
 #include <CryGame/GameUtils.h>
@@ -211,7 +210,7 @@ void CActionRPGCameraComponent::UpdateThirdPerson()
 
 				// Work out where to place the new initial position. We will be using a unit vector facing forward Y
 				// as the starting place and applying rotations from the target bone and player camera movements.
-				Vec3 viewPositionOffset = Vec3FromString(g_cvars.m_actionRPGCameraViewPositionOffset->GetString());
+				const Vec3& viewPositionOffset = g_cvars.m_actionRPGCameraViewPositionOffset.Get();
 				Vec3 vecViewPosition = vecTargetAimPosition + (quatTargetRotation * (FORWARD_DIRECTION * zoomDistance)) + quatTargetRotation * viewPositionOffset;
 
 				// By default, we try and aim the camera at the target, taking into account the current mouse yaw and pitch values.
@@ -233,7 +232,7 @@ void CActionRPGCameraComponent::UpdateThirdPerson()
 				}
 
 				// Apply a final translation to both the view position and the aim position.
-				Vec3 aimPositionOffset = Vec3FromString(g_cvars.m_actionRPGCameraAimPositionOffset->GetString());
+				const Vec3& aimPositionOffset = g_cvars.m_actionRPGCameraAimPositionOffset.Get();
 				vecViewPosition += quatViewRotation * aimPositionOffset;
 
 				// Gimbal style rotation after it's moved into it's initial position.
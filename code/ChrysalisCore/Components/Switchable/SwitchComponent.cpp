@@ -42,27 +42,25 @@ void CSwitchComponent::Initialize()
 	m_interactor = GetEntity()->GetOrCreateComponent<CEntityInteractionComponent>();
 	if (m_interactor)
 	{
-		m_switchTogglePtr = std::make_shared<CInteractionSwitchToggle>(this);
-		m_interactor->AddInteraction(m_switchTogglePtr);
-
-		m_switchOnPtr = std::make_shared<CInteractionSwitchOn>(this);
-		m_interactor->AddInteraction(m_switchOnPtr);
-
-		m_switchOffPtr = std::make_shared<CInteractionSwitchOff>(this);
-		m_interactor->AddInteraction(m_switchOffPtr);
+		m_interactor->AddInteraction<CInteractionSwitchToggle>(this);
+		m_interactor->AddInteraction<CInteractionSwitchOn>(this);
+		m_interactor->AddInteraction<CInteractionSwitchOff>(this);
 	}
 }
 
 
 void CSwitchComponent::OnResetState()
 {
-	m_switchTogglePtr->SetEnabled(m_isEnabled);
-	m_switchOnPtr->SetEnabled(m_isEnabled);
-	m_switchOffPtr->SetEnabled(m_isEnabled);
+	if (m_interactor)
+	{
+		m_interactor->SetInteractionEnabled("interaction_switch_toggle", m_isEnabled);
+		m_interactor->SetInteractionEnabled("interaction_switch_on", m_isEnabled);
+		m_interactor->SetInteractionEnabled("interaction_switch_off", m_isEnabled);
+	}
 }
 
 
-void CSwitchComponent::OnInteractionSwitchToggle(IInteraction& pInteraction, IActorComponent& actor)
+void CSwitchComponent::OnInteractionSwitchToggle(const IInteraction& pInteraction, IActorComponent& actor)
 {
 	CInteractComponent::OnInteractionInteractStart(pInteraction, actor);
 	
@@ -84,7 +82,7 @@ void CSwitchComponent::OnInteractionSwitchToggle(IInteraction& pInteraction, IAc
 }
 
 
-void CSwitchComponent::OnInteractionSwitchOn(IInteraction& pInteraction, IActorComponent& actor)
+void CSwitchComponent::OnInteractionSwitchOn(const IInteraction& pInteraction, IActorComponent& actor)
 {
 	if (m_isEnabled)
 	{
@@ -103,7 +101,7 @@ void CSwitchComponent::OnInteractionSwitchOn(IInteraction& pInteraction, IActorC
 }
 
 
-void CSwitchComponent::OnInteractionSwitchOff(IInteraction& pInteraction, IActorComponent& actor)
+void CSwitchComponent::OnInteractionSwitchOff(const IInteraction& pInteraction, IActorComponent& actor)
 {
 	if (m_isEnabled)
 	{
@@ -124,8 +122,14 @@ void CSwitchComponent::OnInteractionSwitchOff(IInteraction& pInteraction, IActor
 
 // TODO: FIX: Simplify this so it doesn't all need to be replicated in derived classes such as this one.
 
-void CSwitchComponent::InformAllLinkedEntities(string verb, bool isSwitchedOn)
+void CSwitchComponent::InformAllLinkedEntities(const CHashedString& verb, bool isSwitchedOn)
 {
+	static const CHashedString verbName { "Verb" };
+	static const CHashedString isSwitchedOnName { "IsSwitchedOn" };
+
+	// The same signal goes to every linked entity, so only hash it once.
+	const CHashedString queueSignalVerb = m_queueSignal.empty() ? kQueueSignal : CHashedString(m_queueSignal.c_str());
+
 	// Notify every linked entity.
 	auto* entityLinks = GetEntity()->GetEntityLinks();
 	while (entityLinks)
@@ -133,17 +137,16 @@ void CSwitchComponent::InformAllLinkedEntities(string verb, bool isSwitchedOn)
 		auto pTargetEntity = gEnv->pEntitySystem->GetEntity(entityLinks->entityId);
 		auto pDrsProxy = crycomponent_cast<IEntityDynamicResponseComponent*> (pTargetEntity->CreateProxy(ENTITY_PROXY_DYNAMICRESPONSE));
 
-		// Create a context variable collection and populate it based on information from the target entity.
-		DRS::IVariableCollectionSharedPtr pContextVariableCollection = gEnv->pDynamicResponseSystem->CreateContextCollection();
+		// Grab a context variable collection and populate it based on information from the target entity.
+		DRS::IVariableCollectionSharedPtr pContextVariableCollection = m_contextPool.Acquire();
 
 		// It might be useful to know which verb triggered the interaction.
-		pContextVariableCollection->CreateVariable("Verb", CHashedString(verb));
+		pContextVariableCollection->SetVariableValue(verbName, verb);
 
 		// The switch value is always set, regardless of which verb was triggered.
-		pContextVariableCollection->CreateVariable("IsSwitchedOn", isSwitchedOn);
+		pContextVariableCollection->SetVariableValue(isSwitchedOnName, isSwitchedOn);
 
 		// Queue it and let the DRS handle it now.
-		const string queueSignalVerb = m_queueSignal.empty() ? kQueueSignal : m_queueSignal.c_str();
 		pDrsProxy->GetResponseActor()->QueueSignal(queueSignalVerb, pContextVariableCollection);
 
 		// Next please.
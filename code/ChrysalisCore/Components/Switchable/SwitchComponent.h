@@ -30,9 +30,9 @@ public:
 		return id;
 	}
 
-	const string kQueueSignal { "interaction_switch" };
-	const string kSwitchOnVerb { "interaction_switch_on" };
-	const string kSwitchOffVerb { "interaction_switch_off" };
+	const CHashedString kQueueSignal { "interaction_switch" };
+	const CHashedString kSwitchOnVerb { "interaction_switch_on" };
+	const CHashedString kSwitchOffVerb { "interaction_switch_off" };
 
 
 	struct SSwitchOnSignal
@@ -54,26 +54,21 @@ public:
 
 
 	// IInteractionSwitch
-	virtual void OnInteractionSwitchToggle(IInteraction& pInteraction, IActorComponent& actor) override;
-	virtual void OnInteractionSwitchOn(IInteraction& pInteraction, IActorComponent& actor) override;
-	virtual void OnInteractionSwitchOff(IInteraction& pInteraction, IActorComponent& actor) override;
+	virtual void OnInteractionSwitchToggle(const IInteraction& pInteraction, IActorComponent& actor) override;
+	virtual void OnInteractionSwitchOn(const IInteraction& pInteraction, IActorComponent& actor) override;
+	virtual void OnInteractionSwitchOff(const IInteraction& pInteraction, IActorComponent& actor) override;
 	// ~IInteractionSwitch
 
 protected:
 	/** Sends the Schematyc switch toggle signal. */
 	virtual void ProcessSchematycSignalStart() override { GetEntity()->GetSchematycObject()->ProcessSignal(SSwitchToggleSignal(), GetGUID()); };
 
-	void InformAllLinkedEntities(string verb, bool isSwitchedOn) override;
+	void InformAllLinkedEntities(const CHashedString& verb, bool isSwitchedOn) override;
 
 	virtual void OnResetState() override;
 
 	/** Indicates if the switch is in the 'on' position. */
 	bool m_isSwitchedOn { false };
-
-	/** Keep track of these so we can enable / disable as needed. */
-	CInteractionSwitchTogglePtr m_switchTogglePtr { nullptr };
-	CInteractionSwitchOnPtr m_switchOnPtr { nullptr };
-	CInteractionSwitchOffPtr m_switchOffPtr { nullptr };
 };
 
 
@@ -0,0 +1,309 @@
+#include <StdAfx.h>
+
+#include "NeedleSystem.h"
+#include <Cry3DEngine/ITimeOfDay.h>
+#include <Console/CVars.h>
+#include <limits>
+
+#if CRY_PLATFORM_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace Chrysalis
+{
+/** The number of needles worked on at a time. */
+static const size_t NeedleBatchSize = 4;
+
+/** Owners which haven't been drawn in this many frames are treated as out of view. */
+static const int MaxFramesSinceDrawn = 2;
+
+
+static ICharacterInstance* GetSlotCharacter(IEntity* pEntity, int slotId)
+{
+	return (pEntity && (slotId >= 0)) ? pEntity->GetCharacter(slotId) : nullptr;
+}
+
+
+static int32 GetAttachmentCount(ICharacterInstance* pCharacter)
+{
+	IAttachmentManager* pAttachmentManager = pCharacter ? pCharacter->GetIAttachmentManager() : nullptr;
+
+	return pAttachmentManager ? pAttachmentManager->GetAttachmentCount() : -1;
+}
+
+
+CNeedleSystem::TOwnerId CNeedleSystem::Register(INeedleOwner* pOwner)
+{
+	CRY_ASSERT(pOwner);
+
+	TOwnerId ownerId;
+	if (!m_freeOwnerIds.empty())
+	{
+		ownerId = m_freeOwnerIds.back();
+		m_freeOwnerIds.pop_back();
+	}
+	else
+	{
+		ownerId = static_cast<TOwnerId>(m_owners.size());
+		m_owners.emplace_back();
+	}
+
+	m_owners [ownerId] = SOwner();
+	m_owners [ownerId].pOwner = pOwner;
+	m_isRebuildNeeded = true;
+
+	return ownerId;
+}
+
+
+void CNeedleSystem::Unregister(TOwnerId ownerId)
+{
+	CRY_ASSERT_MESSAGE((ownerId < m_owners.size()) && m_owners [ownerId].pOwner, "The needle owner isn't registered.");
+
+	m_owners [ownerId] = SOwner();
+	m_freeOwnerIds.push_back(ownerId);
+	m_isRebuildNeeded = true;
+}
+
+
+void CNeedleSystem::SetInputs(TOwnerId ownerId, const Vec3& inputs)
+{
+	CRY_ASSERT_MESSAGE((ownerId < m_owners.size()) && m_owners [ownerId].pOwner, "The needle owner isn't registered.");
+
+	m_owners [ownerId].inputs = inputs;
+}
+
+
+void CNeedleSystem::SetFollowTimeOfDay(TOwnerId ownerId, bool followTimeOfDay)
+{
+	CRY_ASSERT_MESSAGE((ownerId < m_owners.size()) && m_owners [ownerId].pOwner, "The needle owner isn't registered.");
+
+	m_owners [ownerId].followTimeOfDay = followTimeOfDay;
+}
+
+
+void CNeedleSystem::RebuildNeedles(TOwnerId ownerId)
+{
+	CRY_ASSERT_MESSAGE((ownerId < m_owners.size()) && m_owners [ownerId].pOwner, "The needle owner isn't registered.");
+
+	m_isRebuildNeeded = true;
+}
+
+
+void CNeedleSystem::Update()
+{
+	// The attachments held from the last rebuild may no longer exist, so this must come before anything else.
+	if (m_isRebuildNeeded || IsAnyCharacterChanged())
+		Rebuild();
+
+	const size_t count = m_needles.size();
+	if ((count == 0) || !gEnv->pRenderer)
+		return;
+
+	UpdateVisibility();
+
+	// Every clock which follows the time of day shares a single read of it.
+	Vec3 timeOfDay { 0.0f, 0.0f, 0.0f };
+	if (ITimeOfDay* pTimeOfDay = gEnv->p3DEngine->GetTimeOfDay())
+	{
+		const float hours = pTimeOfDay->GetTime();
+		timeOfDay = Vec3(floorf(hours), (hours - floorf(hours)) * 60.0f, fmodf(hours * 3600.0f, 60.0f));
+	}
+
+	// Copy each owner's inputs alongside its needles, so the angles can be worked out in a straight run.
+	float* pInputHours = GetStream(eS_InputHours);
+	float* pInputMinutes = GetStream(eS_InputMinutes);
+	float* pInputSeconds = GetStream(eS_InputSeconds);
+	for (size_t i = 0; i < count; ++i)
+	{
+		const SOwner& owner = m_owners [m_needles [i].ownerId];
+		const Vec3& inputs = owner.followTimeOfDay ? timeOfDay : owner.inputs;
+		pInputHours [i] = inputs.x;
+		pInputMinutes [i] = inputs.y;
+		pInputSeconds [i] = inputs.z;
+	}
+
+	UpdateAngles(count);
+
+	// Only the needles which moved and can be seen are pushed. Those out of view keep their last angle, so they are
+	// pushed as soon as they come back into view.
+	for (size_t word = 0; word < m_changed.size(); ++word)
+	{
+		size_t index = word << 5;
+		for (uint32 bits = m_changed [word]; bits != 0; bits >>= 1, ++index)
+		{
+			if ((bits & 1) && m_isOwnerVisible [m_needles [index].ownerId])
+				PushNeedle(index, m_angles [index]);
+		}
+	}
+}
+
+
+void CNeedleSystem::GetMemoryUsage(ICrySizer* s) const
+{
+	s->AddContainer(m_owners);
+	s->AddContainer(m_freeOwnerIds);
+	s->AddContainer(m_needles);
+	s->AddContainer(m_data);
+	s->AddContainer(m_angles);
+	s->AddContainer(m_changed);
+	s->AddContainer(m_isOwnerVisible);
+}
+
+
+void CNeedleSystem::Rebuild()
+{
+	m_isRebuildNeeded = false;
+	m_needles.clear();
+
+	std::vector<SNeedleBinding> bindings;
+	std::vector<Vec3> weights;
+
+	for (TOwnerId ownerId = 0; ownerId < m_owners.size(); ++ownerId)
+	{
+		SOwner& owner = m_owners [ownerId];
+		if (!owner.pOwner)
+			continue;
+
+		bindings.clear();
+		owner.slotId = -1;
+		owner.pEntity = owner.pOwner->GetNeedles(bindings, owner.slotId);
+		owner.pCharacter = GetSlotCharacter(owner.pEntity, owner.slotId);
+		owner.attachmentCount = GetAttachmentCount(owner.pCharacter);
+
+		for (const auto& binding : bindings)
+		{
+			// Characters without the attachment simply don't have that needle.
+			if (binding.pAttachment)
+			{
+				m_needles.push_back({ binding.pAttachment, binding.axis, ownerId });
+				weights.push_back(binding.degreesPerInput);
+			}
+		}
+	}
+
+	const size_t count = m_needles.size();
+	m_stride = (count + NeedleBatchSize - 1) & ~(NeedleBatchSize - 1);
+
+	// The padding at the end of the final batch has no weight and an angle of zero, so it never shows as changed.
+	m_data.assign(m_stride * eS_COUNT, 0.0f);
+	m_angles.assign(m_stride, 0.0f);
+	m_changed.assign((m_stride + 31) >> 5, 0);
+	m_isOwnerVisible.assign(m_owners.size(), 0);
+
+	float* pWeightHours = GetStream(eS_WeightHours);
+	float* pWeightMinutes = GetStream(eS_WeightMinutes);
+	float* pWeightSeconds = GetStream(eS_WeightSeconds);
+	float* pLastAngle = GetStream(eS_LastAngle);
+	for (size_t i = 0; i < count; ++i)
+	{
+		pWeightHours [i] = weights [i].x;
+		pWeightMinutes [i] = weights [i].y;
+		pWeightSeconds [i] = weights [i].z;
+
+		// Not a number never compares equal, so every needle is pushed once after a rebuild.
+		pLastAngle [i] = std::numeric_limits<float>::quiet_NaN();
+	}
+}
+
+
+bool CNeedleSystem::IsAnyCharacterChanged() const
+{
+	for (const auto& owner : m_owners)
+	{
+		if (!owner.pOwner)
+			continue;
+
+		ICharacterInstance* pCharacter = GetSlotCharacter(owner.pEntity, owner.slotId);
+		if ((pCharacter != owner.pCharacter.get()) || (GetAttachmentCount(pCharacter) != owner.attachmentCount))
+			return true;
+	}
+
+	return false;
+}
+
+
+void CNeedleSystem::UpdateVisibility()
+{
+	const Vec3 cameraPosition = gEnv->pSystem->GetViewCamera().GetPosition();
+	const float maxDistanceSqr = sqr(g_cvars.m_needleMaxDistance);
+	const int frameId = gEnv->pRenderer->GetFrameID(false);
+
+	for (size_t ownerId = 0; ownerId < m_owners.size(); ++ownerId)
+	{
+		const SOwner& owner = m_owners [ownerId];
+		bool isVisible = false;
+
+		if (owner.pEntity && !owner.pEntity->IsHidden() && !owner.pEntity->IsInvisible()
+			&& (owner.pEntity->GetWorldPos().GetSquaredDistance(cameraPosition) <= maxDistanceSqr))
+		{
+			const IRenderNode* pRenderNode = (owner.slotId >= 0) ? owner.pEntity->GetSlotRenderNode(owner.slotId) : nullptr;
+			isVisible = !pRenderNode || (frameId - pRenderNode->GetDrawFrame() <= MaxFramesSinceDrawn);
+		}
+
+		m_isOwnerVisible [ownerId] = isVisible ? 1 : 0;
+	}
+}
+
+
+#if CRY_PLATFORM_SSE2
+void CNeedleSystem::UpdateAngles(size_t count)
+{
+	const float* pWeightHours = GetStream(eS_WeightHours);
+	const float* pWeightMinutes = GetStream(eS_WeightMinutes);
+	const float* pWeightSeconds = GetStream(eS_WeightSeconds);
+	const float* pInputHours = GetStream(eS_InputHours);
+	const float* pInputMinutes = GetStream(eS_InputMinutes);
+	const float* pInputSeconds = GetStream(eS_InputSeconds);
+	const float* pLastAngle = GetStream(eS_LastAngle);
+
+	std::fill(m_changed.begin(), m_changed.end(), 0);
+
+	for (size_t i = 0; i < count; i += NeedleBatchSize)
+	{
+		const __m128 angle = _mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(_mm_loadu_ps(pWeightHours + i), _mm_loadu_ps(pInputHours + i)),
+			_mm_mul_ps(_mm_loadu_ps(pWeightMinutes + i), _mm_loadu_ps(pInputMinutes + i))),
+			_mm_mul_ps(_mm_loadu_ps(pWeightSeconds + i), _mm_loadu_ps(pInputSeconds + i)));
+
+		_mm_storeu_ps(&m_angles [i], angle);
+		m_changed [i >> 5] |= static_cast<uint32>(_mm_movemask_ps(_mm_cmpneq_ps(angle, _mm_loadu_ps(pLastAngle + i)))) << (i & 31);
+	}
+}
+#else
+void CNeedleSystem::UpdateAngles(size_t count)
+{
+	const float* pWeightHours = GetStream(eS_WeightHours);
+	const float* pWeightMinutes = GetStream(eS_WeightMinutes);
+	const float* pWeightSeconds = GetStream(eS_WeightSeconds);
+	const float* pInputHours = GetStream(eS_InputHours);
+	const float* pInputMinutes = GetStream(eS_InputMinutes);
+	const float* pInputSeconds = GetStream(eS_InputSeconds);
+	const float* pLastAngle = GetStream(eS_LastAngle);
+
+	std::fill(m_changed.begin(), m_changed.end(), 0);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const float angle = pWeightHours [i] * pInputHours [i] + pWeightMinutes [i] * pInputMinutes [i] + pWeightSeconds [i] * pInputSeconds [i];
+
+		m_angles [i] = angle;
+		if (angle != pLastAngle [i])
+			m_changed [i >> 5] |= 1u << (i & 31);
+	}
+}
+#endif
+
+
+void CNeedleSystem::PushNeedle(size_t index, float angle)
+{
+	const SNeedle& needle = m_needles [index];
+
+	QuatT trans = needle.pAttachment->GetAttAbsoluteDefault();
+	trans.q = Quat::CreateRotationXYZ(needle.axis * DEG2RAD(angle));
+	needle.pAttachment->SetAttAbsoluteDefault(trans);
+
+	GetStream(eS_LastAngle) [index] = angle;
+}
+}
@@ -0,0 +1,192 @@
+/**
+\file	Components\TimePiece\NeedleSystem.h
+
+Poses the needles of every time piece and gauge in a single pass each frame. The owners register with the system and
+push their values to it when they change, rather than each ticking on its own.
+
+A needle's angle is a weighted sum of its owner's three input values. For a clock these are the hour, minute and
+second, for a gauge just its value. The angles are worked out four at a time using SSE into a structure-of-arrays
+copy of the needles, and only the needles whose angle has changed since it was last pushed have their attachment
+transform set. The system checks each frame that every owner's slot still holds the character its needles were
+fetched from, and fetches them again if not. Owners which are hidden, haven't been drawn recently or are further from the camera than
+needle_max_distance are skipped, and catch up when they come back into view.
+
+Clocks can follow the time of day instead of their own values, in which case they all read it once per frame.
+**/
+#pragma once
+
+
+namespace Chrysalis
+{
+/** A needle to be posed by the system. */
+struct SNeedleBinding
+{
+	/** The attachment which is rotated. */
+	IAttachment* pAttachment { nullptr };
+
+	/** The axis the needle turns around. */
+	Vec3 axis { 0.0f, 1.0f, 0.0f };
+
+	/** The number of degrees the needle turns for each unit of the owner's three inputs. */
+	Vec3 degreesPerInput { 0.0f, 0.0f, 0.0f };
+};
+
+
+/** Implemented by anything which has needles for the system to pose. */
+struct INeedleOwner
+{
+	virtual ~INeedleOwner() = default;
+
+
+	/**
+	Gets the owner's needles. Called whenever the system rebuilds its needle arrays after RebuildNeedles.
+
+	\param [in,out]	needles	The needles, to be added to.
+	\param [out]	slotId 	The entity slot holding the character, used to tell if it has been drawn recently.
+
+	\return	The entity the needles belong to.
+	**/
+	virtual IEntity* GetNeedles(std::vector<SNeedleBinding>& needles, int& slotId) = 0;
+};
+
+
+class CNeedleSystem
+{
+public:
+	/** A handle to a registered owner. */
+	typedef uint32 TOwnerId;
+
+	/** Magic number to signify an owner which isn't registered. */
+	static const TOwnerId InvalidOwnerId = ~0u;
+
+
+	/**
+	Adds an owner. Its needles are fetched at the start of the next update.
+
+	\param [in]	pOwner	The owner, which must be unregistered before it is destroyed.
+
+	\return	A handle to the owner.
+	**/
+	TOwnerId Register(INeedleOwner* pOwner);
+
+
+	/**
+	Removes an owner.
+
+	\param	ownerId	The handle returned when the owner was registered.
+	**/
+	void Unregister(TOwnerId ownerId);
+
+
+	/**
+	Sets the values which drive an owner's needles.
+
+	\param	ownerId	The handle returned when the owner was registered.
+	\param	inputs 	The values.
+	**/
+	void SetInputs(TOwnerId ownerId, const Vec3& inputs);
+
+
+	/**
+	Sets whether an owner takes its inputs from the time of day, as hours, minutes and seconds, rather than from SetInputs.
+
+	\param	ownerId			The handle returned when the owner was registered.
+	\param	followTimeOfDay	True to follow the time of day.
+	**/
+	void SetFollowTimeOfDay(TOwnerId ownerId, bool followTimeOfDay);
+
+
+	/**
+	Asks for an owner's needles to be fetched again. Changes to the character in the owner's slot, or to its number of
+	attachments, are picked up without this, but anything else which moves the needles needs it.
+
+	\param	ownerId	The handle returned when the owner was registered.
+	**/
+	void RebuildNeedles(TOwnerId ownerId);
+
+
+	/** Called once per frame. Works out the needle angles and pushes the ones which have changed. */
+	void Update();
+
+
+	/** Gets the number of needles. */
+	size_t GetNeedleCount() const { return m_needles.size(); }
+
+	void GetMemoryUsage(ICrySizer* s) const;
+
+private:
+	struct SOwner
+	{
+		INeedleOwner* pOwner { nullptr };
+		IEntity* pEntity { nullptr };
+		int slotId { -1 };
+
+		// The character in the slot when the needles were fetched, and its attachment count. Holding the character
+		// keeps the needle attachments alive until the next rebuild, even if it's taken out of the slot.
+		_smart_ptr<ICharacterInstance> pCharacter;
+		int32 attachmentCount { -1 };
+
+		Vec3 inputs { 0.0f, 0.0f, 0.0f };
+		bool followTimeOfDay { false };
+	};
+
+	struct SNeedle
+	{
+		IAttachment* pAttachment;
+		Vec3 axis;
+		TOwnerId ownerId;
+	};
+
+	// Each stream is a run of m_stride floats in m_data.
+	enum EStream
+	{
+		eS_WeightHours,
+		eS_WeightMinutes,
+		eS_WeightSeconds,
+		eS_InputHours,
+		eS_InputMinutes,
+		eS_InputSeconds,
+		eS_LastAngle,
+
+		eS_COUNT
+	};
+
+	float* GetStream(EStream stream) { return m_data.data() + stream * m_stride; }
+
+	/** Fetches the needles from every owner and lays them out in the streams. */
+	void Rebuild();
+
+	/** True if any owner's slot holds a different character, or one with a different number of attachments, than when its needles were fetched. */
+	bool IsAnyCharacterChanged() const;
+
+	/** Works out which owners are worth posing this frame. */
+	void UpdateVisibility();
+
+	/** Works out the needle angles, and sets a bit in m_changed for each one which is different to its last angle. */
+	void UpdateAngles(size_t count);
+
+	/** Sets the transform of a needle and remembers its angle. */
+	void PushNeedle(size_t index, float angle);
+
+	std::vector<SOwner> m_owners;
+	std::vector<TOwnerId> m_freeOwnerIds;
+
+	std::vector<SNeedle> m_needles;
+
+	// The count rounded up to the batch size.
+	size_t m_stride { 0 };
+
+	std::vector<float> m_data;
+
+	// The angles worked out this frame, one for each needle.
+	std::vector<float> m_angles;
+
+	// One bit per needle, for the needles whose angle has changed.
+	std::vector<uint32> m_changed;
+
+	// One flag per owner, true if its needles should be posed this frame.
+	std::vector<uint8> m_isOwnerVisible;
+
+	bool m_isRebuildNeeded { false };
+};
+}
@@ -1,6 +1,7 @@
 #include <StdAfx.h>
 
 #include "TimePieceComponent.h"
+#include <Plugin/ChrysalisCorePlugin.h>
 
 
 namespace Chrysalis
@@ -60,11 +61,32 @@ void CTimePieceComponent::ReflectType(Schematyc::CTypeDesc<CTimePieceComponent>&
 
 void CTimePieceComponent::Initialize()
 {
+	m_hoursBinding = m_characterBindings.AddAttachment("hours");
+	m_minutesBinding = m_characterBindings.AddAttachment("minutes");
+	m_secondsBinding = m_characterBindings.AddAttachment("seconds");
+
+	if (auto pNeedleSystem = CChrysalisCorePlugin::Get()->GetNeedleSystem())
+		m_needleOwnerId = pNeedleSystem->Register(this);
+
 	LoadFromDisk();
 	ResetObject();
 }
 
 
+void CTimePieceComponent::OnShutDown()
+{
+	if (m_needleOwnerId != CNeedleSystem::InvalidOwnerId)
+	{
+		if (auto pNeedleSystem = CChrysalisCorePlugin::Get()->GetNeedleSystem())
+			pNeedleSystem->Unregister(m_needleOwnerId);
+
+		m_needleOwnerId = CNeedleSystem::InvalidOwnerId;
+	}
+
+	CBaseMeshComponent::OnShutDown();
+}
+
+
 void CTimePieceComponent::ProcessEvent(const SEntityEvent& event)
 {
 	switch (event.event)
@@ -76,13 +98,6 @@ void CTimePieceComponent::ProcessEvent(const SEntityEvent& event)
 			ResetObject();
 		}
 		break;
-
-		case EEntityEvent::Update:
-		{
-			SEntityUpdateContext* pCtx = (SEntityUpdateContext*)event.nParam [0];
-			Update(pCtx);
-		}
-		break;
 	}
 
 	CBaseMeshComponent::ProcessEvent(event);
@@ -99,6 +114,15 @@ void CTimePieceComponent::LoadFromDisk()
 	{
 		m_pCachedCharacter = nullptr;
 	}
+
+	m_characterBindings.Invalidate();
+
+	// The hands need binding to the new character.
+	if (m_needleOwnerId != CNeedleSystem::InvalidOwnerId)
+	{
+		if (auto pNeedleSystem = CChrysalisCorePlugin::Get()->GetNeedleSystem())
+			pNeedleSystem->RebuildNeedles(m_needleOwnerId);
+	}
 }
 
 
@@ -111,47 +135,48 @@ void CTimePieceComponent::ResetObject()
 	}
 
 	m_pEntity->SetCharacter(m_pCachedCharacter, GetOrMakeEntitySlotId() | ENTITY_SLOT_ACTUAL, false);
+	PushTime();
+}
+
+
+IEntity* CTimePieceComponent::GetNeedles(std::vector<SNeedleBinding>& needles, int& slotId)
+{
+	slotId = GetEntitySlotId();
+
+	// Bind to whatever is in the slot, which the needle system checks against each frame.
+	if (ICharacterInstance* pCharacter = (slotId >= 0) ? m_pEntity->GetCharacter(slotId) : nullptr)
+	{
+		m_characterBindings.Refresh(pCharacter);
+
+		// The hour hand creeps forward with the minutes, half a degree for each.
+		SNeedleBinding needle;
+		needle.axis = m_timePieceProperties.axis;
+
+		needle.pAttachment = m_characterBindings.GetAttachment(m_hoursBinding);
+		needle.degreesPerInput = Vec3(30.0f, 0.5f, 0.0f);
+		needles.push_back(needle);
+
+		needle.pAttachment = m_characterBindings.GetAttachment(m_minutesBinding);
+		needle.degreesPerInput = Vec3(0.0f, 6.0f, 0.0f);
+		needles.push_back(needle);
+
+		needle.pAttachment = m_characterBindings.GetAttachment(m_secondsBinding);
+		needle.degreesPerInput = Vec3(0.0f, 0.0f, 6.0f);
+		needles.push_back(needle);
+	}
+
+	return GetEntity();
 }
 
 
-void CTimePieceComponent::Update(SEntityUpdateContext* pCtx)
+void CTimePieceComponent::PushTime()
 {
-	if (m_pCachedCharacter)
+	if (m_needleOwnerId != CNeedleSystem::InvalidOwnerId)
 	{
-		// If we can access the attachments, we can try and find the rotation for each hand.
-		const IAttachmentManager* pAttachmentManager = m_pCachedCharacter->GetIAttachmentManager();
-		if (pAttachmentManager)
+		if (auto pNeedleSystem = CChrysalisCorePlugin::Get()->GetNeedleSystem())
 		{
-			// Can we find the hours hand?
-			const auto hoursIndex = pAttachmentManager->GetIndexByName("hours");
-			if (IAttachment* pHoursAttachment = pAttachmentManager->GetInterfaceByIndex(hoursIndex))
-			{
-				QuatT trans = pHoursAttachment->GetAttAbsoluteDefault();
-				const float radians = DEG2RAD(m_timePieceProperties.hour * 30.0f + m_timePieceProperties.minute / 2.0f);
-				trans.q = Quat::CreateRotationXYZ(m_timePieceProperties.axis * radians);
-				pHoursAttachment->SetAttAbsoluteDefault(trans);
-			}
-
-			// Can we find the minutes hand?
-			const auto minutesIndex = pAttachmentManager->GetIndexByName("minutes");
-			if (IAttachment* pMinutesAttachment = pAttachmentManager->GetInterfaceByIndex(minutesIndex))
-			{
-				QuatT trans = pMinutesAttachment->GetAttAbsoluteDefault();
-				const float radians = DEG2RAD(m_timePieceProperties.minute * 6.0f);
-				trans.q = Quat::CreateRotationXYZ(m_timePieceProperties.axis * radians);
-				pMinutesAttachment->SetAttAbsoluteDefault(trans);
-			}
-
-			// Can we find the seconds hand?
-			const auto secondsIndex = pAttachmentManager->GetIndexByName("seconds");
-			IAttachment* pSecondsAttachment = pAttachmentManager->GetInterfaceByIndex(secondsIndex);
-			if (IAttachment* pSecondsAttachment = pAttachmentManager->GetInterfaceByIndex(secondsIndex))
-			{
-				QuatT trans = pSecondsAttachment->GetAttAbsoluteDefault();
-				const float radians = DEG2RAD(m_timePieceProperties.second * 6.0f);
-				trans.q = Quat::CreateRotationXYZ(m_timePieceProperties.axis * radians);
-				pSecondsAttachment->SetAttAbsoluteDefault(trans);
-			}
+			pNeedleSystem->SetInputs(m_needleOwnerId, Vec3(m_timePieceProperties.hour, m_timePieceProperties.minute, m_timePieceProperties.second));
+			pNeedleSystem->SetFollowTimeOfDay(m_needleOwnerId, m_timePieceProperties.followTimeOfDay);
 		}
 	}
 }
@@ -2,6 +2,8 @@
 
 #include "Entities/Interaction/IEntityInteraction.h"
 #include <DefaultComponents/Geometry/BaseMeshComponent.h>
+#include <Utility/CharacterBindings.h>
+#include "NeedleSystem.h"
 
 
 namespace Chrysalis
@@ -12,6 +14,7 @@ A TimePiece extension.
 **/
 class CTimePieceComponent
 	: public Cry::DefaultComponents::CBaseMeshComponent
+	, public INeedleOwner
 {
 protected:
 	friend CChrysalisCorePlugin;
@@ -19,10 +22,14 @@ protected:
 
 	// IEntityComponent
 	void Initialize() override;
+	void OnShutDown() override;
 	void ProcessEvent(const SEntityEvent& event) override;
-	Cry::Entity::EntityEventMask GetEventMask() const override { return Cry::DefaultComponents::CBaseMeshComponent::GetEventMask() | EntityEventMask(EEntityEvent::Update); }
 	// ~IEntityComponent
 
+	// INeedleOwner
+	IEntity* GetNeedles(std::vector<SNeedleBinding>& needles, int& slotId) override;
+	// ~INeedleOwner
+
 	// IEditorEntityComponent
 	//virtual bool SetMaterial(int slotId, const char* szMaterial) override;
 	// ~IEditorEntityComponent
@@ -41,16 +48,19 @@ public:
 
 	struct STimePieceProperties
 	{
-		inline bool operator==(const STimePieceProperties &rhs) const { return 0 == memcmp(this, &rhs, sizeof(rhs)); }
+		// Compared member by member, since the padding after followTimeOfDay isn't initialised.
+		inline bool operator==(const STimePieceProperties &rhs) const
+		{
+			return (axis == rhs.axis) && (hour == rhs.hour) && (minute == rhs.minute) && (second == rhs.second) && (followTimeOfDay == rhs.followTimeOfDay);
+		}
 
 		Vec3 axis { 0.0f, 1.0f, 0.0f };
 		Schematyc::Range<0, 24> hour = 0.0f;
 		Schematyc::Range<0, 60> minute = 0.0f;
 		Schematyc::Range<0, 60> second = 0.0f;
+		bool followTimeOfDay { false };
 	};
 
-	virtual void Update(SEntityUpdateContext* pCtx);
-
 	virtual void SetCharacterFile(const char* szPath) { m_filePath = szPath; };
 	const char* GetCharacterFile() const { return m_filePath.value.c_str(); }
 
@@ -66,16 +76,19 @@ public:
 	void SetHour(const float hour)
 	{
 		m_timePieceProperties.hour = hour;
+		PushTime();
 	}
 
 	void SetMinute(const float minute)
 	{
 		m_timePieceProperties.minute = minute;
+		PushTime();
 	}
 
 	void SetSecond(const float second)
 	{
 		m_timePieceProperties.second = second;
+		PushTime();
 	}
 
 protected:
@@ -83,6 +96,17 @@ protected:
 	Schematyc::MaterialFileName m_materialPath;
 	_smart_ptr<ICharacterInstance> m_pCachedCharacter = nullptr;
 	STimePieceProperties m_timePieceProperties;
+
+	/** The hand attachments, bound once for each character rather than found by name each time the hands are needed. */
+	CCharacterBindings m_characterBindings;
+	CCharacterBindings::THandle m_hoursBinding { CCharacterBindings::InvalidHandle };
+	CCharacterBindings::THandle m_minutesBinding { CCharacterBindings::InvalidHandle };
+	CCharacterBindings::THandle m_secondsBinding { CCharacterBindings::InvalidHandle };
+
+	/** Sends the time to the needle system, which poses the hands. */
+	void PushTime();
+
+	CNeedleSystem::TOwnerId m_needleOwnerId { CNeedleSystem::InvalidOwnerId };
 };
 
 
@@ -93,5 +117,6 @@ static void ReflectType(Schematyc::CTypeDesc<CTimePieceComponent::STimePieceProp
 	desc.AddMember(&CTimePieceComponent::STimePieceProperties::hour, 'hour', "Hours", "Hours", nullptr, 0.0f);
 	desc.AddMember(&CTimePieceComponent::STimePieceProperties::minute, 'mins', "Minutes", "Minutes", nullptr, 0.0f);
 	desc.AddMember(&CTimePieceComponent::STimePieceProperties::second, 'secs', "Seconds", "Seconds", nullptr, 0.0f);
+	desc.AddMember(&CTimePieceComponent::STimePieceProperties::followTimeOfDay, 'tofd', "FollowTimeOfDay", "Follow Time Of Day", "Show the time of day instead of the hours, minutes and seconds above", false);
 }
 }
\ No newline at end of file
@@ -4,9 +4,17 @@
 #include <CrySystem/ISystem.h>
 #include "Components/Player/PlayerComponent.h"
 #include <Actor/ActorComponent.h>
+#include <Actor/ActorControllerComponent.h>
 #include <Actor/Animation/Actions/ActorAnimationActionEmote.h>
 #include <Actor/Character/CharacterComponent.h>
+#include <Components/Interaction/AwarenessFilter.h>
+#include <DynamicResponseSystem/ConditionDistanceToEntity.h>
+#include <Game/Cache/GameCache.h>
+#include <Game/Cache/GameCacheManifest.h>
 #include <ObjectID/ObjectId.h>
+#include <StateMachine/StateMachineBenchmark.h>
+#include <Utility/AutoEnum.h>
+#include <Utility/StringConversions.h>
 #include <ObjectID/ObjectIdMasterFactory.h>
 #include <Plugin/ChrysalisCorePlugin.h>
 
@@ -15,6 +23,74 @@ namespace Chrysalis
 {
 CCVars g_cvars;
 
+
+template <>
+CCVarValue<Vec3>::CCVarValue()
+	: m_value(ZERO)
+{
+}
+
+
+template <>
+CCVarValue<Quat>::CCVarValue()
+	: m_value(IDENTITY)
+{
+}
+
+
+template <>
+CCVarValue<ColorF>::CCVarValue()
+	: m_value(0.0f, 0.0f, 0.0f, 1.0f)
+{
+}
+
+
+template <typename TValue>
+void CCVarValue<TValue>::Register(const char* szName, const char* szDefault, int flags, const char* szHelp)
+{
+	// The default stands in if registration fails. The variable may already hold a value set before it was registered.
+	Parse(szDefault);
+
+	m_pCVar = REGISTER_STRING_CB(szName, szDefault, flags, szHelp, CCVars::OnCVarValueChanged);
+	if (m_pCVar)
+		Parse(m_pCVar->GetString());
+}
+
+
+template <typename TValue>
+void CCVarValue<TValue>::OnChanged(ICVar* pCVar)
+{
+	if (pCVar == m_pCVar)
+		Parse(m_pCVar->GetString());
+}
+
+
+template <>
+void CCVarValue<Vec3>::Parse(const char* szValue)
+{
+	m_value = Vec3FromString(szValue);
+}
+
+
+template <>
+void CCVarValue<Quat>::Parse(const char* szValue)
+{
+	m_value = QuatFromString(szValue);
+}
+
+
+template <>
+void CCVarValue<ColorF>::Parse(const char* szValue)
+{
+	m_value = StringToColor(szValue, false);
+}
+
+
+template class CCVarValue<Vec3>;
+template class CCVarValue<Quat>;
+template class CCVarValue<ColorF>;
+
+
 void CCVars::RegisterVariables()
 {
 	// ***
@@ -32,11 +108,18 @@ void CCVars::RegisterVariables()
 	REGISTER_CVAR2("watch_text_render_lineSpacing", &m_watch_text_render_lineSpacing, 9.3f, VF_CHEAT, "Line spacing for watch text.");
 	REGISTER_CVAR2("watch_text_render_fxscale", &m_watch_text_render_fxscale, 13.0f, VF_CHEAT, "The watch text render fxscale.");
 
+	// Game cache
+	REGISTER_CVAR2("game_cache_streaming_budget", &m_gameCacheStreamingBudget, 2.0f, VF_CHEAT, "Time in milliseconds the game cache may spend each frame servicing queued asset load requests. At least one request is always serviced per frame.");
+	REGISTER_CVAR2("game_cache_budget_geometry", &m_gameCacheBudgetGeometry, 512, VF_CHEAT, "Memory budget in megabytes for cached geometry. Least recently used entries which aren't pinned are evicted when over budget. 0 - no limit.");
+	REGISTER_CVAR2("game_cache_budget_textures", &m_gameCacheBudgetTextures, 1024, VF_CHEAT, "Memory budget in megabytes for cached textures. Least recently used entries which aren't pinned are evicted when over budget. 0 - no limit.");
+	REGISTER_CVAR2("game_cache_budget_materials", &m_gameCacheBudgetMaterials, 64, VF_CHEAT, "Memory budget in megabytes for cached materials. Least recently used entries which aren't pinned are evicted when over budget. 0 - no limit.");
+	REGISTER_CVAR2("game_cache_budget_particle_effects", &m_gameCacheBudgetParticleEffects, 64, VF_CHEAT, "Memory budget in megabytes for cached particle effects. Least recently used entries which aren't pinned are evicted when over budget. 0 - no limit.");
+
 	// TODO: Deprecate this.
 	REGISTER_CVAR2("ladder_logVerbosity", &m_ladder_logVerbosity, 0, VF_CHEAT, "Ladder logging.");
 
 	// Camera manager
-	m_cameraManagerDebugViewOffset = REGISTER_STRING("camera_manager_debug_view_offset", "0, 0, 0", VF_CHEAT, "A translation vector which is applied after the camera is initially positioned.");
+	m_cameraManagerDebugViewOffset.Register("camera_manager_debug_view_offset", "0, 0, 0", VF_CHEAT, "A translation vector which is applied after the camera is initially positioned.");
 	REGISTER_CVAR2("camera_manager_default_camera", &m_cameraManagerDefaultCamera, 1, VF_CHEAT, "Default camera mode. 0 - FP, 1 - ActionRPG");
 
 	// Action RPG Camera
@@ -50,8 +133,8 @@ void CCVars::RegisterVariables()
 	REGISTER_CVAR2("camera_actionrpg_ZoomMax", &m_actionRPGCameraZoomMax, 1.0f, VF_CHEAT, "The maximum value for camera zoom.");
 	REGISTER_CVAR2("camera_actionrpg_ZoomStep", &m_actionRPGCameraZoomStep, 0.02f, VF_CHEAT, "Each zoom event in or out will alter the zoom factor, m_zoom, by this amount. Use lower values for more steps and higher values to zoom in / out faster with less steps.");
 	REGISTER_CVAR2("camera_actionrpg_ZoomSpeed", &m_actionRPGCameraZoomSpeed, 10.0f, VF_CHEAT, "When the zoom changes we interpolate between it's last value and the goal value. This provides for smoother movement on camera zooms. Higher values will interpolate faster than lower values.");
-	m_actionRPGCameraViewPositionOffset = REGISTER_STRING("camera_actionrpg_view_position_offset", "0, 0, 0", VF_CHEAT, "A translation vector which is applied after the camera is initially positioned. This provides for 'over the shoulder' views of the target actor.");
-	m_actionRPGCameraAimPositionOffset = REGISTER_STRING("camera_actionrpg_aim_position_offset", "0.45, -0.5, 0.0", VF_CHEAT, "A translation vector which is applied after the camera is initially positioned. This provides for 'over the shoulder' views of the target actor.");
+	m_actionRPGCameraViewPositionOffset.Register("camera_actionrpg_view_position_offset", "0, 0, 0", VF_CHEAT, "A translation vector which is applied after the camera is initially positioned. This provides for 'over the shoulder' views of the target actor.");
+	m_actionRPGCameraAimPositionOffset.Register("camera_actionrpg_aim_position_offset", "0.45, -0.5, 0.0", VF_CHEAT, "A translation vector which is applied after the camera is initially positioned. This provides for 'over the shoulder' views of the target actor.");
 
 	// First Person Camera
 	REGISTER_CVAR2("camera_firstperson_debug", &m_firstPersonCameraDebug, 0, VF_CHEAT, "Allow debug display.");
@@ -71,7 +154,14 @@ void CCVars::RegisterVariables()
 	REGISTER_CVAR2("component_equipment_debug", &m_componentEquipmentDebug, 0, VF_CHEAT, "Allow debug display.");
 	REGISTER_CVAR2("component_character_attributes_debug", &m_componentCharacterAttributesDebug, 0, VF_CHEAT, "Allow debug display.");
 	REGISTER_CVAR2("component_awareness_debug", &m_componentAwarenessDebug, 0, VF_CHEAT, "Allow debug display.");
+	REGISTER_CVAR2("component_awareness_stats", &m_componentAwarenessStats, 0, VF_CHEAT, "Display the number of awareness components updated, queries run and rays cast each frame.");
+	REGISTER_CVAR2("component_awareness_lod_near_distance", &m_componentAwarenessLodNearDistance, 10.0f, VF_CHEAT, "Actors within this distance of the local player have their awareness updated every frame.");
+	REGISTER_CVAR2("component_awareness_lod_far_distance", &m_componentAwarenessLodFarDistance, 40.0f, VF_CHEAT, "Actors beyond this distance of the local player have their awareness updated every component_awareness_lod_far_interval frames.");
+	REGISTER_CVAR2("component_awareness_lod_mid_interval", &m_componentAwarenessLodMidInterval, 4, VF_CHEAT, "Number of frames between awareness updates for actors between the near and far distances.");
+	REGISTER_CVAR2("component_awareness_lod_far_interval", &m_componentAwarenessLodFarInterval, 16, VF_CHEAT, "Number of frames between awareness updates for actors beyond the far distance.");
+	REGISTER_CVAR2("component_awareness_max_updates", &m_componentAwarenessMaxUpdates, 32, VF_CHEAT, "Maximum number of awareness components updated per frame, not counting the local player. Those left over are updated first next frame. 0 - no limit.");
 	REGISTER_CVAR2("component_inventory_debug", &m_componentInventoryDebug, 0, VF_CHEAT, "Allow debug display.");
+	REGISTER_CVAR2("needle_max_distance", &m_needleMaxDistance, 40.0f, VF_CHEAT, "Time pieces and gauges further than this from the camera don't have their needles moved until they come closer.");
 
 	// ***
 	// *** COMMANDS
@@ -83,6 +173,26 @@ void CCVars::RegisterVariables()
 		"Usage: createobjectid [class]");
 	REGISTER_COMMAND("emote", CCVars::OnEmote, VF_NULL, "Makes a request for the character under player command to perform an emote.\n"
 		"Usage: emote [emotion]");
+	REGISTER_COMMAND("game_cache_stats", CCVars::OnGameCacheStats, VF_NULL, "Outputs the hit / miss and memory statistics for the game cache.\n"
+		"Usage: game_cache_stats [reset]");
+	REGISTER_COMMAND("game_cache_flush", CCVars::OnGameCacheFlush, VF_CHEAT, "Evicts every entry in the game cache which isn't pinned.\n"
+		"Usage: game_cache_flush");
+	REGISTER_COMMAND("game_cache_build_manifest", CCVars::OnGameCacheBuildManifest, VF_CHEAT, "Scans the item parameter files and writes out the manifest of assets used to warm the game cache.\n"
+		"Usage: game_cache_build_manifest [folder] [output file]");
+	REGISTER_COMMAND("awareness_filter_benchmark", CCVars::OnAwarenessFilterBenchmark, VF_CHEAT, "Times the batch awareness filters against the scalar versions at 10, 100 and 1000 candidates.\n"
+		"Usage: awareness_filter_benchmark [iterations]");
+	REGISTER_COMMAND("state_machine_benchmark", CCVars::OnStateMachineBenchmark, VF_CHEAT, "Times event dispatch through the flattened state handler chains against walking the parent states.\n"
+		"Usage: state_machine_benchmark [iterations]");
+	REGISTER_COMMAND("state_machine_stats", CCVars::OnStateMachineStats, VF_NULL, "Outputs the live, peak and allocated counts of the actor movement state hierarchies.\n"
+		"Usage: state_machine_stats [release]");
+	REGISTER_COMMAND("objectid_benchmark", CCVars::OnObjectIdBenchmark, VF_CHEAT, "Times ObjectId creation from 1 to 16 threads sharing a factory, and checks the Ids are unique.\n"
+		"Usage: objectid_benchmark [ids per thread]");
+	REGISTER_COMMAND("drs_distance_benchmark", CCVars::OnDRSDistanceBenchmark, VF_CHEAT, "Times 1,000 DRS distance conditions looking up their target by name against the cached and batched versions.\n"
+		"Usage: drs_distance_benchmark [iterations]");
+	REGISTER_COMMAND("autoenum_benchmark", CCVars::OnAutoEnumBenchmark, VF_CHEAT, "Times AutoEnum flag string parsing by linear scan against the hashed name table, and bitfield formatting to a string against a buffer.\n"
+		"Usage: autoenum_benchmark [iterations]");
+	REGISTER_COMMAND("entity_update_stats", CCVars::OnEntityUpdateStats, VF_NULL, "Outputs the number of components of each type, and how many of them are subscribed to the update and pre-physics update events.\n"
+		"Usage: entity_update_stats");
 }
 
 
@@ -100,6 +210,24 @@ void CCVars::UnregisterVariables()
 	gEnv->pConsole->RemoveCommand("attach");
 	gEnv->pConsole->RemoveCommand("createobjectid");
 	gEnv->pConsole->RemoveCommand("emote");
+	gEnv->pConsole->RemoveCommand("game_cache_stats");
+	gEnv->pConsole->RemoveCommand("game_cache_flush");
+	gEnv->pConsole->RemoveCommand("game_cache_build_manifest");
+	gEnv->pConsole->RemoveCommand("awareness_filter_benchmark");
+	gEnv->pConsole->RemoveCommand("state_machine_benchmark");
+	gEnv->pConsole->RemoveCommand("state_machine_stats");
+	gEnv->pConsole->RemoveCommand("objectid_benchmark");
+	gEnv->pConsole->RemoveCommand("drs_distance_benchmark");
+	gEnv->pConsole->RemoveCommand("autoenum_benchmark");
+	gEnv->pConsole->RemoveCommand("entity_update_stats");
+}
+
+
+void CCVars::OnCVarValueChanged(ICVar* pCVar)
+{
+	g_cvars.m_cameraManagerDebugViewOffset.OnChanged(pCVar);
+	g_cvars.m_actionRPGCameraViewPositionOffset.OnChanged(pCVar);
+	g_cvars.m_actionRPGCameraAimPositionOffset.OnChanged(pCVar);
 }
 
 
@@ -255,4 +383,163 @@ void CCVars::OnEmote(IConsoleCmdArgs* pConsoleCommandArgs)
 		CryLogAlways("Please supply the name of the emote to play.");
 	}
 }
-}
\ No newline at end of file
+
+
+void CCVars::OnGameCacheStats(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	if (auto pGameCache = CChrysalisCorePlugin::Get()->GetGameCache())
+	{
+		pGameCache->LogStatistics();
+
+		if ((pConsoleCommandArgs->GetArgCount() == 2) && (stricmp(pConsoleCommandArgs->GetArg(1), "reset") == 0))
+		{
+			pGameCache->ResetStatistics();
+			CryLogAlways("Game cache hit / miss counts have been reset.");
+		}
+	}
+}
+
+
+void CCVars::OnGameCacheFlush(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	if (auto pGameCache = CChrysalisCorePlugin::Get()->GetGameCache())
+	{
+		pGameCache->Flush();
+		pGameCache->LogStatistics();
+	}
+}
+
+
+void CCVars::OnGameCacheBuildManifest(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	const char* folder = pConsoleCommandArgs->GetArgCount() > 1 ? pConsoleCommandArgs->GetArg(1) : CGameCacheManifest::DefaultItemParametersFolder;
+	const char* fileName = pConsoleCommandArgs->GetArgCount() > 2 ? pConsoleCommandArgs->GetArg(2) : CGameCacheManifest::DefaultFileName;
+
+	CGameCacheManifest manifest;
+	const size_t itemCount = manifest.BuildFromItemParameters(folder);
+
+	if (manifest.Write(fileName))
+	{
+		CryLogAlways("Game cache manifest '%s' written with %" PRISIZE_T " item classes and %" PRISIZE_T " assets.",
+			fileName, itemCount, manifest.GetAssets().size());
+
+		if (auto pGameCache = CChrysalisCorePlugin::Get()->GetGameCache())
+			pGameCache->LoadManifest(fileName);
+	}
+}
+
+
+void CCVars::OnAwarenessFilterBenchmark(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	const int iterations = pConsoleCommandArgs->GetArgCount() > 1 ? atoi(pConsoleCommandArgs->GetArg(1)) : 1000;
+
+	CAwarenessCandidates::RunBenchmark(iterations);
+}
+
+
+void CCVars::OnStateMachineBenchmark(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	const int iterations = pConsoleCommandArgs->GetArgCount() > 1 ? atoi(pConsoleCommandArgs->GetArg(1)) : 100000;
+
+	CStateMachineBenchmark::Run(iterations);
+}
+
+
+void CCVars::OnStateMachineStats(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	if (auto pRegistration = CActorControllerComponent::s_pStateMachineRegistrationMovement)
+	{
+		if ((pConsoleCommandArgs->GetArgCount() == 2) && (stricmp(pConsoleCommandArgs->GetArg(1), "release") == 0))
+		{
+			pRegistration->ReleaseFreeStates();
+			CryLogAlways("Released the unused movement state hierarchies.");
+		}
+
+		CryLogAlways("Movement state hierarchies: %u live, %u peak, %u allocated.", pRegistration->GetLiveCount(),
+			pRegistration->GetPeakCount(), pRegistration->GetAllocatedCount());
+	}
+}
+
+
+void CCVars::OnObjectIdBenchmark(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	const int idsPerThread = pConsoleCommandArgs->GetArgCount() > 1 ? atoi(pConsoleCommandArgs->GetArg(1)) : 100000;
+
+	CObjectIdFactory::RunBenchmark(idsPerThread);
+}
+
+
+void CCVars::OnDRSDistanceBenchmark(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	const int iterations = pConsoleCommandArgs->GetArgCount() > 1 ? atoi(pConsoleCommandArgs->GetArg(1)) : 100;
+
+	CConditionDistanceToEntity::RunBenchmark(iterations);
+}
+
+
+void CCVars::OnAutoEnumBenchmark(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	const int iterations = pConsoleCommandArgs->GetArgCount() > 1 ? atoi(pConsoleCommandArgs->GetArg(1)) : 10000;
+
+	AutoEnum_RunBenchmark(iterations);
+}
+
+
+void CCVars::OnEntityUpdateStats(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	struct SComponentCounts
+	{
+		int components { 0 };
+		int update { 0 };
+		int prePhysicsUpdate { 0 };
+	};
+
+	std::map<string, SComponentCounts> countsByType;
+	SComponentCounts totals;
+	int entityCount = 0;
+
+	DynArray<IEntityComponent*> components;
+	IEntityItPtr pIterator = gEnv->pEntitySystem->GetEntityIterator();
+	pIterator->MoveFirst();
+	while (IEntity* pEntity = pIterator->Next())
+	{
+		++entityCount;
+
+		components.clear();
+		pEntity->GetComponents(components);
+		for (const IEntityComponent* pComponent : components)
+		{
+			const char* szLabel = pComponent->GetClassDesc().GetLabel();
+			SComponentCounts& counts = countsByType [(szLabel && szLabel [0]) ? szLabel : "(unregistered)"];
+
+			// Components are free to change their mask at any time, so this is what they are asking for right now.
+			const Cry::Entity::EntityEventMask eventMask = pComponent->GetEventMask();
+			const int update = (eventMask & EventToMask(EEntityEvent::Update)) ? 1 : 0;
+			const int prePhysicsUpdate = (eventMask & EventToMask(EEntityEvent::PrePhysicsUpdate)) ? 1 : 0;
+
+			++counts.components;
+			counts.update += update;
+			counts.prePhysicsUpdate += prePhysicsUpdate;
+			++totals.components;
+			totals.update += update;
+			totals.prePhysicsUpdate += prePhysicsUpdate;
+		}
+	}
+
+	// Busiest first, since those are the ones worth looking at.
+	std::vector<std::pair<string, SComponentCounts>> sortedCounts(countsByType.begin(), countsByType.end());
+	std::stable_sort(sortedCounts.begin(), sortedCounts.end(), [](const std::pair<string, SComponentCounts>& a, const std::pair<string, SComponentCounts>& b)
+	{
+		return (a.second.update + a.second.prePhysicsUpdate) > (b.second.update + b.second.prePhysicsUpdate);
+	});
+
+	CryLogAlways("Component update subscriptions across %d entities.", entityCount);
+	CryLogAlways("%-40s %10s %10s %10s", "component", "count", "update", "prephysics");
+	for (const auto& typeCounts : sortedCounts)
+	{
+		CryLogAlways("%-40s %10d %10d %10d", typeCounts.first.c_str(), typeCounts.second.components, typeCounts.second.update,
+			typeCounts.second.prePhysicsUpdate);
+	}
+	CryLogAlways("%-40s %10d %10d %10d", "total", totals.components, totals.update, totals.prePhysicsUpdate);
+}
+}
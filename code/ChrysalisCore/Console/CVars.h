@@ -1,7 +1,43 @@
 #pragma once
 
+#include <CryMath/Cry_Color.h>
+
+
 namespace Chrysalis
 {
+/**
+A string console variable holding a Vec3, Quat or ColorF. The string is parsed when the variable is registered and
+again each time it changes, so reading the value doesn't cost anything. Until then the value is zero, or the identity
+for a Quat, and if registration fails it holds the parsed default.
+**/
+template <typename TValue>
+class CCVarValue final
+{
+public:
+	CCVarValue();
+
+	void Register(const char* szName, const char* szDefault, int flags, const char* szHelp);
+
+	/** Parses the string again if the variable which changed is this one. */
+	void OnChanged(ICVar* pCVar);
+
+	const TValue& Get() const { return m_value; }
+
+	ICVar* GetCVar() const { return m_pCVar; }
+
+private:
+	void Parse(const char* szValue);
+
+	ICVar* m_pCVar { nullptr };
+	TValue m_value;
+};
+
+
+template <> CCVarValue<Vec3>::CCVarValue();
+template <> CCVarValue<Quat>::CCVarValue();
+template <> CCVarValue<ColorF>::CCVarValue();
+
+
 class CCVars final
 {
 public:
@@ -26,8 +62,15 @@ public:
 	float m_watch_text_render_lineSpacing { 9.3f };
 	float m_watch_text_render_fxscale { 13.0f };
 
+	// Game cache
+	float m_gameCacheStreamingBudget { 2.0f };
+	int m_gameCacheBudgetGeometry { 512 };
+	int m_gameCacheBudgetTextures { 1024 };
+	int m_gameCacheBudgetMaterials { 64 };
+	int m_gameCacheBudgetParticleEffects { 64 };
+
 	// Camera manager
-	ICVar* m_cameraManagerDebugViewOffset;
+	CCVarValue<Vec3> m_cameraManagerDebugViewOffset;
 	int m_cameraManagerDefaultCamera { 1 };
 
 	// Action RPG Camera
@@ -41,8 +84,8 @@ public:
 	float m_actionRPGCameraZoomMax;
 	float m_actionRPGCameraZoomStep;
 	float m_actionRPGCameraZoomSpeed;
-	ICVar* m_actionRPGCameraViewPositionOffset;
-	ICVar* m_actionRPGCameraAimPositionOffset;
+	CCVarValue<Vec3> m_actionRPGCameraViewPositionOffset;
+	CCVarValue<Vec3> m_actionRPGCameraAimPositionOffset;
 
 	// First Person Camera
 	int m_firstPersonCameraDebug { 0 };
@@ -61,7 +104,22 @@ public:
 	int m_componentEquipmentDebug { 0 };
 	int m_componentCharacterAttributesDebug { 0 };
 	int m_componentAwarenessDebug { 0 };
+	int m_componentAwarenessStats { 0 };
+	float m_componentAwarenessLodNearDistance { 10.0f };
+	float m_componentAwarenessLodFarDistance { 40.0f };
+	int m_componentAwarenessLodMidInterval { 4 };
+	int m_componentAwarenessLodFarInterval { 16 };
+	int m_componentAwarenessMaxUpdates { 32 };
 	int m_componentInventoryDebug { 0 };
+	float m_needleMaxDistance { 40.0f };
+
+
+	/**
+	Called when any of the Vec3, Quat or ColorF variables changes, to refresh its parsed value.
+
+	\param [in,out]	pCVar The variable which changed.
+	**/
+	static void OnCVarValueChanged(ICVar* pCVar);
 
 
 	/**
@@ -86,6 +144,86 @@ public:
 	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
 	**/
 	static void OnEmote(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
+	/**
+	Outputs the hit / miss and memory statistics for the game cache to the log.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnGameCacheStats(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
+	/**
+	Evicts every entry in the game cache which isn't pinned.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnGameCacheFlush(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
+	/**
+	Builds the game cache item manifest from the item parameter files, writes it out and loads it into the game cache.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnGameCacheBuildManifest(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
+	/**
+	Times the batch awareness filters against the scalar ones and outputs the results to the log.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnAwarenessFilterBenchmark(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
+	/**
+	Times state machine event dispatch and outputs the results to the log.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnStateMachineBenchmark(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
+	/**
+	Outputs the counts of the movement state hierarchies, and optionally frees the memory kept for reuse.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnStateMachineStats(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
+	/**
+	Times ObjectId creation across several threads and outputs the results to the log.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnObjectIdBenchmark(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
+	/**
+	Times the DRS distance condition with and without its cached target, and outputs the results to the log.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnDRSDistanceBenchmark(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
+	/**
+	Times AutoEnum flag parsing and formatting, with and without the hashed name tables, and outputs the results to the log.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnAutoEnumBenchmark(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
+	/**
+	Outputs the number of components of each type in the level, and how many are subscribed to update events.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnEntityUpdateStats(IConsoleCmdArgs* pConsoleCommandArgs);
 };
 
 extern CCVars g_cvars;
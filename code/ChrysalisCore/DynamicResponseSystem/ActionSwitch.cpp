@@ -32,11 +32,11 @@ DRS::IResponseActionInstanceUniquePtr CActionSwitch::Execute(DRS::IResponseInsta
 			{
 				// Simple option is to play the verb.
 				// #TODO: This should be a little more nuanced.
-				auto pInteraction = pInteractor->GetInteraction(verb.GetText()).lock();
-				if (pInteraction)
+				auto interaction = pInteractor->GetInteraction(verb.GetText().c_str());
+				if (interaction)
 				{
 					if (auto pActorComponent = CPlayerComponent::GetLocalActor())
-						pInteraction->OnInteractionStart(*pActorComponent);
+						interaction.OnInteractionStart(*pActorComponent);
 				}
 			}
 		}
@@ -24,17 +24,142 @@ CConditionDistanceToEntity::~CConditionDistanceToEntity()
 
 bool CConditionDistanceToEntity::IsMet(DRS::IResponseInstance* pResponseInstance)
 {
-	IEntity* pTargetEntity = gEnv->pEntitySystem->FindEntityByName(m_entityName.c_str());
-	if (pTargetEntity)
+	IEntity* pSourceEntity = pResponseInstance->GetCurrentActor()->GetLinkedEntity();
+	if (pSourceEntity)
 	{
-		IEntity* pSourceEntity = pResponseInstance->GetCurrentActor()->GetLinkedEntity();
-		if (pSourceEntity)
+		return IsMet(pSourceEntity->GetWorldPos());
+	}
+
+	return false;
+}
+
+
+bool CConditionDistanceToEntity::IsMet(const Vec3& sourcePosition)
+{
+	if (IEntity* pTargetEntity = GetTargetEntity())
+	{
+		return pTargetEntity->GetWorldPos().GetSquaredDistance(sourcePosition) < m_squaredDistance;
+	}
+
+	return false;
+}
+
+
+void CConditionDistanceToEntity::IsMetBatch(const Vec3& sourcePosition, CConditionDistanceToEntity* const* ppConditions, size_t count, bool* pResults)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		pResults [i] = ppConditions [i]->IsMet(sourcePosition);
+	}
+}
+
+
+IEntity* CConditionDistanceToEntity::GetTargetEntity()
+{
+	// Entity Ids are salted, so if our target has been removed this fails even if the Id is reused.
+	if (m_targetEntityId != INVALID_ENTITYID)
+	{
+		IEntity* pTargetEntity = gEnv->pEntitySystem->GetEntity(m_targetEntityId);
+		if ((pTargetEntity) && (!pTargetEntity->IsGarbage()))
+			return pTargetEntity;
+
+		m_targetEntityId = INVALID_ENTITYID;
+	}
+
+	if (m_lastResolveFrame != gEnv->nMainFrameID)
+	{
+		m_lastResolveFrame = gEnv->nMainFrameID;
+
+		if (IEntity* pTargetEntity = gEnv->pEntitySystem->FindEntityByName(m_entityName.c_str()))
 		{
-			return pTargetEntity->GetWorldPos().GetSquaredDistance(pSourceEntity->GetWorldPos()) < m_squaredDistance;
+			m_targetEntityId = pTargetEntity->GetId();
+			return pTargetEntity;
 		}
 	}
 
-	return false;
+	return nullptr;
+}
+
+
+void CConditionDistanceToEntity::RunBenchmark(int iterations)
+{
+	const int conditionCount = 1000;
+	const int targetCount = 100;
+
+	iterations = max(iterations, 1);
+
+	// Spread the targets along a line so about half of them are in range of the source.
+	std::vector<EntityId> targetIds;
+	for (int i = 0; i < targetCount; ++i)
+	{
+		SEntitySpawnParams spawnParams;
+		spawnParams.pClass = gEnv->pEntitySystem->GetClassRegistry()->GetDefaultClass();
+		spawnParams.sName = string().Format("DistanceBenchmark%d", i);
+		spawnParams.vPosition = Vec3(static_cast<float>(i) * 0.2f, 0.0f, 0.0f);
+		spawnParams.nFlags = ENTITY_FLAG_CLIENT_ONLY | ENTITY_FLAG_NO_SAVE;
+
+		if (IEntity* pEntity = gEnv->pEntitySystem->SpawnEntity(spawnParams))
+			targetIds.push_back(pEntity->GetId());
+	}
+
+	std::vector<CConditionDistanceToEntity> conditions;
+	conditions.reserve(conditionCount);
+	for (int i = 0; i < conditionCount; ++i)
+		conditions.emplace_back(string().Format("DistanceBenchmark%d", i % targetCount));
+
+	std::vector<CConditionDistanceToEntity*> conditionPtrs;
+	for (auto& condition : conditions)
+		conditionPtrs.push_back(&condition);
+
+	const Vec3 sourcePosition(0.0f, 1.0f, 0.0f);
+	std::unique_ptr<bool []> results(new bool [conditionCount]);
+	int metCount [3] = { 0, 0, 0 };
+
+	auto timeConditions = [iterations, conditionCount](const std::function<void()>& evaluate)
+	{
+		const CTimeValue startTime = gEnv->pTimer->GetAsyncTime();
+		for (int i = 0; i < iterations; ++i)
+			evaluate();
+
+		return (gEnv->pTimer->GetAsyncTime() - startTime).GetMilliSeconds() * 1000000.0f / static_cast<float>(iterations * conditionCount);
+	};
+
+	// The way the condition used to work, searching for the target by name on every test.
+	const float byNameTime = timeConditions([&]()
+	{
+		metCount [0] = 0;
+		for (auto& condition : conditions)
+		{
+			IEntity* pTargetEntity = gEnv->pEntitySystem->FindEntityByName(condition.m_entityName.c_str());
+			if ((pTargetEntity) && (pTargetEntity->GetWorldPos().GetSquaredDistance(sourcePosition) < condition.m_squaredDistance))
+				++metCount [0];
+		}
+	});
+
+	const float cachedTime = timeConditions([&]()
+	{
+		metCount [1] = 0;
+		for (auto& condition : conditions)
+		{
+			if (condition.IsMet(sourcePosition))
+				++metCount [1];
+		}
+	});
+
+	const float batchTime = timeConditions([&]()
+	{
+		IsMetBatch(sourcePosition, conditionPtrs.data(), conditionPtrs.size(), results.get());
+		metCount [2] = static_cast<int>(std::count(results.get(), results.get() + conditionCount, true));
+	});
+
+	for (auto targetId : targetIds)
+		gEnv->pEntitySystem->RemoveEntity(targetId, true);
+
+	CryLogAlways("DRS distance condition benchmark, %d conditions on %d targets, %d iterations. Times are in nanoseconds per condition.",
+		conditionCount, static_cast<int>(targetIds.size()), iterations);
+	CryLogAlways("%12s %12s %12s  %s", "by name", "cached", "batched", "results");
+	CryLogAlways("%12.1f %12.1f %12.1f  %s", byNameTime, cachedTime, batchTime,
+		((metCount [0] == metCount [1]) && (metCount [1] == metCount [2])) ? "match" : "MISMATCH");
 }
 
 
@@ -44,6 +169,10 @@ void CConditionDistanceToEntity::Serialize(Serialization::IArchive& ar)
 	ar(distance, "Distance", "^> Distance");
 	m_squaredDistance = distance * distance;
 	ar(m_entityName, "EntityName", "^EntityName");
+
+	// The name may have changed, so look the target up again next time.
+	m_targetEntityId = INVALID_ENTITYID;
+	m_lastResolveFrame = -1;
 }
 
 
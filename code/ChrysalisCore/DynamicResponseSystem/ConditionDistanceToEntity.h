@@ -23,8 +23,53 @@ public:
 	virtual const char* GetType() const override { return "DistanceToEntity"; }
 	// ~IResponseCondition
 
+
+	/**
+	Tests whether the target entity is within range of a source position.
+
+	\param	sourcePosition	The world position to measure from.
+
+	\return	True if the target entity exists and is in range.
+	**/
+	bool IsMet(const Vec3& sourcePosition);
+
+
+	/**
+	Tests a set of conditions against one source position in a single pass. Useful when many responses for the same
+	actor are being evaluated at once.
+
+	\param	sourcePosition	The world position to measure from.
+	\param	ppConditions  	The conditions to test.
+	\param	count		  	The number of conditions.
+	\param [out]	pResults	One result for each condition, true if it is met.
+	**/
+	static void IsMetBatch(const Vec3& sourcePosition, CConditionDistanceToEntity* const* ppConditions, size_t count, bool* pResults);
+
+
+	/**
+	Times 1,000 conditions using a name lookup each time against the cached Ids, singly and batched, and outputs the
+	results to the log. Spawns its own target entities and removes them again afterwards.
+
+	\param	iterations	The number of times to evaluate all the conditions for each timing.
+	**/
+	static void RunBenchmark(int iterations);
+
 private:
+	/**
+	Gets the target entity, resolving the name to an Id the first time through and whenever the entity we had is
+	removed. Failed lookups are only retried once a frame, so a missing target doesn't cost a name search on every test.
+
+	\return	The target entity, or null if there isn't one.
+	**/
+	IEntity* GetTargetEntity();
+
 	float m_squaredDistance { 100.0f };
 	string m_entityName;
+
+	/** The target entity, once we have found it by name. */
+	EntityId m_targetEntityId { INVALID_ENTITYID };
+
+	/** The frame we last searched for the target by name. */
+	int m_lastResolveFrame { -1 };
 };
 }
\ No newline at end of file
@@ -8,47 +8,88 @@ namespace Chrysalis
 class IActorComponent;
 
 
-/** An generic definition for interactions fired off by the player during gameplay. */
+/**
+An generic definition for interactions fired off by the player during gameplay.
+
+Interactions hold no state of their own. There is a single shared instance of each type, and the entity it acts on is
+passed in as the subject. Whether an interaction is enabled or hidden is kept by the CEntityInteractionComponent it
+was added to, so an interactive entity costs a small record for each verb rather than an object for each.
+**/
 struct IInteraction
 {
+	virtual ~IInteraction() {}
+
+
 	/**
 	Called at the start of an interaction. Generally called on a downward keypress.
 	
-	\param [in,out]	actor The actor who triggered this interaction.
+	\param [in,out]	pSubject The subject the interaction was added with.
+	\param [in,out]	actor    The actor who triggered this interaction.
 	**/
-	virtual void OnInteractionStart(IActorComponent& actor) {};
+	virtual void OnInteractionStart(void* pSubject, IActorComponent& actor) const {};
 
 
 	/**
 	Called each game frame an interaction is ongoing. This will be called multiple times, as long as the player is
 	holding down the interaction key / button.
 	
-	\param [in,out]	actor The actor who triggered this interaction.
+	\param [in,out]	pSubject The subject the interaction was added with.
+	\param [in,out]	actor    The actor who triggered this interaction.
 	**/
-	virtual void OnInteractionTick(IActorComponent& actor) {};
+	virtual void OnInteractionTick(void* pSubject, IActorComponent& actor) const {};
 
 
 	/**
 	Called when an interaction is completed normally. Generally called on an upward keypress.
 	
-	\param [in,out]	actor The actor who triggered this interaction.
+	\param [in,out]	pSubject The subject the interaction was added with.
+	\param [in,out]	actor    The actor who triggered this interaction.
 	**/
-	virtual void OnInteractionComplete(IActorComponent& actor) {};
+	virtual void OnInteractionComplete(void* pSubject, IActorComponent& actor) const {};
 
 
 	virtual const string GetVerb() const { return "interaction_interact"; };
 	virtual const string GetVerbUI() const { return "@" + GetVerb(); };
+};
 
-	bool IsEnabled() const { return m_isEnabled; };
-	void SetEnabled(bool isEnabled) { m_isEnabled = isEnabled; };
-	bool IsHidden() const { return m_isHidden; };
-	void SetHidden(bool isHidden) { m_isHidden = isHidden; };
+
+/**
+The base for interactions which act on a particular subject interface. The subject comes back as the pointer it was
+stored as, which is safe because CEntityInteractionComponent::AddInteraction only accepts this type for it.
+**/
+template <typename TSubject>
+struct TInteraction : public IInteraction
+{
+	typedef TSubject TSubjectType;
 
 protected:
-	bool m_isEnabled { true };
-	bool m_isHidden { false };
+	static TSubject& GetSubject(void* pSubject) { return *static_cast<TSubject*>(pSubject); }
+};
+
+
+/** An interaction together with the subject it acts on. It is only valid while the subject is. */
+class CBoundInteraction
+{
+public:
+	CBoundInteraction() {}
+	CBoundInteraction(const IInteraction* pInteraction, void* pSubject)
+		: m_pInteraction(pInteraction), m_pSubject(pSubject) {}
+
+	explicit operator bool() const { return m_pInteraction != nullptr; }
+
+	const IInteraction* GetInteraction() const { return m_pInteraction; }
+
+	void OnInteractionStart(IActorComponent& actor) const { m_pInteraction->OnInteractionStart(m_pSubject, actor); };
+	void OnInteractionTick(IActorComponent& actor) const { m_pInteraction->OnInteractionTick(m_pSubject, actor); };
+	void OnInteractionComplete(IActorComponent& actor) const { m_pInteraction->OnInteractionComplete(m_pSubject, actor); };
+
+	const string GetVerb() const { return m_pInteraction->GetVerb(); };
+	const string GetVerbUI() const { return m_pInteraction->GetVerbUI(); };
+
+private:
+	const IInteraction* m_pInteraction { nullptr };
+	void* m_pSubject { nullptr };
 };
-DECLARE_SHARED_POINTERS(IInteraction);
 
 
 // ***
@@ -58,31 +99,20 @@ DECLARE_SHARED_POINTERS(IInteraction);
 
 struct IInteractionInteract
 {
-	virtual void OnInteractionInteractStart(IInteraction& pInteraction, IActorComponent& actor) = 0;
-	virtual void OnInteractionInteractTick(IInteraction& pInteraction, IActorComponent& actor) = 0;
-	virtual void OnInteractionInteractComplete(IInteraction& pInteraction, IActorComponent& actor) = 0;
+	virtual void OnInteractionInteractStart(const IInteraction& pInteraction, IActorComponent& actor) = 0;
+	virtual void OnInteractionInteractTick(const IInteraction& pInteraction, IActorComponent& actor) = 0;
+	virtual void OnInteractionInteractComplete(const IInteraction& pInteraction, IActorComponent& actor) = 0;
 };
 
 
-class CInteractionInteract : public IInteraction
+class CInteractionInteract : public TInteraction<IInteractionInteract>
 {
 public:
-	CInteractionInteract(IInteractionInteract* subject, bool isEnabled = true, bool isHidden = false)
-		: m_subject(subject)
-	{
-		m_isEnabled = isEnabled;
-		m_isHidden = isHidden;
-	};
-
 	const string GetVerb() const override { return "interaction_interact"; };
-	void OnInteractionStart(IActorComponent& actor) override { m_subject->OnInteractionInteractStart(*this, actor); };
-	void OnInteractionTick(IActorComponent& actor) override { m_subject->OnInteractionInteractTick(*this, actor); };
-	void OnInteractionComplete(IActorComponent& actor) override { m_subject->OnInteractionInteractComplete(*this, actor); };
-
-private:
-	IInteractionInteract* m_subject { nullptr };
+	void OnInteractionStart(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionInteractStart(*this, actor); };
+	void OnInteractionTick(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionInteractTick(*this, actor); };
+	void OnInteractionComplete(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionInteractComplete(*this, actor); };
 };
-DECLARE_SHARED_POINTERS(CInteractionInteract);
 
 
 // ***
@@ -91,67 +121,34 @@ DECLARE_SHARED_POINTERS(CInteractionInteract);
 
 struct IInteractionSwitch
 {
-	virtual void OnInteractionSwitchToggle(IInteraction& pInteraction, IActorComponent& actor) = 0;
-	virtual void OnInteractionSwitchOff(IInteraction& pInteraction, IActorComponent& actor) = 0;
-	virtual void OnInteractionSwitchOn(IInteraction& pInteraction, IActorComponent& actor) = 0;
+	virtual void OnInteractionSwitchToggle(const IInteraction& pInteraction, IActorComponent& actor) = 0;
+	virtual void OnInteractionSwitchOff(const IInteraction& pInteraction, IActorComponent& actor) = 0;
+	virtual void OnInteractionSwitchOn(const IInteraction& pInteraction, IActorComponent& actor) = 0;
 };
 
 
-class CInteractionSwitchToggle : public IInteraction
+class CInteractionSwitchToggle : public TInteraction<IInteractionSwitch>
 {
 public:
-	CInteractionSwitchToggle(IInteractionSwitch* subject, bool isEnabled = true, bool isHidden = false)
-		: m_subject(subject)
-	{
-		m_isEnabled = isEnabled;
-		m_isHidden = isHidden;
-	};
-
 	const string GetVerb() const override { return "interaction_switch_toggle"; };
-	void OnInteractionStart(IActorComponent& actor) override { m_subject->OnInteractionSwitchToggle(*this, actor); };
-
-private:
-	IInteractionSwitch* m_subject { nullptr };
+	void OnInteractionStart(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionSwitchToggle(*this, actor); };
 };
-DECLARE_SHARED_POINTERS(CInteractionSwitchToggle);
 
 
-class CInteractionSwitchOn : public IInteraction
+class CInteractionSwitchOn : public TInteraction<IInteractionSwitch>
 {
 public:
-	CInteractionSwitchOn(IInteractionSwitch* subject, bool isEnabled = true, bool isHidden = false)
-		: m_subject(subject)
-	{
-		m_isEnabled = isEnabled;
-		m_isHidden = isHidden;
-	};
-
 	const string GetVerb() const override { return "interaction_switch_on"; };
-	void OnInteractionStart(IActorComponent& actor) override { m_subject->OnInteractionSwitchOn(*this, actor); };
-
-private:
-	IInteractionSwitch* m_subject { nullptr };
+	void OnInteractionStart(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionSwitchOn(*this, actor); };
 };
-DECLARE_SHARED_POINTERS(CInteractionSwitchOn);
 
 
-class CInteractionSwitchOff : public IInteraction
+class CInteractionSwitchOff : public TInteraction<IInteractionSwitch>
 {
 public:
-	CInteractionSwitchOff(IInteractionSwitch* subject, bool isEnabled = true, bool isHidden = false)
-		: m_subject(subject)
-	{
-		m_isEnabled = isEnabled;
-		m_isHidden = isHidden;
-	};
-
 	const string GetVerb() const override { return "interaction_switch_off"; };
-	void OnInteractionStart(IActorComponent& actor) override { m_subject->OnInteractionSwitchOff(*this, actor); };
-
-private:
-	IInteractionSwitch* m_subject { nullptr };
+	void OnInteractionStart(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionSwitchOff(*this, actor); };
 };
-DECLARE_SHARED_POINTERS(CInteractionSwitchOff);
 
 
 // ***
@@ -166,42 +163,20 @@ struct IInteractionOpenable
 };
 
 
-class CInteractionOpenableOpen : public IInteraction
+class CInteractionOpenableOpen : public TInteraction<IInteractionOpenable>
 {
 public:
-	CInteractionOpenableOpen(IInteractionOpenable* subject, bool isEnabled = true, bool isHidden = false)
-		: m_subject(subject)
-	{
-		m_isEnabled = isEnabled;
-		m_isHidden = isHidden;
-	};
-
 	const string GetVerb() const override { return "interaction_openable_open"; };
-	void OnInteractionStart(IActorComponent& actor) override { m_subject->OnInteractionOpenableOpen(actor); };
-
-private:
-	IInteractionOpenable* m_subject { nullptr };
+	void OnInteractionStart(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionOpenableOpen(actor); };
 };
-DECLARE_SHARED_POINTERS(CInteractionOpenableOpen);
 
 
-class CInteractionOpenableClose : public IInteraction
+class CInteractionOpenableClose : public TInteraction<IInteractionOpenable>
 {
 public:
-	CInteractionOpenableClose(IInteractionOpenable* subject, bool isEnabled = true, bool isHidden = false)
-		: m_subject(subject)
-	{
-		m_isEnabled = isEnabled;
-		m_isHidden = isHidden;
-	};
-
 	const string GetVerb() const override { return "interaction_openable_close"; };
-	void OnInteractionStart(IActorComponent& actor) override { m_subject->OnInteractionOpenableClose(actor); };
-
-private:
-	IInteractionOpenable* m_subject { nullptr };
+	void OnInteractionStart(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionOpenableClose(actor); };
 };
-DECLARE_SHARED_POINTERS(CInteractionOpenableClose);
 
 
 // ***
@@ -216,42 +191,20 @@ struct IInteractionLockable
 };
 
 
-class CInteractionLockableLock : public IInteraction
+class CInteractionLockableLock : public TInteraction<IInteractionLockable>
 {
 public:
-	CInteractionLockableLock(IInteractionLockable* subject, bool isEnabled = true, bool isHidden = false)
-		: m_subject(subject)
-	{
-		m_isEnabled = isEnabled;
-		m_isHidden = isHidden;
-	};
-
 	const string GetVerb() const override { return "interaction_lockable_lock"; };
-	void OnInteractionStart(IActorComponent& actor) override { m_subject->OnInteractionLockableLock(actor); };
-
-private:
-	IInteractionLockable* m_subject { nullptr };
+	void OnInteractionStart(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionLockableLock(actor); };
 };
-DECLARE_SHARED_POINTERS(CInteractionLockableLock);
 
 
-class CInteractionLockableUnlock : public IInteraction
+class CInteractionLockableUnlock : public TInteraction<IInteractionLockable>
 {
 public:
-	CInteractionLockableUnlock(IInteractionLockable* subject, bool isEnabled = true, bool isHidden = false)
-		: m_subject(subject)
-	{
-		m_isEnabled = isEnabled;
-		m_isHidden = isHidden;
-	};
-
 	const string GetVerb() const override { return "interaction_lockable_unlock"; };
-	void OnInteractionStart(IActorComponent& actor) override { m_subject->OnInteractionLockableUnlock(actor); };
-
-private:
-	IInteractionLockable* m_subject { nullptr };
+	void OnInteractionStart(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionLockableUnlock(actor); };
 };
-DECLARE_SHARED_POINTERS(CInteractionLockableUnlock);
 
 
 // ***
@@ -268,80 +221,36 @@ struct IInteractionItem
 };
 
 
-class CInteractionItemInspect : public IInteraction
+class CInteractionItemInspect : public TInteraction<IInteractionItem>
 {
 public:
-	CInteractionItemInspect(IInteractionItem* subject, bool isEnabled = true, bool isHidden = false)
-		: m_subject(subject)
-	{
-		m_isEnabled = isEnabled;
-		m_isHidden = isHidden;
-	};
-
 	const string GetVerb() const override { return "interaction_inspect"; };
-	void OnInteractionStart(IActorComponent& actor) override { m_subject->OnInteractionItemInspect(actor); };
-
-private:
-	IInteractionItem* m_subject { nullptr };
+	void OnInteractionStart(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionItemInspect(actor); };
 };
-DECLARE_SHARED_POINTERS(CInteractionItemInspect);
 
 
-class CInteractionItemPickup : public IInteraction
+class CInteractionItemPickup : public TInteraction<IInteractionItem>
 {
 public:
-	CInteractionItemPickup(IInteractionItem* subject, bool isEnabled = true, bool isHidden = false)
-		: m_subject(subject)
-	{
-		m_isEnabled = isEnabled;
-		m_isHidden = isHidden;
-	};
-
 	const string GetVerb() const override { return "interaction_pickup"; };
-	void OnInteractionStart(IActorComponent& actor) override { m_subject->OnInteractionItemPickup(actor); };
-
-private:
-	IInteractionItem* m_subject { nullptr };
+	void OnInteractionStart(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionItemPickup(actor); };
 };
-DECLARE_SHARED_POINTERS(CInteractionItemPickup);
 
 
-class CInteractionItemDrop : public IInteraction
+class CInteractionItemDrop : public TInteraction<IInteractionItem>
 {
 public:
-	CInteractionItemDrop(IInteractionItem* subject, bool isEnabled = true, bool isHidden = false)
-		: m_subject(subject)
-	{
-		m_isEnabled = isEnabled;
-		m_isHidden = isHidden;
-	};
-
 	const string GetVerb() const override { return "interaction_drop"; };
-	void OnInteractionStart(IActorComponent& actor) override { m_subject->OnInteractionItemDrop(actor); };
-
-private:
-	IInteractionItem* m_subject { nullptr };
+	void OnInteractionStart(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionItemDrop(actor); };
 };
-DECLARE_SHARED_POINTERS(CInteractionItemDrop);
 
 
-class CInteractionItemToss : public IInteraction
+class CInteractionItemToss : public TInteraction<IInteractionItem>
 {
 public:
-	CInteractionItemToss(IInteractionItem* subject, bool isEnabled = true, bool isHidden = false)
-		: m_subject(subject)
-	{
-		m_isEnabled = isEnabled;
-		m_isHidden = isHidden;
-	};
-
 	const string GetVerb() const override { return "interaction_toss"; };
-	void OnInteractionStart(IActorComponent& actor) override { m_subject->OnInteractionItemToss(actor); };
-
-private:
-	IInteractionItem* m_subject { nullptr };
+	void OnInteractionStart(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionItemToss(actor); };
 };
-DECLARE_SHARED_POINTERS(CInteractionItemToss);
 
 
 // ***
@@ -355,24 +264,13 @@ struct IInteractionExamine
 };
 
 
-class CInteractionExamine : public IInteraction
+class CInteractionExamine : public TInteraction<IInteractionExamine>
 {
 public:
-	CInteractionExamine(IInteractionExamine* subject, bool isEnabled = true, bool isHidden = false)
-		: m_subject(subject)
-	{
-		m_isEnabled = isEnabled;
-		m_isHidden = isHidden;
-	};
-
 	const string GetVerb() const override { return "interaction_examine"; };
-	void OnInteractionStart(IActorComponent& actor) override { m_subject->OnInteractionExamineStart(actor); };
-	void OnInteractionComplete(IActorComponent& actor) override { m_subject->OnInteractionExamineComplete(actor); };
-
-private:
-	IInteractionExamine* m_subject { nullptr };
+	void OnInteractionStart(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionExamineStart(actor); };
+	void OnInteractionComplete(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionExamineComplete(actor); };
 };
-DECLARE_SHARED_POINTERS(CInteractionExamine);
 
 
 // ***
@@ -385,21 +283,10 @@ struct IInteractionDRS
 };
 
 
-class CInteractionDRS : public IInteraction
+class CInteractionDRS : public TInteraction<IInteractionDRS>
 {
 public:
-	CInteractionDRS(IInteractionDRS* subject, bool isEnabled = true, bool isHidden = false)
-		: m_subject(subject)
-	{
-		m_isEnabled = isEnabled;
-		m_isHidden = isHidden;
-	};
-
 	const string GetVerb() const override { return "interaction_drs"; };
-	void OnInteractionStart(IActorComponent& actor) override { m_subject->OnInteractionDRS(); };
-
-private:
-	IInteractionDRS* m_subject { nullptr };
+	void OnInteractionStart(void* pSubject, IActorComponent& actor) const override { GetSubject(pSubject).OnInteractionDRS(); };
 };
-DECLARE_SHARED_POINTERS(CInteractionDRS);
 }
\ No newline at end of file
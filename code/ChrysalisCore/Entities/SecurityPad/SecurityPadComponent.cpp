@@ -35,7 +35,7 @@ void CSecurityPadComponent::Initialize()
 	m_interactor = GetEntity()->GetOrCreateComponent<CEntityInteractionComponent>();
 	if (m_interactor)
 	{
-		m_interactor->AddInteraction(std::make_shared<CInteractionExamine>(this));
+		m_interactor->AddInteraction<CInteractionExamine>(this);
 	}
 }
 
@@ -1,34 +1,114 @@
 #include <StdAfx.h>
 
 #include "GameCache.h"
+#include "GameCacheManifest.h"
 #include <CryEntitySystem/IEntitySystem.h>
 #include <CryAnimation/ICryAnimation.h>
 #include "Item/Parameters/ItemParameter.h"
 #include <CryString/StringUtils.h>
+#include <Console/CVars.h>
+#include <limits>
 
 
 namespace Chrysalis
 {
+/** Approximate the memory held by an asset by asking it to report itself to a sizer. */
+template<typename TAsset>
+static size_t GetSizerBytes(const TAsset* pAsset)
+{
+	size_t bytes { 0 };
+
+	if (ICrySizer* pSizer = gEnv->pSystem->CreateSizer())
+	{
+		pAsset->GetMemoryUsage(pSizer);
+		bytes = pSizer->GetTotalSize();
+		pSizer->Release();
+	}
+
+	return bytes;
+}
+
+
+static size_t GetResidentBytes(IStatObj* pStaticObject)
+{
+	IStatObj::SStatistics statistics;
+	pStaticObject->GetStatistics(statistics);
+
+	return static_cast<size_t>(statistics.nMeshSize + statistics.nPhysProxySize);
+}
+
+
+static size_t GetResidentBytes(const ITexture* pTexture)
+{
+	return pTexture->GetDataSize();
+}
+
+
+/** Converts a budget CVar in megabytes into bytes. A budget of zero or less means there is no limit. */
+static size_t GetBudgetBytes(int budgetMB)
+{
+	return budgetMB > 0 ? static_cast<size_t>(budgetMB) * 1024 * 1024 : std::numeric_limits<size_t>::max();
+}
+
+
+static void LogCacheStatistics(const char* name, size_t entries, size_t pinned, size_t tableBytes, uint32 hits, uint32 misses,
+	uint32 evictions, size_t residentBytes, int budgetMB)
+{
+	const uint32 lookups = hits + misses;
+	const float hitRate = lookups > 0 ? 100.0f * static_cast<float>(hits) / static_cast<float>(lookups) : 0.0f;
+
+	CryLogAlways("%-16s entries: %5" PRISIZE_T "  pinned: %4" PRISIZE_T "  hits: %7u  misses: %7u  hit rate: %5.1f%%  evictions: %5u  resident: %8" PRISIZE_T " KB / %d MB  table: %6" PRISIZE_T " KB",
+		name, entries, pinned, hits, misses, hitRate, evictions, residentBytes / 1024, budgetMB, tableBytes / 1024);
+}
+
+
 CGameCache::CGameCache()
+	: m_pLevelPinScope(new CPinScope(*this)),
+	m_pManifest(new CGameCacheManifest)
 {}
 
 
 CGameCache::~CGameCache()
 {
+	// The scope releases its pins from the pin maps, which are destroyed before it would be.
+	m_pLevelPinScope.reset();
 }
 
 
 void CGameCache::Init()
 {
+	// The manifest is optional. Without it assets are simply loaded the first time they're needed.
+	if (LoadManifest(CGameCacheManifest::DefaultFileName))
+	{
+		CryLog("Game cache manifest loaded with %" PRISIZE_T " item classes and %" PRISIZE_T " assets.",
+			m_pManifest->GetItems().size(), m_pManifest->GetAssets().size());
+	}
 }
 
 
 void CGameCache::Reset()
 {
-	m_textureCache.clear();
-	m_materialCache.clear();
-	m_statiObjectCache.clear();
-	m_particleEffectCache.clear();
+	m_pLevelPinScope->Release();
+
+	// Anything still waiting to load is no longer wanted.
+	for (auto& queue : m_requestQueues)
+	{
+		for (auto& pRequest : queue)
+			pRequest->state = ERequestState::Cancelled;
+
+		queue.clear();
+	}
+
+	// Pins held by scopes other than the level scope are dropped along with everything else. Those scopes should be
+	// released before the cache is reset.
+	m_textureCache.Clear();
+	m_materialCache.Clear();
+	m_statiObjectCache.Clear();
+	m_particleEffectCache.Clear();
+	m_pinnedTextures.Clear();
+	m_pinnedMaterials.Clear();
+	m_pinnedGeometry.Clear();
+	m_pinnedParticleEffects.Clear();
 }
 
 
@@ -36,10 +116,491 @@ void CGameCache::GetMemoryUsage(ICrySizer *s) const
 {
 	s->Add(*this);
 
-	s->AddContainer(m_textureCache);
-	s->AddContainer(m_materialCache);
-	s->AddContainer(m_statiObjectCache);
-	s->AddContainer(m_particleEffectCache);
+	{
+		SIZER_COMPONENT_NAME(s, "Textures");
+		m_textureCache.GetMemoryUsage(s);
+		m_pinnedTextures.GetMemoryUsage(s);
+	}
+	{
+		SIZER_COMPONENT_NAME(s, "Materials");
+		m_materialCache.GetMemoryUsage(s);
+		m_pinnedMaterials.GetMemoryUsage(s);
+	}
+	{
+		SIZER_COMPONENT_NAME(s, "Geometry");
+		m_statiObjectCache.GetMemoryUsage(s);
+		m_pinnedGeometry.GetMemoryUsage(s);
+	}
+	{
+		SIZER_COMPONENT_NAME(s, "Particle effects");
+		m_particleEffectCache.GetMemoryUsage(s);
+		m_pinnedParticleEffects.GetMemoryUsage(s);
+	}
+
+	for (const auto& queue : m_requestQueues)
+		s->AddContainer(queue);
+}
+
+
+void CGameCache::LogStatistics() const
+{
+	auto logCache = [](const char* name, const auto& cache, const auto& pins, int budgetMB)
+	{
+		const auto& statistics = cache.GetStatistics();
+		LogCacheStatistics(name, cache.Size(), pins.Size(), cache.GetTableBytes(), statistics.hits, statistics.misses,
+			statistics.evictions, statistics.residentBytes, budgetMB);
+	};
+
+	CryLogAlways("Game cache statistics:");
+	logCache("Geometry", m_statiObjectCache, m_pinnedGeometry, g_cvars.m_gameCacheBudgetGeometry);
+	logCache("Textures", m_textureCache, m_pinnedTextures, g_cvars.m_gameCacheBudgetTextures);
+	logCache("Materials", m_materialCache, m_pinnedMaterials, g_cvars.m_gameCacheBudgetMaterials);
+	logCache("Particle effects", m_particleEffectCache, m_pinnedParticleEffects, g_cvars.m_gameCacheBudgetParticleEffects);
+	CryLogAlways("Queued requests: %" PRISIZE_T, GetQueuedRequestCount());
+}
+
+
+void CGameCache::ResetStatistics() const
+{
+	m_statiObjectCache.ResetStatistics();
+	m_textureCache.ResetStatistics();
+	m_materialCache.ResetStatistics();
+	m_particleEffectCache.ResetStatistics();
+}
+
+
+void CGameCache::Update()
+{
+	EnforceBudgets();
+
+	// Requests are serviced in priority order until we run out of time for this frame. We always service at least one
+	// request per frame so a small budget can't starve the queue entirely.
+	const CTimeValue startTime = gEnv->pTimer->GetAsyncTime();
+	const float budgetMS = g_cvars.m_gameCacheStreamingBudget;
+	bool isFirstRequest = true;
+
+	for (int priority = static_cast<int>(ERequestPriority::COUNT) - 1; priority >= 0; --priority)
+	{
+		auto& queue = m_requestQueues [priority];
+
+		while (!queue.empty())
+		{
+			if (!isFirstRequest && ((gEnv->pTimer->GetAsyncTime() - startTime).GetMilliSeconds() >= budgetMS))
+				return;
+
+			// Pop before servicing, the callback is free to queue more requests.
+			TRequestPtr pRequest = queue.front();
+			queue.pop_front();
+
+			ServiceRequest(*pRequest);
+			isFirstRequest = false;
+		}
+	}
+}
+
+
+// ***
+// *** Streaming Requests
+// ***
+
+
+CGameCache::ERequestState CGameCache::CRequestHandle::Wait() const
+{
+	if (m_pRequest && (m_pRequest->state == ERequestState::Queued) && m_pRequest->pOwner)
+	{
+		// Keep the request alive while it's pulled out of the queue and serviced.
+		TRequestPtr pRequest = m_pRequest;
+		if (pRequest->pOwner->RemoveRequest(*pRequest))
+			pRequest->pOwner->ServiceRequest(*pRequest);
+	}
+
+	return GetState();
+}
+
+
+void CGameCache::CRequestHandle::Cancel() const
+{
+	if (m_pRequest && (m_pRequest->state == ERequestState::Queued) && m_pRequest->pOwner)
+	{
+		if (m_pRequest->pOwner->RemoveRequest(*m_pRequest))
+			m_pRequest->state = ERequestState::Cancelled;
+	}
+}
+
+
+CGameCache::CRequestHandle CGameCache::RequestGeometry(const char* geometryFileName, ERequestPriority priority, TRequestCallback callback)
+{
+	return QueueRequest(EAssetType::Geometry, geometryFileName, 0, priority, std::move(callback));
+}
+
+
+CGameCache::CRequestHandle CGameCache::RequestTexture(const char* textureFileName, const int textureFlags, ERequestPriority priority, TRequestCallback callback)
+{
+	return QueueRequest(EAssetType::Texture, textureFileName, textureFlags, priority, std::move(callback));
+}
+
+
+CGameCache::CRequestHandle CGameCache::RequestMaterial(const char* materialFileName, ERequestPriority priority, TRequestCallback callback)
+{
+	return QueueRequest(EAssetType::Material, materialFileName, 0, priority, std::move(callback));
+}
+
+
+CGameCache::CRequestHandle CGameCache::RequestParticleEffect(const char* particleEffectFileName, ERequestPriority priority, TRequestCallback callback)
+{
+	return QueueRequest(EAssetType::ParticleEffect, particleEffectFileName, 0, priority, std::move(callback));
+}
+
+
+void CGameCache::FlushRequests()
+{
+	for (int priority = static_cast<int>(ERequestPriority::COUNT) - 1; priority >= 0; --priority)
+	{
+		auto& queue = m_requestQueues [priority];
+
+		while (!queue.empty())
+		{
+			TRequestPtr pRequest = queue.front();
+			queue.pop_front();
+
+			ServiceRequest(*pRequest);
+		}
+	}
+}
+
+
+size_t CGameCache::GetQueuedRequestCount() const
+{
+	size_t count = 0;
+
+	for (const auto& queue : m_requestQueues)
+		count += queue.size();
+
+	return count;
+}
+
+
+CGameCache::CRequestHandle CGameCache::QueueRequest(EAssetType assetType, const char* fileName, int textureFlags, ERequestPriority priority, TRequestCallback&& callback,
+	bool isWarmup)
+{
+	CRY_ASSERT(priority < ERequestPriority::COUNT);
+
+	auto pRequest = std::make_shared<SRequest>();
+	pRequest->pOwner = this;
+	pRequest->assetType = assetType;
+	pRequest->textureFlags = textureFlags;
+	pRequest->priority = priority;
+	pRequest->isWarmup = isWarmup;
+	pRequest->callback = std::move(callback);
+
+	if (fileName && fileName [0])
+	{
+		pRequest->fileName = fileName;
+		m_requestQueues [static_cast<size_t>(priority)].push_back(pRequest);
+	}
+	else
+	{
+		// There's nothing to load, so fail the request right away rather than waste a slot in the queue.
+		pRequest->state = ERequestState::Failed;
+		if (pRequest->callback)
+			pRequest->callback(*pRequest);
+	}
+
+	return CRequestHandle(pRequest);
+}
+
+
+void CGameCache::ServiceRequest(SRequest& request)
+{
+	if (request.isWarmup && IsAtBudget(request.assetType))
+	{
+		request.state = ERequestState::Cancelled;
+
+		if (request.callback)
+			request.callback(request);
+
+		return;
+	}
+
+	bool isLoaded { false };
+
+	switch (request.assetType)
+	{
+		case EAssetType::Geometry:
+			isLoaded = CacheGeometry(request.fileName.c_str());
+			break;
+
+		case EAssetType::Texture:
+			isLoaded = CacheTexture(request.fileName.c_str(), request.textureFlags);
+			break;
+
+		case EAssetType::Material:
+			isLoaded = CacheMaterial(request.fileName.c_str());
+			break;
+
+		case EAssetType::ParticleEffect:
+			isLoaded = CacheParticleEffect(request.fileName.c_str());
+			break;
+	}
+
+	request.state = isLoaded ? ERequestState::Loaded : ERequestState::Failed;
+
+	if (request.callback)
+		request.callback(request);
+}
+
+
+bool CGameCache::RemoveRequest(const SRequest& request)
+{
+	auto& queue = m_requestQueues [static_cast<size_t>(request.priority)];
+	auto it = std::find_if(queue.begin(), queue.end(), [&request](const TRequestPtr& pRequest) { return pRequest.get() == &request; });
+
+	if (it != queue.end())
+	{
+		queue.erase(it);
+		return true;
+	}
+
+	return false;
+}
+
+
+// ***
+// *** Residency
+// ***
+
+
+template<typename TKey, typename THash>
+void CGameCache::AddPin(CGameCacheMap<TKey, uint32, THash>& pins, const TKey& key)
+{
+	if (auto pCount = pins.Peek(key))
+		++*pCount;
+	else
+		pins.Insert(key, 1, 0);
+}
+
+
+template<typename TKey, typename THash>
+void CGameCache::RemovePin(CGameCacheMap<TKey, uint32, THash>& pins, const TKey& key)
+{
+	if (auto pCount = pins.Peek(key))
+	{
+		if (--*pCount == 0)
+			pins.Erase(key);
+	}
+}
+
+
+void CGameCache::CPinScope::PinGeometry(const char* geometryFileName)
+{
+	if (geometryFileName && geometryFileName [0])
+	{
+		const CryHash key = GetKey(geometryFileName);
+		AddPin(m_gameCache.m_pinnedGeometry, key);
+		m_geometry.push_back(key);
+
+		if (!m_gameCache.m_statiObjectCache.Contains(key))
+			m_gameCache.RequestGeometry(geometryFileName, ERequestPriority::High);
+	}
+}
+
+
+void CGameCache::CPinScope::PinTexture(const char* textureFileName, const int textureFlags)
+{
+	if (textureFileName && textureFileName [0])
+	{
+		const STextureKey key(GetKey(textureFileName), textureFlags);
+		AddPin(m_gameCache.m_pinnedTextures, key);
+		m_textures.push_back(key);
+
+		if (!m_gameCache.m_textureCache.Contains(key))
+			m_gameCache.RequestTexture(textureFileName, textureFlags, ERequestPriority::High);
+	}
+}
+
+
+void CGameCache::CPinScope::PinMaterial(const char* materialFileName)
+{
+	if (materialFileName && materialFileName [0])
+	{
+		const CryHash key = GetKey(materialFileName);
+		AddPin(m_gameCache.m_pinnedMaterials, key);
+		m_materials.push_back(key);
+
+		if (!m_gameCache.m_materialCache.Contains(key))
+			m_gameCache.RequestMaterial(materialFileName, ERequestPriority::High);
+	}
+}
+
+
+void CGameCache::CPinScope::PinParticleEffect(const char* particleEffectFileName)
+{
+	if (particleEffectFileName && particleEffectFileName [0])
+	{
+		const CryHash key = GetKey(particleEffectFileName);
+		AddPin(m_gameCache.m_pinnedParticleEffects, key);
+		m_particleEffects.push_back(key);
+
+		if (!m_gameCache.m_particleEffectCache.Contains(key))
+			m_gameCache.RequestParticleEffect(particleEffectFileName, ERequestPriority::High);
+	}
+}
+
+
+void CGameCache::CPinScope::Release()
+{
+	for (const auto& key : m_geometry)
+		RemovePin(m_gameCache.m_pinnedGeometry, key);
+
+	for (const auto& key : m_textures)
+		RemovePin(m_gameCache.m_pinnedTextures, key);
+
+	for (const auto& key : m_materials)
+		RemovePin(m_gameCache.m_pinnedMaterials, key);
+
+	for (const auto& key : m_particleEffects)
+		RemovePin(m_gameCache.m_pinnedParticleEffects, key);
+
+	m_geometry.clear();
+	m_textures.clear();
+	m_materials.clear();
+	m_particleEffects.clear();
+}
+
+
+void CGameCache::EnforceBudgets()
+{
+	m_statiObjectCache.EvictLeastRecentlyUsed(GetBudgetBytes(g_cvars.m_gameCacheBudgetGeometry),
+		[this](const CryHash& key) { return m_pinnedGeometry.Contains(key); });
+
+	m_textureCache.EvictLeastRecentlyUsed(GetBudgetBytes(g_cvars.m_gameCacheBudgetTextures),
+		[this](const STextureKey& key) { return m_pinnedTextures.Contains(key); });
+
+	m_materialCache.EvictLeastRecentlyUsed(GetBudgetBytes(g_cvars.m_gameCacheBudgetMaterials),
+		[this](const CryHash& key) { return m_pinnedMaterials.Contains(key); });
+
+	m_particleEffectCache.EvictLeastRecentlyUsed(GetBudgetBytes(g_cvars.m_gameCacheBudgetParticleEffects),
+		[this](const CryHash& key) { return m_pinnedParticleEffects.Contains(key); });
+}
+
+
+void CGameCache::Flush()
+{
+	m_statiObjectCache.EvictUnpinned([this](const CryHash& key) { return m_pinnedGeometry.Contains(key); });
+	m_textureCache.EvictUnpinned([this](const STextureKey& key) { return m_pinnedTextures.Contains(key); });
+	m_materialCache.EvictUnpinned([this](const CryHash& key) { return m_pinnedMaterials.Contains(key); });
+	m_particleEffectCache.EvictUnpinned([this](const CryHash& key) { return m_pinnedParticleEffects.Contains(key); });
+}
+
+
+// ***
+// *** Item Manifest
+// ***
+
+
+bool CGameCache::LoadManifest(const char* manifestFileName)
+{
+	return m_pManifest->Read(manifestFileName);
+}
+
+
+uint32 CGameCache::WarmupManifest(ERequestPriority priority)
+{
+	const auto& assets = m_pManifest->GetAssets();
+	uint32 queued { 0 };
+
+	// Geometry first, since it will often pull in its own materials and textures and save us the trouble.
+	const EAssetType batchOrder [] = { EAssetType::Geometry, EAssetType::Material, EAssetType::Texture, EAssetType::ParticleEffect };
+
+	for (const EAssetType assetType : batchOrder)
+	{
+		for (const auto& asset : assets)
+		{
+			if ((asset.assetType == assetType) && !IsResident(asset.assetType, asset.path, asset.textureFlags))
+			{
+				QueueRequest(asset.assetType, asset.path, asset.textureFlags, priority, nullptr, true);
+				++queued;
+			}
+		}
+	}
+
+	return queued;
+}
+
+
+uint32 CGameCache::WarmupItemClass(const char* itemClass, ERequestPriority priority)
+{
+	const CGameCacheManifest::SItem* pItem = m_pManifest->FindItem(itemClass);
+	if (!pItem)
+		return 0;
+
+	const auto& assets = m_pManifest->GetAssets();
+	uint32 queued { 0 };
+
+	for (const uint32 index : pItem->assets)
+	{
+		const auto& asset = assets [index];
+		if (!IsResident(asset.assetType, asset.path, asset.textureFlags))
+		{
+			QueueRequest(asset.assetType, asset.path, asset.textureFlags, priority, nullptr);
+			++queued;
+		}
+	}
+
+	return queued;
+}
+
+
+bool CGameCache::IsAtBudget(EAssetType assetType) const
+{
+	switch (assetType)
+	{
+		case EAssetType::Geometry:
+			return m_statiObjectCache.GetStatistics().residentBytes >= GetBudgetBytes(g_cvars.m_gameCacheBudgetGeometry);
+
+		case EAssetType::Texture:
+			return m_textureCache.GetStatistics().residentBytes >= GetBudgetBytes(g_cvars.m_gameCacheBudgetTextures);
+
+		case EAssetType::Material:
+			return m_materialCache.GetStatistics().residentBytes >= GetBudgetBytes(g_cvars.m_gameCacheBudgetMaterials);
+
+		case EAssetType::ParticleEffect:
+			return m_particleEffectCache.GetStatistics().residentBytes >= GetBudgetBytes(g_cvars.m_gameCacheBudgetParticleEffects);
+	}
+
+	return false;
+}
+
+
+bool CGameCache::IsResident(EAssetType assetType, const char* fileName, int textureFlags) const
+{
+	const CryHash key = GetKey(fileName);
+
+	switch (assetType)
+	{
+		case EAssetType::Geometry:
+		{
+			// Character models are held by the character manager rather than the static object cache.
+			if (IsCharacterFileModel(fileName))
+			{
+				uint32 fileNameHash;
+				return IsCharacterFileModelCached(fileName, fileNameHash);
+			}
+
+			return m_statiObjectCache.Contains(key);
+		}
+
+		case EAssetType::Texture:
+			return m_textureCache.Contains(STextureKey(key, textureFlags));
+
+		case EAssetType::Material:
+			return m_materialCache.Contains(key);
+
+		case EAssetType::ParticleEffect:
+			return m_particleEffectCache.Contains(key);
+	}
+
+	return false;
 }
 
 
@@ -66,10 +627,9 @@ bool CGameCache::AddCachedCharacterFileModel(const ECharacterFileModelCacheType
 		}
 		else
 		{
-			bool hasLoaded = gEnv->pCharacterManager->LoadAndLockResources(szFileName, 0);
-			if (hasLoaded)
-			{
-			}
+			bCached = gEnv->pCharacterManager->LoadAndLockResources(szFileName, 0);
+			if (bCached)
+				m_lockedCharacterFileModels.insert(fileNameHash);
 		}
 	}
 
@@ -77,6 +637,14 @@ bool CGameCache::AddCachedCharacterFileModel(const ECharacterFileModelCacheType
 }
 
 
+bool CGameCache::IsCharacterFileModel(const char* szFileName)
+{
+	stack_string ext(PathUtil::GetExt(szFileName));
+
+	return (ext == "cdf") || (ext == "chr") || (ext == "cga");
+}
+
+
 ILINE bool CGameCache::IsCharacterFileModelCached(const char* szFileName, uint32& outputFileNameHash) const
 {
 	outputFileNameHash = 0;
@@ -96,6 +664,10 @@ ILINE bool CGameCache::IsCharacterFileModelCached(const char* szFileName, uint32
 				return true;
 			}
 		}
+		else
+		{
+			return m_lockedCharacterFileModels.find(outputFileNameHash) != m_lockedCharacterFileModels.end();
+		}
 	}
 
 	return false;
@@ -107,31 +679,41 @@ ILINE bool CGameCache::IsCharacterFileModelCached(const char* szFileName, uint32
 // ***
 
 
-void CGameCache::CacheGeometry(const char* geometryFileName)
+bool CGameCache::CacheGeometry(const char* geometryFileName)
 {
 	const bool validName = (geometryFileName && geometryFileName [0]);
 	if (validName)
 	{
-		stack_string ext(PathUtil::GetExt(geometryFileName));
-
-		if ((ext == "cdf") || (ext == "chr") || (ext == "cga"))
+		if (IsCharacterFileModel(geometryFileName))
 		{
-			AddCachedCharacterFileModel(eCFMCache_Default, geometryFileName);
+			return AddCachedCharacterFileModel(eCFMCache_Default, geometryFileName);
 		}
 		else
 		{
 			const CryHash hashName = CryStringUtils::HashString(geometryFileName);
 
-			if (m_statiObjectCache.find(hashName) == m_statiObjectCache.end())
+			if (m_statiObjectCache.Find(hashName))
+				return true;
+
+			IStatObj* pStaticObject = gEnv->p3DEngine->LoadStatObj(geometryFileName);
+			if (pStaticObject)
 			{
-				IStatObj* pStaticObject = gEnv->p3DEngine->LoadStatObj(geometryFileName);
-				if (pStaticObject)
-				{
-					m_statiObjectCache.insert(TGameStaticObjectCacheMap::value_type(hashName, TStaticObjectSmartPtr(pStaticObject)));
-				}
+				m_statiObjectCache.Insert(hashName, TStaticObjectSmartPtr(pStaticObject), GetResidentBytes(pStaticObject));
+				return true;
 			}
 		}
 	}
+
+	return false;
+}
+
+
+CGameCache::TStaticObjectSmartPtr CGameCache::GetGeometry(CryHash geometryKey) const
+{
+	if (auto pStaticObject = m_statiObjectCache.Find(geometryKey))
+		return *pStaticObject;
+
+	return nullptr;
 }
 
 
@@ -140,7 +722,7 @@ void CGameCache::CacheGeometry(const char* geometryFileName)
 // ***
 
 
-void CGameCache::CacheTexture(const char* textureFileName, const int textureFlags)
+bool CGameCache::CacheTexture(const char* textureFileName, const int textureFlags)
 {
 	const bool validName = (textureFileName && textureFileName [0]);
 
@@ -148,16 +730,28 @@ void CGameCache::CacheTexture(const char* textureFileName, const int textureFlag
 	{
 		const STextureKey textureKey(CryStringUtils::HashString(textureFileName), textureFlags);
 
-		if (m_textureCache.find(textureKey) == m_textureCache.end())
+		if (m_textureCache.Find(textureKey))
+			return true;
+
+		ITexture* pTexture = gEnv->pRenderer->EF_LoadTexture(textureFileName, textureFlags);
+		if (pTexture)
 		{
-			ITexture* pTexture = gEnv->pRenderer->EF_LoadTexture(textureFileName, textureFlags);
-			if (pTexture)
-			{
-				m_textureCache.insert(TGameTextureCacheMap::value_type(textureKey, TTextureSmartPtr(pTexture)));
-				pTexture->Release();
-			}
+			m_textureCache.Insert(textureKey, TTextureSmartPtr(pTexture), GetResidentBytes(pTexture));
+			pTexture->Release();
+			return true;
 		}
 	}
+
+	return false;
+}
+
+
+CGameCache::TTextureSmartPtr CGameCache::GetTexture(const STextureKey& textureKey) const
+{
+	if (auto pTexture = m_textureCache.Find(textureKey))
+		return *pTexture;
+
+	return nullptr;
 }
 
 
@@ -166,7 +760,7 @@ void CGameCache::CacheTexture(const char* textureFileName, const int textureFlag
 // ***
 
 
-void CGameCache::CacheMaterial(const char* materialFileName)
+bool CGameCache::CacheMaterial(const char* materialFileName)
 {
 	const bool validName = (materialFileName && materialFileName [0]);
 
@@ -174,29 +768,25 @@ void CGameCache::CacheMaterial(const char* materialFileName)
 	{
 		const CryHash hashName = CryStringUtils::HashString(materialFileName);
 
-		if (m_materialCache.find(hashName) == m_materialCache.end())
+		if (m_materialCache.Find(hashName))
+			return true;
+
+		IMaterial* pMaterial = gEnv->p3DEngine->GetMaterialManager()->LoadMaterial(materialFileName);
+		if (pMaterial)
 		{
-			IMaterial* pMaterial = gEnv->p3DEngine->GetMaterialManager()->LoadMaterial(materialFileName);
-			if (pMaterial)
-			{
-				m_materialCache.insert(TGameMaterialCacheMap::value_type(hashName, TMaterialSmartPtr(pMaterial)));
-			}
+			m_materialCache.Insert(hashName, TMaterialSmartPtr(pMaterial), GetSizerBytes(pMaterial));
+			return true;
 		}
 	}
+
+	return false;
 }
 
 
-CGameCache::TMaterialSmartPtr CGameCache::GetMaterial(const char* materialFileName) const
+CGameCache::TMaterialSmartPtr CGameCache::GetMaterial(CryHash materialKey) const
 {
-	const bool validName = (materialFileName && materialFileName [0]);
-
-	if (validName)
-	{
-		const CryHash hashName = CryStringUtils::HashString(materialFileName);
-		auto it = m_materialCache.find(hashName);
-		if (it != m_materialCache.end())
-			return it->second;
-	}
+	if (auto pMaterial = m_materialCache.Find(materialKey))
+		return *pMaterial;
 
 	return nullptr;
 }
@@ -207,7 +797,7 @@ CGameCache::TMaterialSmartPtr CGameCache::GetMaterial(const char* materialFileNa
 // ***
 
 
-void CGameCache::CacheParticleEffect(const char* particleEffectFileName)
+bool CGameCache::CacheParticleEffect(const char* particleEffectFileName)
 {
 	const bool validName = (particleEffectFileName && particleEffectFileName [0]);
 
@@ -215,29 +805,25 @@ void CGameCache::CacheParticleEffect(const char* particleEffectFileName)
 	{
 		const CryHash hashName = CryStringUtils::HashString(particleEffectFileName);
 
-		if (m_particleEffectCache.find(hashName) == m_particleEffectCache.end())
+		if (m_particleEffectCache.Find(hashName))
+			return true;
+
+		IParticleEffect* pParticleEffect = gEnv->p3DEngine->GetParticleManager()->FindEffect(particleEffectFileName, "CGameCache::CacheParticleEffect");
+		if (pParticleEffect)
 		{
-			IParticleEffect* pParticleEffect = gEnv->p3DEngine->GetParticleManager()->FindEffect(particleEffectFileName, "CGameCache::CacheParticleEffect");
-			if (pParticleEffect)
-			{
-				m_particleEffectCache.insert(TGameParticleEffectCacheMap::value_type(hashName, TParticleEffectSmartPtr(pParticleEffect)));
-			}
+			m_particleEffectCache.Insert(hashName, TParticleEffectSmartPtr(pParticleEffect), GetSizerBytes(pParticleEffect));
+			return true;
 		}
 	}
+
+	return false;
 }
 
 
-CGameCache::TParticleEffectSmartPtr CGameCache::GetParticleEffect(const char* particleEffectFileName) const
+CGameCache::TParticleEffectSmartPtr CGameCache::GetParticleEffect(CryHash particleEffectKey) const
 {
-	const bool validName = (particleEffectFileName && particleEffectFileName [0]);
-
-	if (validName)
-	{
-		const CryHash hashName = CryStringUtils::HashString(particleEffectFileName);
-		auto it = m_particleEffectCache.find(hashName);
-		if (it != m_particleEffectCache.end())
-			return it->second;
-	}
+	if (auto pParticleEffect = m_particleEffectCache.Find(particleEffectKey))
+		return *pParticleEffect;
 
 	return nullptr;
 }
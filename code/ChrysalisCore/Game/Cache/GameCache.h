@@ -4,22 +4,30 @@
 Helper for caching information from entities in the pool. Refactored from various caches inside GameSDK.
 
 NOTE: Where possible I have moved from using _smart_ptr to std::shared_ptr. If this causes issues, just switch them back again. I'm simply
-trying to reduce the surface area and dependancies of the code.
+trying to reduce the surface area and dependancies of the code. Materials and particle effects have been switched back, since
+eviction can drop the last reference and the engine must be the one to release them.
+
+Each cache has a byte budget, set by CVar. When a cache grows past its budget the least recently used entries are evicted,
+unless they have been pinned. Use a CPinScope to keep assets resident, e.g. the hero assets for the current level.
 */
 #pragma once
 
+#include <deque>
+#include <functional>
+#include <set>
 #include <Utility/CryHash.h>
+#include "GameCacheMap.h"
 
 
 namespace Chrysalis
 {
 struct CItemParameter;
+class CGameCacheManifest;
 
 
 // TODO: Add more caches, and ability to query for items in the caches.
 // TODO: Implement material loading for geometry cache. See ItemResourceCache for how.
 // TODO: Add animation cache.
-// TODO: Flush caches.
 
 class CGameCache
 {
@@ -40,7 +48,7 @@ public:
 	void Init();
 
 
-	/** Resets this object. */
+	/** Resets this object. All entries are released, including pinned ones. */
 	void Reset();
 
 
@@ -53,6 +61,353 @@ public:
 	void GetMemoryUsage(ICrySizer *s) const;
 
 
+	/** Writes the hit / miss and memory statistics for each of the caches to the log. */
+	void LogStatistics() const;
+
+
+	/** Resets the hit / miss counts for each of the caches. */
+	void ResetStatistics() const;
+
+
+	/**
+	Gets the key used to look up a file in the caches. Callers which look up the same file often should compute this once
+	and use the key based overloads.
+
+	\param	fileName	Filename of the file.
+
+	\return	The key.
+	*/
+	static CryHash GetKey(const char* fileName) { return (fileName && fileName [0]) ? CryStringUtils::HashString(fileName) : 0; }
+
+
+	/** Called once per frame. Services queued load requests within the per-frame streaming budget. */
+	void Update();
+
+
+	// ***
+	// *** Streaming Requests
+	// ***
+
+public:
+	/** The type of asset a request is for. */
+	enum class EAssetType : uint8
+	{
+		Geometry,
+		Texture,
+		Material,
+		ParticleEffect,
+	};
+
+
+	/** Requests with a higher priority are always serviced before those with a lower priority. */
+	enum class ERequestPriority : uint8
+	{
+		Low,
+		Normal,
+		High,
+		COUNT,
+	};
+
+
+	enum class ERequestState : uint8
+	{
+		/** Waiting in the queue for its turn to load. */
+		Queued,
+
+		/** The asset is now resident in the cache. */
+		Loaded,
+
+		/** The asset could not be loaded. */
+		Failed,
+
+		/** The request was cancelled before it was serviced. */
+		Cancelled,
+	};
+
+
+	struct SRequest;
+
+	/** Called on the main thread once a request is no longer queued. The request state indicates the outcome. */
+	typedef std::function<void(const SRequest& request)> TRequestCallback;
+
+
+	struct SRequest
+	{
+		/** The cache which owns the queue this request was placed in. */
+		CGameCache* pOwner { nullptr };
+
+		/** The file to load. */
+		string fileName;
+
+		/** Texture flags, only used for texture requests. */
+		int textureFlags { 0 };
+
+		EAssetType assetType { EAssetType::Geometry };
+		ERequestPriority priority { ERequestPriority::Normal };
+		ERequestState state { ERequestState::Queued };
+
+		/** Queued by WarmupManifest. These are cancelled rather than loaded once their cache is at its budget. */
+		bool isWarmup { false };
+
+		/** Optional callback which is run when the request completes. */
+		TRequestCallback callback;
+	};
+
+	typedef std::shared_ptr<SRequest> TRequestPtr;
+
+
+	/**
+	A lightweight handle to a queued load request. Handles are returned immediately and may be polled each frame, or
+	waited on if the asset is needed right now.
+	*/
+	class CRequestHandle
+	{
+	public:
+		CRequestHandle() = default;
+		explicit CRequestHandle(const TRequestPtr& pRequest) : m_pRequest(pRequest) {}
+
+		bool IsValid() const { return m_pRequest != nullptr; }
+		bool IsDone() const { return !m_pRequest || (m_pRequest->state != ERequestState::Queued); }
+		ERequestState GetState() const { return m_pRequest ? m_pRequest->state : ERequestState::Cancelled; }
+
+
+		/**
+		Forces the request to be serviced immediately if it is still queued. This will block the calling thread for the
+		duration of the load, so it should only be used when the asset is needed this frame.
+
+		\return	The state of the request after the wait.
+		*/
+		ERequestState Wait() const;
+
+
+		/** Removes the request from the queue if it hasn't been serviced yet. The callback is not run. */
+		void Cancel() const;
+
+	private:
+		TRequestPtr m_pRequest;
+	};
+
+
+	/**
+	Queues a geometry file for loading. The load is performed over the next few frames, subject to the streaming budget.
+
+	\param	geometryFileName	Filename of the geometry file.
+	\param	priority			(Optional) The priority.
+	\param	callback			(Optional) A callback to run when the request completes.
+
+	\return	A handle to the request.
+	*/
+	CRequestHandle RequestGeometry(const char* geometryFileName, ERequestPriority priority = ERequestPriority::Normal, TRequestCallback callback = nullptr);
+
+
+	/**
+	Queues a texture file for loading. The load is performed over the next few frames, subject to the streaming budget.
+
+	\param	textureFileName	Filename of the texture file.
+	\param	textureFlags   	The texture flags.
+	\param	priority	   	(Optional) The priority.
+	\param	callback	   	(Optional) A callback to run when the request completes.
+
+	\return	A handle to the request.
+	*/
+	CRequestHandle RequestTexture(const char* textureFileName, const int textureFlags, ERequestPriority priority = ERequestPriority::Normal, TRequestCallback callback = nullptr);
+
+
+	/**
+	Queues a material file for loading. The load is performed over the next few frames, subject to the streaming budget.
+
+	\param	materialFileName	Filename of the material file.
+	\param	priority			(Optional) The priority.
+	\param	callback			(Optional) A callback to run when the request completes.
+
+	\return	A handle to the request.
+	*/
+	CRequestHandle RequestMaterial(const char* materialFileName, ERequestPriority priority = ERequestPriority::Normal, TRequestCallback callback = nullptr);
+
+
+	/**
+	Queues a particle effect for loading. The load is performed over the next few frames, subject to the streaming budget.
+
+	\param	particleEffectFileName	Filename of the particle effect file.
+	\param	priority				(Optional) The priority.
+	\param	callback				(Optional) A callback to run when the request completes.
+
+	\return	A handle to the request.
+	*/
+	CRequestHandle RequestParticleEffect(const char* particleEffectFileName, ERequestPriority priority = ERequestPriority::Normal, TRequestCallback callback = nullptr);
+
+
+	/** Services every queued request immediately, ignoring the streaming budget. */
+	void FlushRequests();
+
+
+	/** Gets the number of requests which are waiting to be serviced. */
+	size_t GetQueuedRequestCount() const;
+
+private:
+	CRequestHandle QueueRequest(EAssetType assetType, const char* fileName, int textureFlags, ERequestPriority priority, TRequestCallback&& callback,
+		bool isWarmup = false);
+
+	/** Query if the cache for an asset type holds as much as its budget allows. */
+	bool IsAtBudget(EAssetType assetType) const;
+
+	/** Performs the actual load for a request, then runs its callback. */
+	void ServiceRequest(SRequest& request);
+
+	/** Removes a request from its queue, if it's present. Returns true if it was found. */
+	bool RemoveRequest(const SRequest& request);
+
+	// One FIFO queue for each priority level.
+	std::deque<TRequestPtr> m_requestQueues [static_cast<size_t>(ERequestPriority::COUNT)];
+
+
+	// ***
+	// *** Residency
+	// ***
+
+public:
+	/** Textures are keyed on both their name and the flags they were loaded with. */
+	struct STextureKey
+	{
+		STextureKey()
+			: nameHash(0)
+			, textureFlags(0)
+		{}
+
+		STextureKey(const CryHash& _nameHash, const int _textureFlags)
+			: nameHash(_nameHash)
+			, textureFlags(_textureFlags)
+		{}
+
+		bool operator==(const STextureKey& rhs) const
+		{
+			return (nameHash == rhs.nameHash) && (textureFlags == rhs.textureFlags);
+		}
+
+		struct hash
+		{
+			uint32 operator()(const STextureKey& key) const
+			{
+				// The name is already hashed, we just need to fold the flags into it.
+				return key.nameHash ^ (static_cast<uint32>(key.textureFlags) * 0x9e3779b1);
+			}
+		};
+
+		CryHash nameHash;
+		int textureFlags;
+	};
+
+
+	/**
+	Pins assets so they are never evicted while the scope is alive. Pinning an asset which isn't resident yet also queues
+	a high priority request for it. Scopes may overlap, an asset stays pinned until every scope which pinned it is
+	released.
+	*/
+	class CPinScope
+	{
+	public:
+		explicit CPinScope(CGameCache& gameCache) : m_gameCache(gameCache) {}
+		~CPinScope() { Release(); }
+
+		CPinScope(const CPinScope&) = delete;
+		CPinScope& operator=(const CPinScope&) = delete;
+
+		void PinGeometry(const char* geometryFileName);
+		void PinTexture(const char* textureFileName, const int textureFlags);
+		void PinMaterial(const char* materialFileName);
+		void PinParticleEffect(const char* particleEffectFileName);
+
+
+		/** Releases every pin held by this scope. The assets remain in the cache until they are evicted. */
+		void Release();
+
+	private:
+		CGameCache& m_gameCache;
+
+		std::vector<CryHash> m_geometry;
+		std::vector<STextureKey> m_textures;
+		std::vector<CryHash> m_materials;
+		std::vector<CryHash> m_particleEffects;
+	};
+
+
+	/**
+	Gets the pin scope for the current level. Anything pinned here is released when the level unloads.
+
+	\return	The level pin scope.
+	*/
+	CPinScope& GetLevelPinScope() { return *m_pLevelPinScope; }
+
+
+	/** Evicts least recently used entries from any cache which is over its budget. This is run each Update. */
+	void EnforceBudgets();
+
+
+	/** Evicts every entry which isn't pinned. */
+	void Flush();
+
+private:
+	typedef CGameCacheMap<CryHash, uint32> TPinCountMap;
+
+	template<typename TKey, typename THash>
+	static void AddPin(CGameCacheMap<TKey, uint32, THash>& pins, const TKey& key);
+
+	template<typename TKey, typename THash>
+	static void RemovePin(CGameCacheMap<TKey, uint32, THash>& pins, const TKey& key);
+
+	std::unique_ptr<CPinScope> m_pLevelPinScope;
+
+
+	// ***
+	// *** Item Manifest
+	// ***
+
+public:
+	/**
+	Reads the item manifest, replacing any which is already loaded. The manifest lists the assets each item class needs
+	so they can be brought in ahead of time.
+
+	\param	manifestFileName	Filename of the manifest file.
+
+	\return	True if it succeeds, false if it fails.
+	*/
+	bool LoadManifest(const char* manifestFileName);
+
+
+	/** Gets the item manifest. It will be empty if none could be loaded. */
+	const CGameCacheManifest& GetManifest() const { return *m_pManifest; }
+
+
+	/**
+	Queues a request for every asset in the manifest that isn't already resident. Requests are grouped by asset type so
+	each loader sees its work in one batch. Call FlushRequests afterwards to complete them immediately, e.g. while the
+	loading screen is up. Requests which reach a cache after it is at its budget are cancelled rather than loaded, since
+	they would only be evicted again on the next update.
+
+	\param	priority	The priority for the requests.
+
+	\return	The number of requests queued.
+	*/
+	uint32 WarmupManifest(ERequestPriority priority = ERequestPriority::Low);
+
+
+	/**
+	Queues a request for every asset a single item class needs that isn't already resident.
+
+	\param	itemClass	The item class.
+	\param	priority 	The priority for the requests.
+
+	\return	The number of requests queued.
+	*/
+	uint32 WarmupItemClass(const char* itemClass, ERequestPriority priority = ERequestPriority::Normal);
+
+private:
+	/** Query if an asset is already in its cache. */
+	bool IsResident(EAssetType assetType, const char* fileName, int textureFlags) const;
+
+	std::unique_ptr<CGameCacheManifest> m_pManifest;
+
+
 	// ***
 	// *** Character Geometry Cache
 	// ***
@@ -72,11 +427,17 @@ public:
 	bool AddCachedCharacterFileModel(const ECharacterFileModelCacheType type, const char* szFileName);
 	bool IsCharacterFileModelCached(const char* szFileName, uint32& outputFileNameHash) const;
 
+	/** True if the file is loaded through the character manager (cdf, chr or cga) rather than as a static object. */
+	static bool IsCharacterFileModel(const char* szFileName);
+
 private:
 	// Character file model cache.
 	typedef std::map<uint32, TCharacterInstancePtr> TEditorCharacterFileModelCache;
 	TEditorCharacterFileModelCache   m_editorCharacterFileModelCache [eCFMCache_COUNT];
 
+	// Outside the editor the character manager holds the resources, we only remember which files have been locked.
+	std::set<uint32> m_lockedCharacterFileModels;
+
 
 	// ***
 	// *** Static Geometry Cache
@@ -85,11 +446,23 @@ private:
 public:
 	typedef _smart_ptr<IStatObj> TStaticObjectSmartPtr;
 
-	void CacheGeometry(const char* geometryObjectFileName);
+	/**
+	Loads a geometry file synchronously on the calling thread and adds it to the cache. Prefer RequestGeometry for
+	anything that happens during gameplay.
+
+	\param	geometryObjectFileName	Filename of the geometry object file.
+
+	\return	True if the geometry is in the cache.
+	*/
+	bool CacheGeometry(const char* geometryObjectFileName);
+
+	TStaticObjectSmartPtr GetGeometry(const char* geometryObjectFileName) const { return GetGeometry(GetKey(geometryObjectFileName)); }
+	TStaticObjectSmartPtr GetGeometry(CryHash geometryKey) const;
 
 private:
-	typedef std::map<CryHash, TStaticObjectSmartPtr> TGameStaticObjectCacheMap;
+	typedef CGameCacheMap<CryHash, TStaticObjectSmartPtr> TGameStaticObjectCacheMap;
 	TGameStaticObjectCacheMap m_statiObjectCache;
+	TPinCountMap m_pinnedGeometry;
 
 
 	// ***
@@ -97,36 +470,18 @@ private:
 	// ***
 
 public:
-	struct STextureKey
-	{
-		STextureKey()
-			: nameHash(0)
-			, textureFlags(0)
-		{}
-
-		STextureKey(const CryHash& _nameHash, const int _textureFlags)
-			: nameHash(_nameHash)
-			, textureFlags(_textureFlags)
-		{}
-
-		struct compare
-		{
-			bool operator()(const STextureKey& k1, const STextureKey& k2) const
-			{
-				return (k1.nameHash < k2.nameHash) || ((k1.nameHash == k2.nameHash) && (k1.textureFlags < k2.textureFlags));
-			}
-		};
+	typedef _smart_ptr<ITexture> TTextureSmartPtr;
 
-		CryHash nameHash;
-		int textureFlags;
-	};
+	/** Loads a texture synchronously on the calling thread. Prefer RequestTexture during gameplay. */
+	bool CacheTexture(const char* textureFileName, const int textureFlags);
 
-	typedef _smart_ptr<ITexture> TTextureSmartPtr;
-	void CacheTexture(const char* textureFileName, const int textureFlags);
+	TTextureSmartPtr GetTexture(const char* textureFileName, const int textureFlags) const { return GetTexture(STextureKey(GetKey(textureFileName), textureFlags)); }
+	TTextureSmartPtr GetTexture(const STextureKey& textureKey) const;
 
 private:
-	typedef	std::map<STextureKey, TTextureSmartPtr, STextureKey::compare> TGameTextureCacheMap;
+	typedef	CGameCacheMap<STextureKey, TTextureSmartPtr, STextureKey::hash> TGameTextureCacheMap;
 	TGameTextureCacheMap m_textureCache;
+	CGameCacheMap<STextureKey, uint32, STextureKey::hash> m_pinnedTextures;
 
 
 	// ***
@@ -134,14 +489,17 @@ private:
 	// ***
 
 public:
-	typedef std::shared_ptr<IMaterial> TMaterialSmartPtr;
+	typedef _smart_ptr<IMaterial> TMaterialSmartPtr;
 
-	void CacheMaterial(const char* materialFileName);
-	TMaterialSmartPtr GetMaterial(const char* materialFileName) const;
+	/** Loads a material synchronously on the calling thread. Prefer RequestMaterial during gameplay. */
+	bool CacheMaterial(const char* materialFileName);
+	TMaterialSmartPtr GetMaterial(const char* materialFileName) const { return GetMaterial(GetKey(materialFileName)); }
+	TMaterialSmartPtr GetMaterial(CryHash materialKey) const;
 
 private:
-	typedef std::map<CryHash, TMaterialSmartPtr> TGameMaterialCacheMap;
+	typedef CGameCacheMap<CryHash, TMaterialSmartPtr> TGameMaterialCacheMap;
 	TGameMaterialCacheMap m_materialCache;
+	TPinCountMap m_pinnedMaterials;
 
 
 	// ***
@@ -149,13 +507,16 @@ private:
 	// ***
 
 public:
-	typedef std::shared_ptr<IParticleEffect> TParticleEffectSmartPtr;
+	typedef _smart_ptr<IParticleEffect> TParticleEffectSmartPtr;
 
-	void CacheParticleEffect(const char* particleEffectFileName);
-	TParticleEffectSmartPtr GetParticleEffect(const char* particleEffectFileName) const;
+	/** Loads a particle effect synchronously on the calling thread. Prefer RequestParticleEffect during gameplay. */
+	bool CacheParticleEffect(const char* particleEffectFileName);
+	TParticleEffectSmartPtr GetParticleEffect(const char* particleEffectFileName) const { return GetParticleEffect(GetKey(particleEffectFileName)); }
+	TParticleEffectSmartPtr GetParticleEffect(CryHash particleEffectKey) const;
 
 private:
-	typedef std::map<CryHash, TParticleEffectSmartPtr> TGameParticleEffectCacheMap;
+	typedef CGameCacheMap<CryHash, TParticleEffectSmartPtr> TGameParticleEffectCacheMap;
 	TGameParticleEffectCacheMap m_particleEffectCache;
+	TPinCountMap m_pinnedParticleEffects;
 };
 }
\ No newline at end of file
@@ -0,0 +1,425 @@
+#include <StdAfx.h>
+
+#include "GameCacheManifest.h"
+#include <CrySystem/File/ICryPak.h>
+#include <CryString/StringUtils.h>
+#include <Item/Parameters/ItemGeometryParameter.h>
+
+
+namespace Chrysalis
+{
+const char* const CGameCacheManifest::DefaultFileName = "parameters/items/items.cachemanifest";
+const char* const CGameCacheManifest::DefaultItemParametersFolder = "parameters/items";
+
+// Bump the version whenever the layout changes. Old manifests will be rejected and need rebuilding.
+static const uint32 manifestMagic = 0x4d434743; // 'CGCM'
+static const uint32 manifestVersion = 1;
+
+
+struct SHeader
+{
+	uint32 magic;
+	uint32 version;
+	uint32 assetCount;
+	uint32 itemCount;
+	uint32 refCount;
+	uint32 stringBytes;
+};
+
+
+struct SAssetRecord
+{
+	uint32 pathOffset;
+	uint32 textureFlags;
+	uint32 assetType;
+};
+
+
+struct SItemRecord
+{
+	uint32 itemClassOffset;
+	uint32 firstRef;
+	uint32 refCount;
+};
+
+
+/** Guess the asset type from the file extension. Returns false if it doesn't look like an asset we cache. */
+static bool GetAssetTypeFromPath(const char* path, CGameCache::EAssetType& assetType)
+{
+	const char* ext = PathUtil::GetExt(path);
+
+	if ((stricmp(ext, "cgf") == 0) || (stricmp(ext, "cga") == 0) || (stricmp(ext, "cdf") == 0) || (stricmp(ext, "chr") == 0))
+		assetType = CGameCache::EAssetType::Geometry;
+	else if (stricmp(ext, "mtl") == 0)
+		assetType = CGameCache::EAssetType::Material;
+	else if ((stricmp(ext, "dds") == 0) || (stricmp(ext, "tif") == 0))
+		assetType = CGameCache::EAssetType::Texture;
+	else
+		return false;
+
+	return true;
+}
+
+
+size_t CGameCacheManifest::BuildFromItemParameters(const char* itemParametersFolder)
+{
+	Clear();
+
+	// Every parameter file is loaded before any are read, since an item may inherit from one found later on.
+	std::vector<XmlNodeRef> itemNodes;
+	TItemNodeMap itemNodesByName;
+
+	// Walk the folder tree without recursion, since it can be quite deep.
+	std::vector<string> folders { itemParametersFolder };
+
+	while (!folders.empty())
+	{
+		const string folder = folders.back();
+		folders.pop_back();
+
+		_finddata_t fd;
+		intptr_t handle = gEnv->pCryPak->FindFirst(folder + "/*.*", &fd);
+		if (handle == -1)
+			continue;
+
+		do
+		{
+			if ((strcmp(fd.name, ".") == 0) || (strcmp(fd.name, "..") == 0))
+				continue;
+
+			const string path = folder + "/" + fd.name;
+
+			if (fd.attrib & _A_SUBDIR)
+			{
+				folders.push_back(path);
+			}
+			else if (stricmp(PathUtil::GetExt(fd.name), "xml") == 0)
+			{
+				if (XmlNodeRef rootNode = gEnv->pSystem->LoadXmlFromFile(path))
+				{
+					if (stricmp(rootNode->getTag(), "item") == 0)
+					{
+						itemNodes.push_back(rootNode);
+						itemNodesByName [string(rootNode->getAttr("name")).MakeLower()] = rootNode;
+					}
+				}
+			}
+		} while (gEnv->pCryPak->FindNext(handle, &fd) >= 0);
+
+		gEnv->pCryPak->FindClose(handle);
+	}
+
+	for (const auto& itemNode : itemNodes)
+		ReadItemParameters(itemNode, itemNodesByName);
+
+	// The lookup is only needed while building.
+	m_assetLookup.clear();
+
+	return m_items.size();
+}
+
+
+void CGameCacheManifest::ReadItemParameters(const XmlNodeRef& itemNode, const TItemNodeMap& itemNodesByName)
+{
+	const char* itemClass = itemNode->getAttr("name");
+	if (!itemClass || !itemClass [0])
+		return;
+
+	m_items.emplace_back();
+	SItem& item = m_items.back();
+	item.itemClass = itemClass;
+
+	// Keys for the slots and parameters which have already been read. The item's own file is read first and then each
+	// file it inherits from in turn, so anything already in here has been overridden and is skipped.
+	std::set<string> overridden;
+
+	// Guards against a loop in the inheritance chain.
+	const int maxInheritanceDepth = 16;
+
+	XmlNodeRef node = itemNode;
+	for (int depth = 0; node; ++depth)
+	{
+		// Geometry for each of the slots, along with any material overrides.
+		if (XmlNodeRef geometryNode = node->findChild("geometry"))
+		{
+			for (int i = 0; i < geometryNode->getChildCount(); ++i)
+			{
+				XmlNodeRef slotNode = geometryNode->getChild(i);
+				if (!overridden.insert(string("geometry/") + slotNode->getTag()).second)
+					continue;
+
+				CItemGeometryParameter geometry;
+				geometry.Read(slotNode);
+
+				// Older parameter files put the model path in a 'name' attribute on the slot instead.
+				if (geometry.modelPath.empty())
+					geometry.modelPath = slotNode->getAttr("name");
+
+				AddAsset(item, CGameCache::EAssetType::Geometry, geometry.modelPath);
+				AddAsset(item, CGameCache::EAssetType::Material, geometry.material);
+			}
+		}
+
+		// Accessories are item classes in their own right, so their assets are gathered from their own parameter files. Any
+		// other section may still reference textures (e.g. light projectors) or particle effects.
+		for (int i = 0; i < node->getChildCount(); ++i)
+		{
+			XmlNodeRef sectionNode = node->getChild(i);
+			if ((stricmp(sectionNode->getTag(), "geometry") != 0) && (stricmp(sectionNode->getTag(), "accessories") != 0))
+				ReadAssetParameters(item, sectionNode, sectionNode->getTag(), overridden);
+		}
+
+		const char* parentClass = node->getAttr("inherit");
+		if (!parentClass || !parentClass [0])
+			break;
+
+		auto it = itemNodesByName.find(string(parentClass).MakeLower());
+		if (it == itemNodesByName.end())
+		{
+			CryLogAlways("Item '%s' inherits from '%s', which has no parameter file. Its inherited assets are missing from the game cache manifest.", itemClass, parentClass);
+			break;
+		}
+
+		if (depth >= maxInheritanceDepth)
+		{
+			CryLogAlways("Item '%s' has an inheritance chain which is too deep or loops back on itself.", itemClass);
+			break;
+		}
+
+		node = it->second;
+	}
+
+	// There's no point keeping an item class which doesn't need anything.
+	if (item.assets.empty())
+		m_items.pop_back();
+}
+
+
+void CGameCacheManifest::ReadAssetParameters(SItem& item, const XmlNodeRef& node, const string& keyPrefix, std::set<string>& overridden)
+{
+	for (int i = 0; i < node->getChildCount(); ++i)
+	{
+		XmlNodeRef childNode = node->getChild(i);
+
+		if (stricmp(childNode->getTag(), "param") == 0)
+		{
+			const char* name = childNode->getAttr("name");
+
+			// A parameter which is cleared in a derived file still hides the inherited value.
+			if (!overridden.insert(keyPrefix + "/" + name).second)
+				continue;
+
+			const char* value = childNode->getAttr("value");
+			if (!value || !value [0])
+				continue;
+
+			// Particle effects are referenced by library name rather than by file, so we rely on the parameter name.
+			CGameCache::EAssetType assetType;
+			if (CryStringUtils::stristr(name, "effect"))
+				AddAsset(item, CGameCache::EAssetType::ParticleEffect, value);
+			else if (GetAssetTypeFromPath(value, assetType))
+				AddAsset(item, assetType, value);
+		}
+		else
+		{
+			ReadAssetParameters(item, childNode, keyPrefix + "/" + childNode->getTag(), overridden);
+		}
+	}
+}
+
+
+void CGameCacheManifest::AddAsset(SItem& item, CGameCache::EAssetType assetType, const char* path, uint32 textureFlags)
+{
+	if (!path || !path [0])
+		return;
+
+	// Assets are shared between items, so look for an existing record first.
+	const uint32 key = CryStringUtils::HashString(path) ^ (static_cast<uint32>(assetType) * 0x9e3779b1);
+	auto it = m_assetLookup.find(key);
+
+	uint32 index;
+	if ((it != m_assetLookup.end()) && (m_assets [it->second].assetType == assetType) && (m_assets [it->second].path == path))
+	{
+		index = it->second;
+	}
+	else
+	{
+		index = static_cast<uint32>(m_assets.size());
+
+		SAsset asset;
+		asset.assetType = assetType;
+		asset.textureFlags = textureFlags;
+		asset.path = path;
+		m_assets.push_back(asset);
+
+		// On the rare chance of a hash collision we simply don't share the later asset.
+		m_assetLookup.emplace(key, index);
+	}
+
+	if (std::find(item.assets.begin(), item.assets.end(), index) == item.assets.end())
+		item.assets.push_back(index);
+}
+
+
+bool CGameCacheManifest::Write(const char* fileName) const
+{
+	// Flatten everything into the records and a single string block.
+	std::vector<SAssetRecord> assetRecords;
+	std::vector<SItemRecord> itemRecords;
+	std::vector<uint32> refs;
+	std::vector<char> strings;
+
+	auto addString = [&strings](const string& value)
+	{
+		const uint32 offset = static_cast<uint32>(strings.size());
+		strings.insert(strings.end(), value.c_str(), value.c_str() + value.length() + 1);
+
+		return offset;
+	};
+
+	assetRecords.reserve(m_assets.size());
+	for (const auto& asset : m_assets)
+		assetRecords.push_back({ addString(asset.path), asset.textureFlags, static_cast<uint32>(asset.assetType) });
+
+	itemRecords.reserve(m_items.size());
+	for (const auto& item : m_items)
+	{
+		itemRecords.push_back({ addString(item.itemClass), static_cast<uint32>(refs.size()), static_cast<uint32>(item.assets.size()) });
+		refs.insert(refs.end(), item.assets.begin(), item.assets.end());
+	}
+
+	SHeader header;
+	header.magic = manifestMagic;
+	header.version = manifestVersion;
+	header.assetCount = static_cast<uint32>(assetRecords.size());
+	header.itemCount = static_cast<uint32>(itemRecords.size());
+	header.refCount = static_cast<uint32>(refs.size());
+	header.stringBytes = static_cast<uint32>(strings.size());
+
+	FILE* pFile = gEnv->pCryPak->FOpen(fileName, "wb");
+	if (!pFile)
+	{
+		CryLogAlways("Unable to open game cache manifest '%s' for writing.", fileName);
+		return false;
+	}
+
+	gEnv->pCryPak->FWrite(&header, sizeof(header), 1, pFile);
+	gEnv->pCryPak->FWrite(assetRecords.data(), sizeof(SAssetRecord), assetRecords.size(), pFile);
+	gEnv->pCryPak->FWrite(itemRecords.data(), sizeof(SItemRecord), itemRecords.size(), pFile);
+	gEnv->pCryPak->FWrite(refs.data(), sizeof(uint32), refs.size(), pFile);
+	gEnv->pCryPak->FWrite(strings.data(), sizeof(char), strings.size(), pFile);
+	gEnv->pCryPak->FClose(pFile);
+
+	return true;
+}
+
+
+bool CGameCacheManifest::Read(const char* fileName)
+{
+	Clear();
+
+	FILE* pFile = gEnv->pCryPak->FOpen(fileName, "rb");
+	if (!pFile)
+		return false;
+
+	// Read the whole file in one go, it's small.
+	std::vector<uint8> data(gEnv->pCryPak->FGetSize(pFile));
+	const size_t bytesRead = gEnv->pCryPak->FReadRaw(data.data(), 1, data.size(), pFile);
+	gEnv->pCryPak->FClose(pFile);
+
+	if ((bytesRead != data.size()) || (data.size() < sizeof(SHeader)))
+		return false;
+
+	SHeader header;
+	memcpy(&header, data.data(), sizeof(header));
+
+	if ((header.magic != manifestMagic) || (header.version != manifestVersion))
+	{
+		CryLogAlways("Game cache manifest '%s' is out of date and needs to be rebuilt.", fileName);
+		return false;
+	}
+
+	const size_t assetsOffset = sizeof(SHeader);
+	const size_t itemsOffset = assetsOffset + header.assetCount * sizeof(SAssetRecord);
+	const size_t refsOffset = itemsOffset + header.itemCount * sizeof(SItemRecord);
+	const size_t stringsOffset = refsOffset + header.refCount * sizeof(uint32);
+
+	if ((stringsOffset + header.stringBytes != data.size()) || (header.stringBytes == 0) || (data.back() != '\0'))
+	{
+		CryLogAlways("Game cache manifest '%s' is corrupt.", fileName);
+		return false;
+	}
+
+	const char* pStrings = reinterpret_cast<const char*>(data.data() + stringsOffset);
+	auto getString = [pStrings, &header](uint32 offset) { return offset < header.stringBytes ? pStrings + offset : ""; };
+
+	m_assets.resize(header.assetCount);
+	for (uint32 i = 0; i < header.assetCount; ++i)
+	{
+		SAssetRecord record;
+		memcpy(&record, data.data() + assetsOffset + i * sizeof(SAssetRecord), sizeof(record));
+
+		m_assets [i].assetType = static_cast<CGameCache::EAssetType>(record.assetType);
+		m_assets [i].textureFlags = record.textureFlags;
+		m_assets [i].path = getString(record.pathOffset);
+	}
+
+	const uint32* pRefs = reinterpret_cast<const uint32*>(data.data() + refsOffset);
+
+	m_items.resize(header.itemCount);
+	for (uint32 i = 0; i < header.itemCount; ++i)
+	{
+		SItemRecord record;
+		memcpy(&record, data.data() + itemsOffset + i * sizeof(SItemRecord), sizeof(record));
+
+		m_items [i].itemClass = getString(record.itemClassOffset);
+
+		if (record.firstRef + record.refCount <= header.refCount)
+		{
+			for (uint32 ref = record.firstRef; ref < record.firstRef + record.refCount; ++ref)
+			{
+				if (pRefs [ref] < header.assetCount)
+					m_items [i].assets.push_back(pRefs [ref]);
+			}
+		}
+	}
+
+	return true;
+}
+
+
+void CGameCacheManifest::Clear()
+{
+	m_assets.clear();
+	m_items.clear();
+	m_assetLookup.clear();
+}
+
+
+const CGameCacheManifest::SItem* CGameCacheManifest::FindItem(const char* itemClass) const
+{
+	for (const auto& item : m_items)
+	{
+		if (stricmp(item.itemClass, itemClass) == 0)
+			return &item;
+	}
+
+	return nullptr;
+}
+
+
+void CGameCacheManifest::GetMemoryUsage(ICrySizer* s) const
+{
+	s->AddContainer(m_assets);
+	s->AddContainer(m_items);
+
+	for (const auto& asset : m_assets)
+		s->AddObject(asset.path);
+
+	for (const auto& item : m_items)
+	{
+		s->AddObject(item.itemClass);
+		s->AddContainer(item.assets);
+	}
+}
+}
@@ -0,0 +1,138 @@
+/**
+\file	Game\Cache\GameCacheManifest.h
+
+A precompiled list of every asset each item class needs. The manifest is built by a tool-style pass over the item
+parameter files (see the game_cache_build_manifest console command) and written out as a compact binary file. At run
+time the game cache reads it once and uses it to warm the caches during level load, so the first pickup or equip of an
+item doesn't have to touch the disk.
+
+The file layout is:
+
+SHeader
+SAssetRecord	[assetCount]	- each unique (type, path) pair, referenced by index.
+SItemRecord		[itemCount]		- an item class and the range of asset references it owns.
+uint32			[refCount]		- indices into the asset records.
+char			[stringBytes]	- null terminated strings, referenced by offset.
+
+All values are little-endian.
+*/
+#pragma once
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include "GameCache.h"
+
+
+namespace Chrysalis
+{
+class CGameCacheManifest
+{
+public:
+	/** The default location for the manifest, relative to the game folder. */
+	static const char* const DefaultFileName;
+
+	/** The default folder to scan for item parameter files. */
+	static const char* const DefaultItemParametersFolder;
+
+
+	/** An asset which one or more item classes depend on. */
+	struct SAsset
+	{
+		CGameCache::EAssetType assetType { CGameCache::EAssetType::Geometry };
+
+		/** Texture flags, only used for textures. */
+		uint32 textureFlags { 0 };
+
+		string path;
+	};
+
+
+	/** The assets needed by a single item class. */
+	struct SItem
+	{
+		string itemClass;
+
+		/** Indices into the asset list. */
+		std::vector<uint32> assets;
+	};
+
+
+	/**
+	Scans a folder (recursively) for item parameter files and gathers every asset they reference. This is the
+	tool-style pass, it's slow and is not intended to be run during gameplay.
+
+	\param	itemParametersFolder	Path of the folder containing item parameter files.
+
+	\return	The number of item classes found.
+	*/
+	size_t BuildFromItemParameters(const char* itemParametersFolder);
+
+
+	/**
+	Writes the manifest out in its binary form.
+
+	\param	fileName	Filename of the manifest file.
+
+	\return	True if it succeeds, false if it fails.
+	*/
+	bool Write(const char* fileName) const;
+
+
+	/**
+	Reads a binary manifest, replacing the current contents.
+
+	\param	fileName	Filename of the manifest file.
+
+	\return	True if it succeeds, false if it fails.
+	*/
+	bool Read(const char* fileName);
+
+
+	/** Removes all items and assets. */
+	void Clear();
+
+
+	const std::vector<SAsset>& GetAssets() const { return m_assets; }
+	const std::vector<SItem>& GetItems() const { return m_items; }
+
+
+	/**
+	Gets the assets for a single item class.
+
+	\param	itemClass	The item class.
+
+	\return	null if the item class isn't in the manifest, else the item.
+	*/
+	const SItem* FindItem(const char* itemClass) const;
+
+
+	void GetMemoryUsage(ICrySizer* s) const;
+
+private:
+	/** Adds an asset to the item, sharing the asset record with any other item that uses it. */
+	void AddAsset(SItem& item, CGameCache::EAssetType assetType, const char* path, uint32 textureFlags = 0);
+
+	/** Parameter file root nodes, keyed on the lower case item class name. */
+	typedef std::map<string, XmlNodeRef> TItemNodeMap;
+
+	/** Gathers the assets from a single item parameter file, along with any it inherits from. */
+	void ReadItemParameters(const XmlNodeRef& itemNode, const TItemNodeMap& itemNodesByName);
+
+	/**
+	Searches parameter nodes for values which look like asset references.
+
+	\param 		  	item	  	The item the assets are added to.
+	\param 		  	node	  	The node to search.
+	\param 		  	keyPrefix 	The path of tags leading to the node, used to key its parameters.
+	\param [in,out]	overridden	Keys of the parameters read so far, from this file or a more derived one.
+	*/
+	void ReadAssetParameters(SItem& item, const XmlNodeRef& node, const string& keyPrefix, std::set<string>& overridden);
+
+	std::vector<SAsset> m_assets;
+	std::vector<SItem> m_items;
+
+	// Used while building to find existing asset records. Keyed on a hash of the type and path.
+	std::unordered_map<uint32, uint32> m_assetLookup;
+};
+}
@@ -0,0 +1,379 @@
+/**
+\file	Game\Cache\GameCacheMap.h
+
+A flat, open-addressed hash map used as the storage for each of the game caches. Keys are expected to already be hashes
+(or contain one) so lookups never need to touch the original file name. Entries live in a single contiguous array and
+are found using linear probing, which keeps the per-frame lookups from GetMaterial / GetParticleEffect to one or two
+cache lines.
+
+Each map also keeps a running count of hits, misses and the approximate number of bytes held by its entries so we can
+see how well the caches are working. Every lookup stamps the entry it finds, which allows the least recently used entries
+to be evicted when a cache grows past its budget.
+*/
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+
+namespace Chrysalis
+{
+/** Default hashing for cache keys. Works for any key that is already an integer hash e.g. CryHash. */
+template<typename TKey>
+struct SGameCacheKeyHash
+{
+	uint32 operator()(const TKey& key) const { return static_cast<uint32>(key); }
+};
+
+
+template<typename TKey, typename TValue, typename THash = SGameCacheKeyHash<TKey>>
+class CGameCacheMap
+{
+public:
+	struct SStatistics
+	{
+		/** Number of lookups which found an entry. */
+		uint32 hits { 0 };
+
+		/** Number of lookups which failed to find an entry. */
+		uint32 misses { 0 };
+
+		/** The approximate number of bytes held by the cached assets. */
+		size_t residentBytes { 0 };
+
+		/** Number of entries which have been evicted to keep the cache within budget. */
+		uint32 evictions { 0 };
+	};
+
+
+	CGameCacheMap() = default;
+
+
+	/**
+	Searches for an entry with the given key. Counts towards the hit / miss statistics and marks the entry as recently
+	used.
+
+	\param	key	The key.
+
+	\return	null if the key isn't present, else the value.
+	*/
+	const TValue* Find(const TKey& key) const
+	{
+		const int index = FindIndex(key);
+		if (index >= 0)
+		{
+			++m_statistics.hits;
+			m_slots [index].lastUsed = ++m_useClock;
+			return &m_slots [index].value;
+		}
+
+		++m_statistics.misses;
+		return nullptr;
+	}
+
+
+	/** Query if the key is present. Does not count towards the hit / miss statistics. */
+	bool Contains(const TKey& key) const { return FindIndex(key) >= 0; }
+
+
+	/** Searches for an entry without affecting the statistics or the usage order. */
+	TValue* Peek(const TKey& key)
+	{
+		const int index = FindIndex(key);
+		return index >= 0 ? &m_slots [index].value : nullptr;
+	}
+
+
+	/**
+	Inserts a new entry. If the key is already present the existing entry is left untouched.
+
+	\param	key  	The key.
+	\param	value	The value.
+	\param	bytes	The approximate number of bytes the cached asset is holding onto.
+
+	\return	True if the entry was added, false if the key was already present.
+	*/
+	bool Insert(const TKey& key, const TValue& value, size_t bytes)
+	{
+		// Grow before we pass the maximum load factor of 3/4. Linear probing degrades quickly past that.
+		if ((m_size + 1) * 4 > m_slots.size() * 3)
+			Rehash(m_slots.empty() ? minCapacity : m_slots.size() * 2);
+
+		const uint32 mask = static_cast<uint32>(m_slots.size() - 1);
+		for (uint32 index = Mix(m_hash(key)) & mask;; index = (index + 1) & mask)
+		{
+			SSlot& slot = m_slots [index];
+
+			if (!slot.isOccupied)
+			{
+				slot.key = key;
+				slot.value = value;
+				slot.bytes = bytes;
+				slot.lastUsed = ++m_useClock;
+				slot.isOccupied = true;
+
+				++m_size;
+				m_statistics.residentBytes += bytes;
+
+				return true;
+			}
+
+			if (slot.key == key)
+				return false;
+		}
+	}
+
+
+	/**
+	Removes the entry with the given key, if present.
+
+	\param	key	The key.
+
+	\return	True if an entry was removed.
+	*/
+	bool Erase(const TKey& key)
+	{
+		int found = FindIndex(key);
+		if (found < 0)
+			return false;
+
+		const uint32 mask = static_cast<uint32>(m_slots.size() - 1);
+		uint32 hole = static_cast<uint32>(found);
+
+		m_statistics.residentBytes -= m_slots [hole].bytes;
+		--m_size;
+
+		// Backward shift deletion. Any entries in the same probe run which would be unreachable with a hole here are moved
+		// back into it. This avoids the need for tombstones.
+		for (uint32 index = (hole + 1) & mask; m_slots [index].isOccupied; index = (index + 1) & mask)
+		{
+			const uint32 home = Mix(m_hash(m_slots [index].key)) & mask;
+
+			// Only move the entry if its home slot is not cyclically within (hole, index].
+			if (((index - home) & mask) >= ((index - hole) & mask))
+			{
+				m_slots [hole] = std::move(m_slots [index]);
+				hole = index;
+			}
+		}
+
+		m_slots [hole] = SSlot();
+
+		return true;
+	}
+
+
+	/**
+	Evicts entries, least recently used first, until the resident bytes are at or below the target. Entries for which
+	isPinned returns true are never evicted.
+
+	\param	targetBytes	The resident bytes to aim for.
+	\param	isPinned   	A predicate with a signature of bool(const TKey& key).
+
+	\return	The number of entries which were evicted.
+	*/
+	template<typename TPinnedPredicate>
+	uint32 EvictLeastRecentlyUsed(size_t targetBytes, TPinnedPredicate isPinned)
+	{
+		if (m_statistics.residentBytes <= targetBytes)
+			return 0;
+
+		// Gather every candidate for eviction. This is a linear pass, but it only happens when we're over budget and the
+		// scratch buffer is kept around to save on allocations.
+		m_evictionCandidates.clear();
+		for (const auto& slot : m_slots)
+		{
+			if (slot.isOccupied && !isPinned(slot.key))
+				m_evictionCandidates.push_back({ slot.lastUsed, slot.key });
+		}
+
+		std::sort(m_evictionCandidates.begin(), m_evictionCandidates.end(),
+			[](const SEvictionCandidate& a, const SEvictionCandidate& b) { return a.lastUsed < b.lastUsed; });
+
+		uint32 evicted { 0 };
+		for (const auto& candidate : m_evictionCandidates)
+		{
+			if (m_statistics.residentBytes <= targetBytes)
+				break;
+
+			if (Erase(candidate.key))
+				++evicted;
+		}
+
+		m_statistics.evictions += evicted;
+
+		return evicted;
+	}
+
+
+	/**
+	Evicts every entry for which isPinned returns false.
+
+	\param	isPinned	A predicate with a signature of bool(const TKey& key).
+
+	\return	The number of entries which were evicted.
+	*/
+	template<typename TPinnedPredicate>
+	uint32 EvictUnpinned(TPinnedPredicate isPinned)
+	{
+		m_evictionCandidates.clear();
+		for (const auto& slot : m_slots)
+		{
+			if (slot.isOccupied && !isPinned(slot.key))
+				m_evictionCandidates.push_back({ slot.lastUsed, slot.key });
+		}
+
+		uint32 evicted { 0 };
+		for (const auto& candidate : m_evictionCandidates)
+		{
+			if (Erase(candidate.key))
+				++evicted;
+		}
+
+		m_statistics.evictions += evicted;
+
+		return evicted;
+	}
+
+
+	/** Removes all entries. The table keeps its capacity, and the hit / miss counts are kept. */
+	void Clear()
+	{
+		for (auto& slot : m_slots)
+			slot = SSlot();
+
+		m_size = 0;
+		m_statistics.residentBytes = 0;
+	}
+
+
+	/** Gets the number of entries. */
+	size_t Size() const { return m_size; }
+
+
+	/**
+	Calls a function for each entry in the map. The order is undefined.
+
+	\param	func	The function, with a signature of void(const TKey& key, const TValue& value, size_t bytes).
+	*/
+	template<typename TFunc>
+	void ForEach(TFunc func) const
+	{
+		for (const auto& slot : m_slots)
+		{
+			if (slot.isOccupied)
+				func(slot.key, slot.value, slot.bytes);
+		}
+	}
+
+
+	const SStatistics& GetStatistics() const { return m_statistics; }
+
+
+	/** Resets the hit / miss and eviction counts. The resident bytes are unaffected. */
+	void ResetStatistics() const
+	{
+		m_statistics.hits = 0;
+		m_statistics.misses = 0;
+		m_statistics.evictions = 0;
+	}
+
+
+	/** Gets the number of bytes used by the table itself, excluding the cached assets. */
+	size_t GetTableBytes() const { return m_slots.capacity() * sizeof(SSlot); }
+
+
+	void GetMemoryUsage(ICrySizer* s) const
+	{
+		s->AddObject(m_slots.data(), GetTableBytes());
+		s->AddContainer(m_evictionCandidates);
+
+		// The assets themselves are owned by the engine, but we're the ones keeping them resident.
+		s->AddObject(&m_statistics, m_statistics.residentBytes);
+	}
+
+private:
+	struct SSlot
+	{
+		TKey key {};
+		TValue value {};
+		size_t bytes { 0 };
+		mutable uint32 lastUsed { 0 };
+		bool isOccupied { false };
+	};
+
+	struct SEvictionCandidate
+	{
+		uint32 lastUsed;
+		TKey key;
+	};
+
+	static const size_t minCapacity { 64 };
+
+
+	/** Scrambles the bits of the key hash so that sequential or poorly distributed hashes still spread over the table. */
+	static uint32 Mix(uint32 hash)
+	{
+		hash ^= hash >> 16;
+		hash *= 0x85ebca6b;
+		hash ^= hash >> 13;
+		hash *= 0xc2b2ae35;
+		hash ^= hash >> 16;
+
+		return hash;
+	}
+
+
+	int FindIndex(const TKey& key) const
+	{
+		if (m_size == 0)
+			return -1;
+
+		const uint32 mask = static_cast<uint32>(m_slots.size() - 1);
+		for (uint32 index = Mix(m_hash(key)) & mask;; index = (index + 1) & mask)
+		{
+			const SSlot& slot = m_slots [index];
+
+			if (!slot.isOccupied)
+				return -1;
+
+			if (slot.key == key)
+				return static_cast<int>(index);
+		}
+	}
+
+
+	void Rehash(size_t newCapacity)
+	{
+		CRY_ASSERT((newCapacity & (newCapacity - 1)) == 0);
+
+		std::vector<SSlot> oldSlots(newCapacity);
+		oldSlots.swap(m_slots);
+
+		// Entries are moved across as-is, keeping their usage order. The size and resident bytes don't change.
+		const uint32 mask = static_cast<uint32>(newCapacity - 1);
+		for (auto& oldSlot : oldSlots)
+		{
+			if (oldSlot.isOccupied)
+			{
+				uint32 index = Mix(m_hash(oldSlot.key)) & mask;
+				while (m_slots [index].isOccupied)
+					index = (index + 1) & mask;
+
+				m_slots [index] = std::move(oldSlot);
+			}
+		}
+	}
+
+
+	std::vector<SSlot> m_slots;
+	size_t m_size { 0 };
+	THash m_hash;
+	mutable SStatistics m_statistics;
+
+	// Increases with every use of an entry, giving us the order in which they were last used.
+	mutable uint32 m_useClock { 0 };
+
+	std::vector<SEvictionCandidate> m_evictionCandidates;
+};
+}
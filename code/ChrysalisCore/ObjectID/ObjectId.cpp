@@ -1,7 +1,8 @@
 #include <StdAfx.h>
 
 #include "ObjectId.h"
-#include <atomic>
+#include <algorithm>
+#include <thread>
 #include <CryCore/Assert/CryAssert.h>
 #include <time.h>
 #include <CryMath/Random.h>
@@ -11,66 +12,156 @@ namespace Chrysalis
 {
 CObjectIdFactory::CObjectIdFactory(uint32 instanceId)
 	: m_instanceId(instanceId),
-	m_randomVariant(0),
-	m_secondsSinceEpoch(0)
+	m_variantSalt(cry_random_uint32())
 {}
 
 
 ObjectId CObjectIdFactory::CreateObjectId()
+{
+	uint32 secondsSinceEpoch;
+	uint32 sequence;
+
+	ReserveSequence(1, secondsSinceEpoch, sequence);
+
+	return MakeObjectId(secondsSinceEpoch, sequence);
+}
+
+
+SObjectIdRange CObjectIdFactory::ReserveRange(uint32 count)
+{
+	if (count == 0)
+		return SObjectIdRange();
+
+	// min takes references, so the constant is copied rather than odr-used, since it has no out of line definition.
+	const uint32 maxCount = VariantsPerSecond;
+	count = min(count, maxCount);
+
+	uint32 secondsSinceEpoch;
+	uint32 sequence;
+
+	ReserveSequence(count, secondsSinceEpoch, sequence);
+
+	return SObjectIdRange(MakeObjectId(secondsSinceEpoch, sequence), count);
+}
+
+
+void CObjectIdFactory::ReserveSequence(uint32 count, uint32& secondsSinceEpoch, uint32& sequence)
 {
 	// Validation during testing / debug. For speed reasons we will not validate
 	// input in a release build. This decision might be wise to reconsider if you need the validation.
 	CRY_ASSERT(m_instanceId < MaxInstanceId);
-	CRY_ASSERT(m_randomVariant < MaxRandomVariant);
-
-	ObjectId objectId = InvalidId;
-
-	std::atomic<bool> spinLock { false };
+	CRY_ASSERT((count > 0) && (count <= VariantsPerSecond));
+
+	// We're rounding our time down to 32 bit, so this code here is susceptible to the Y2038 problem in 2038 when
+	// the value will roll over. It will still provide a 1 second window, but the dates derived from using this
+	// number will be nonsense. Still, it will take 70+ years before it starts to clash - so plenty of time to
+	// switch to 64 bit numbers or another method.
+	const uint32 now = static_cast<uint32> (time(nullptr));
+
+	// The common case is a second which is current and has enough Ids left, and that only needs the one atomic add.
+	// Every caller gets a different run, so there's no need to check the value we replaced.
+	uint64 state = m_state.fetch_add(count);
+	secondsSinceEpoch = static_cast<uint32>(state >> 32);
+	sequence = static_cast<uint32>(state);
+
+	if ((secondsSinceEpoch >= now) && (sequence <= VariantsPerSecond - count))
+		return;
+
+	// Either the clock has moved on, or this second doesn't have enough Ids left. Only one caller can move the state
+	// to a new second, the rest will see the new second when their exchange fails and take their Ids from it.
+	state = m_state.load();
+	for (;;)
 	{
-		// Spin on this until we can get a lock.
-		while (spinLock.exchange(true)) {}
-
-		// We're rounding our time down to 32 bit, so this code here is susceptible to the Y2038 problem in 2038 when
-		// the value will roll over. It will still provide a 1 second window, but the dates derived from using this
-		// number will be nonsense. Still, it will take 70+ years before it starts to clash - so plenty of time to
-		// switch to 64 bit numbers or another method.
-		auto now = static_cast<int32> (time(nullptr));
+		secondsSinceEpoch = static_cast<uint32>(state >> 32);
+		sequence = static_cast<uint32>(state);
 
-		if (m_secondsSinceEpoch == now)
+		if ((secondsSinceEpoch >= now) && (sequence <= VariantsPerSecond - count))
 		{
-			// Check for overflow on the variant.
-			m_randomVariant = (m_randomVariant + 1) & MaxRandomVariant;
-			if (m_lastRandomVariantSeed == m_randomVariant)
+			if (m_state.compare_exchange_weak(state, state + count))
+				return;
+		}
+		else
+		{
+			// If we're not behind the clock, this second is used up and we borrow the next one.
+			const bool isBorrowing = secondsSinceEpoch >= now;
+			const uint32 nextSeconds = isBorrowing ? secondsSinceEpoch + 1 : now;
+
+			if (m_state.compare_exchange_weak(state, (static_cast<uint64>(nextSeconds) << 32) | count))
 			{
-				// #TODO: Don't let this assert happen for the dedicated server, since no-one will be
-				// there to notice.
-				CryLogAlways("Too many ObjectIds requested at once. See docs for limitations on ObjectId generation.");
-				CRY_ASSERT_MESSAGE(false, "Too many ObjectIds requested at once. See docs for limitations on ObjectId generation.");
-				return InvalidId;
+				if (isBorrowing)
+					++m_borrowedSeconds;
+
+				secondsSinceEpoch = nextSeconds;
+				sequence = 0;
+				return;
 			}
 		}
-		else
+	}
+}
+
+
+ObjectId CObjectIdFactory::MakeObjectId(uint32 secondsSinceEpoch, uint32 sequence) const
+{
+	// The starting point for the variant is different for each second, and the sequence counts on from it, wrapping
+	// around. Since the sequence is always below VariantsPerSecond, the variants can't repeat within a second.
+	const uint32 randomVariant = ((secondsSinceEpoch * 2654435761u) ^ m_variantSalt) + sequence;
+
+	// Pack the values tightly into our data member. We're using the max values as a way to mask the raw
+	// data value packed in. This is a cheap operation to perform and should help prevent dirty data
+	// slipping in.
+	return (static_cast<uint64_t>(secondsSinceEpoch) << (InstanceIdBits + RandomVariantBits))
+		+ (static_cast<uint64_t>((m_instanceId & MaxInstanceId)) << RandomVariantBits)
+		+ (randomVariant & MaxRandomVariant);
+}
+
+
+void CObjectIdFactory::RunBenchmark(int idsPerThread)
+{
+	idsPerThread = max(idsPerThread, 1);
+
+	const int threadCounts [] = { 1, 2, 4, 8, 16 };
+
+	CryLogAlways("ObjectId benchmark, %d Ids per thread.", idsPerThread);
+	CryLogAlways("%8s %14s %10s  %s", "threads", "Ids / second", "borrowed", "results");
+
+	for (const int threadCount : threadCounts)
+	{
+		CObjectIdFactory factory(0);
+		std::vector<std::vector<ObjectId>> results(threadCount);
+		std::vector<std::thread> threads;
+
+		const CTimeValue startTime = gEnv->pTimer->GetAsyncTime();
+
+		for (int i = 0; i < threadCount; ++i)
 		{
-			// Bring the seconds up to date.
-			m_secondsSinceEpoch = now;
+			threads.emplace_back([&factory, &results, i, idsPerThread]()
+			{
+				std::vector<ObjectId>& ids = results [i];
+				ids.resize(idsPerThread);
 
-			// We generate a new random seed to make keys harder to guess. It's fairly weak but better
-			// than nothing at all.
-			m_lastRandomVariantSeed = m_randomVariant = cry_random_uint32() & MaxRandomVariant;
+				for (auto& id : ids)
+					id = factory.CreateObjectId();
+			});
 		}
 
-		// Pack the values tightly into our data member. We're using the max values as a way to mask the raw
-		// data value packed in. This is a cheap operation to perform and should help prevent dirty data
-		// slipping in.
-		objectId = (static_cast<uint64_t>(m_secondsSinceEpoch) << (InstanceIdBits + RandomVariantBits))
-			+ (static_cast<uint64_t>((m_instanceId & MaxInstanceId)) << RandomVariantBits)
-			+ (m_randomVariant & MaxRandomVariant);
+		for (auto& thread : threads)
+			thread.join();
 
-		// Unlock!
-		spinLock = false;
-	}
+		const float seconds = max((gEnv->pTimer->GetAsyncTime() - startTime).GetSeconds(), 0.000001f);
+
+		// Every Id from every thread should be unique.
+		std::vector<ObjectId> allIds;
+		allIds.reserve(static_cast<size_t>(idsPerThread) * threadCount);
+		for (const auto& ids : results)
+			allIds.insert(allIds.end(), ids.begin(), ids.end());
 
-	return objectId;
+		std::sort(allIds.begin(), allIds.end());
+		const bool isUnique = (std::adjacent_find(allIds.begin(), allIds.end()) == allIds.end())
+			&& (allIds.front() != InvalidId);
+
+		CryLogAlways("%8d %14.0f %10u  %s", threadCount, static_cast<float>(allIds.size()) / seconds, factory.GetBorrowedSeconds(),
+			isUnique ? "unique" : "DUPLICATES");
+	}
 }
 
 
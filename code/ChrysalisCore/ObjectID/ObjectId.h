@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 
 namespace Chrysalis
 {
@@ -16,18 +18,23 @@ the bits, use the accessors provided instead.
 32-49	:	An instance ID that is unique for every running instance of this code. These need to be unique
 and should be carefully assigned on a as-needed basis.
 50-63	:	A random component. Each second a new starting point is generated, and it increments with each
-Id generated during that second. This forces a hard limit on the number of Ids that can be generated
-in a single second. Currently this limit is 16,384. /
+Id generated during that second. This limits the number of Ids that can be generated in a single second to
+16,384. Past that, the factory moves on to the next second early and carries on from there.
 */
 
 typedef uint64_t ObjectId;
 
+struct SObjectIdRange;
+
 
 /** A factory class needed to properly construct valid ObjectIds. The class is dependant on
 having a valid instanceId prior to instantiation.
 
-It is recommended that you create an instance of this factory for every entity class where you think
-you will need to create more the hard limit of ObjectId's / second. Currently, this limit is 16,384.
+Ids can be requested from any thread. The second and the count of Ids issued in it are held together in a single
+atomic value, so there are no locks, and most requests are a single atomic add. If more than 16,384 Ids are
+requested in a second, the factory borrows from the following second rather than failing. Sustained rates above
+that will move the seconds ahead of the clock, but the Ids remain unique, and the factory drops back to the clock
+once it catches up. The seconds never go backwards, so the Ids remain unique even if the clock is set back.
 */
 class CObjectIdFactory
 {
@@ -50,6 +57,9 @@ public:
 	/** Magic number to signify an invalid ID. */
 	static const ObjectId InvalidId = 0;
 
+	/** The number of Ids which can be made for each second. */
+	static const uint32 VariantsPerSecond = MaxRandomVariant + 1;
+
 
 	/**
 	Constructor.
@@ -70,6 +80,37 @@ public:
 	ObjectId CreateObjectId();
 
 
+	/**
+	Reserves a block of Ids in one request. The Ids all share the same second and instance, and their random variants
+	run on consecutively from the first, so the block can be stored or sent as just the first Id and a count.
+
+	A block can't hold more Ids than a second allows (VariantsPerSecond). Larger requests are clamped, so check the
+	count of the returned range and reserve again for the rest.
+
+	\param	count	The number of Ids wanted.
+
+	\return	The range of Ids reserved.
+	*/
+	SObjectIdRange ReserveRange(uint32 count);
+
+
+	/**
+	Gets the number of times the factory has run out of Ids for a second and moved on to the next one early.
+
+	\return	The number of seconds borrowed.
+	*/
+	uint32 GetBorrowedSeconds() const { return m_borrowedSeconds; }
+
+
+	/**
+	Times Id creation from 1 to 16 threads sharing a factory, checks every Id made was unique and outputs the
+	results to the log.
+
+	\param	idsPerThread	The number of Ids each thread should create.
+	*/
+	static void RunBenchmark(int idsPerThread);
+
+
 	/**
 	Gets seconds since epoch.
 
@@ -94,12 +135,79 @@ public:
 	uint32 GetRandomVariant(ObjectId objectId);
 
 private:
+	/**
+	Reserves a run of consecutive sequence numbers in a single second, moving on to a new second if needed.
+
+	\param	count					The number of sequence numbers wanted. Must be between 1 and VariantsPerSecond.
+	\param [out]	secondsSinceEpoch	The second they belong to.
+	\param [out]	sequence			The first sequence number.
+	*/
+	void ReserveSequence(uint32 count, uint32& secondsSinceEpoch, uint32& sequence);
+
+	/** Packs the parts of an Id together. */
+	ObjectId MakeObjectId(uint32 secondsSinceEpoch, uint32 sequence) const;
+
 	uint32 m_instanceId;
-	uint32 m_randomVariant;
-	uint32 m_lastRandomVariantSeed;
-	int32 m_secondsSinceEpoch;
+
+	// Mixed with the seconds to give each second a different starting point for the random variant. This makes the Ids
+	// harder to guess. It's fairly weak but better than nothing at all.
+	uint32 m_variantSalt;
+
+	// The seconds since epoch in the high 32 bits, and the number of Ids issued for that second in the low 32 bits.
+	std::atomic<uint64> m_state { 0 };
+
+	std::atomic<uint32> m_borrowedSeconds { 0 };
 
 	// DO NOT IMPLEMENT.
 	CObjectIdFactory();
 };
+
+
+/** A block of Ids reserved from a CObjectIdFactory, held as the first Id and a count. The Ids share their second and
+instance with the first, and the random variant counts on from it, wrapping around. */
+struct SObjectIdRange
+{
+	SObjectIdRange() = default;
+	SObjectIdRange(ObjectId base, uint32 count) : m_base(base), m_count(count) {}
+
+	bool IsValid() const { return m_count > 0; }
+
+	ObjectId GetBase() const { return m_base; }
+	uint32 GetCount() const { return m_count; }
+
+
+	/**
+	Gets an Id from the range.
+
+	\param	index	Zero-based index of the Id, less than the count.
+
+	\return	The Id.
+	*/
+	ObjectId GetId(uint32 index) const
+	{
+		CRY_ASSERT(index < m_count);
+
+		return (m_base & ~VariantMask) | ((m_base + index) & VariantMask);
+	}
+
+
+	/** Tests if an Id is one of the Ids in the range. */
+	bool Contains(ObjectId objectId) const
+	{
+		return ((objectId & ~VariantMask) == (m_base & ~VariantMask)) && (((objectId - m_base) & VariantMask) < m_count);
+	}
+
+
+	void Serialize(TSerialize& ser)
+	{
+		ser.Value("base", m_base);
+		ser.Value("count", m_count);
+	}
+
+private:
+	static const ObjectId VariantMask = CObjectIdFactory::MaxRandomVariant;
+
+	ObjectId m_base { CObjectIdFactory::InvalidId };
+	uint32 m_count { 0 };
+};
 }
\ No newline at end of file
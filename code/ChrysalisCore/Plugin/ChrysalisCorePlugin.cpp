@@ -19,6 +19,9 @@
 #include "Components/Animation/SimpleAnimationComponent.h"
 #include "Components/Compass/CompassComponent.h"
 #include "Components/Equipment/EquipmentComponent.h"
+#include "Components/Interaction/AwarenessGrid.h"
+#include "Components/Interaction/AwarenessRayBatch.h"
+#include "Components/Interaction/AwarenessScheduler.h"
 #include "Components/Interaction/DRSInteractionComponent.h"
 #include "Components/Interaction/EntityAwarenessComponent.h"
 #include "Components/Interaction/EntityInteractionComponent.h"
@@ -37,6 +40,7 @@
 #include "Components/Player/Camera/ActionRPGCameraComponent.h"
 #include "Components/Player/Camera/ExamineCameraComponent.h"
 #include "Components/Player/Camera/FirstPersonCameraComponent.h"
+#include "Components/TimePiece/NeedleSystem.h"
 #include "Components/TimePiece/TimePieceComponent.h"
 #include "Components/Gauge/GaugeComponent.h"
 #include "Console/CVars.h"
@@ -49,6 +53,7 @@
 #include "DynamicResponseSystem/ActionUnlock.h"
 #include "Entities/Interaction/DRSInteractionEntity.h"
 #include "Entities/SecurityPad/SecurityPadComponent.h"
+#include "Game/Cache/GameCache.h"
 #include "ObjectID/ObjectIdMasterFactory.h"
 #include "Schematyc/CoreEnv.h"
 
@@ -69,6 +74,13 @@ CChrysalisCorePlugin::~CChrysalisCorePlugin()
 		gEnv->pSchematyc->GetEnvRegistry().DeregisterPackage(GetSchematycPackageGUID());
 	}
 
+	SAFE_DELETE(m_pNeedleSystem);
+	SAFE_DELETE(m_pAwarenessRayBatch);
+	SAFE_DELETE(m_pAwarenessScheduler);
+	SAFE_DELETE(m_pAwarenessGrid);
+	SAFE_DELETE(m_pGameCache);
+	SAFE_DELETE(m_pObjectIdMasterFactory);
+
 	// Unregister all the cvars.
 	g_cvars.UnregisterVariables();
 }
@@ -230,10 +242,43 @@ bool CChrysalisCorePlugin::Initialize(SSystemGlobalEnvironment& env, const SSyst
 	// #TODO: Get the InstanceId from the command line or cvars.
 	m_pObjectIdMasterFactory = new CObjectIdMasterFactory(0);
 
+	m_pGameCache = new CGameCache();
+	m_pGameCache->Init();
+
+	m_pAwarenessGrid = new CAwarenessGrid();
+	m_pAwarenessScheduler = new CAwarenessScheduler();
+	m_pAwarenessRayBatch = new CAwarenessRayBatch();
+	m_pNeedleSystem = new CNeedleSystem();
+
+	// We need a main update to pump the per-frame game systems.
+	EnableUpdate(EUpdateStep::MainUpdate, true);
+
 	return true;
 }
 
 
+void CChrysalisCorePlugin::MainUpdate(float frameTime)
+{
+	if (m_pGameCache)
+		m_pGameCache->Update();
+
+	// Awareness is only needed while the game is running, not while editing.
+	if (!gEnv->IsEditing())
+	{
+		if (m_pAwarenessScheduler)
+			m_pAwarenessScheduler->Update();
+
+		// The components queue their rays during their updates, so this must come after the scheduler.
+		if (m_pAwarenessRayBatch)
+			m_pAwarenessRayBatch->Update(frameTime);
+	}
+
+	// Clocks and gauges are wanted in the editor too.
+	if (m_pNeedleSystem)
+		m_pNeedleSystem->Update();
+}
+
+
 void CChrysalisCorePlugin::OnSystemEvent(ESystemEvent event, UINT_PTR wparam, UINT_PTR lparam)
 {
 	switch (event)
@@ -310,7 +355,27 @@ void CChrysalisCorePlugin::OnSystemEvent(ESystemEvent event, UINT_PTR wparam, UI
 		}
 		break;
 
+		case ESYSTEM_EVENT_LEVEL_POST_UNLOAD:
+			if (m_pGameCache)
+				m_pGameCache->Reset();
+
+			// Entities should have removed themselves by now, but make sure nothing stale survives into the next level.
+			if (m_pAwarenessGrid)
+				m_pAwarenessGrid->Clear();
+
+			if (m_pAwarenessRayBatch)
+				m_pAwarenessRayBatch->Reset();
+			break;
+
 		case ESYSTEM_EVENT_LEVEL_LOAD_END:
+			// Bring in the assets for every item class while the loading screen is still up, so the first time an item is
+			// used it doesn't need to touch the disk.
+			if (m_pGameCache && !gEnv->IsEditor())
+			{
+				m_pGameCache->WarmupManifest();
+				m_pGameCache->FlushRequests();
+			}
+
 			// In the editor, we wait until now before attempting to connect to the local player. This is to ensure all the
 			// entities are already loaded and initialised. It works differently in game mode. 
 			if (gEnv->IsEditor())
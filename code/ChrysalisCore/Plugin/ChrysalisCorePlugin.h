@@ -10,6 +10,11 @@
 namespace Chrysalis
 {
 class CObjectIdMasterFactory;
+class CGameCache;
+class CAwarenessGrid;
+class CAwarenessRayBatch;
+class CAwarenessScheduler;
+class CNeedleSystem;
 
 
 /**
@@ -39,6 +44,7 @@ public:
 	virtual const char* GetName() const override { return "ChrysalisCore"; }
 	virtual const char* GetCategory() const override { return "Game"; }
 	virtual bool Initialize(SSystemGlobalEnvironment& env, const SSystemInitParams& initParams) override;
+	virtual void MainUpdate(float frameTime) override;
 	// ~ICryPlugin
 
 	// ISystemEventListener
@@ -70,6 +76,16 @@ public:
 
 	CObjectIdMasterFactory* GetObjectId() { return m_pObjectIdMasterFactory; }
 
+	CGameCache* GetGameCache() { return m_pGameCache; }
+
+	CAwarenessGrid* GetAwarenessGrid() { return m_pAwarenessGrid; }
+
+	CAwarenessScheduler* GetAwarenessScheduler() { return m_pAwarenessScheduler; }
+
+	CAwarenessRayBatch* GetAwarenessRayBatch() { return m_pAwarenessRayBatch; }
+
+	CNeedleSystem* GetNeedleSystem() { return m_pNeedleSystem; }
+
 protected:
 	// Map containing player components, key is the channel id received in OnClientConnectionReceived
 	std::unordered_map<int, EntityId> m_players;
@@ -78,5 +94,20 @@ protected:
 private:
 	/** The object identifier master factory. */
 	CObjectIdMasterFactory* m_pObjectIdMasterFactory { nullptr };
+
+	/** Cache for geometry, textures, materials and particles used by game items. */
+	CGameCache* m_pGameCache { nullptr };
+
+	/** Spatial hash of the interactable entities, shared by the awareness components. */
+	CAwarenessGrid* m_pAwarenessGrid { nullptr };
+
+	/** Spreads the awareness component updates across frames. */
+	CAwarenessScheduler* m_pAwarenessScheduler { nullptr };
+
+	/** Batches the forward rays from the awareness components into a deferred ray-cast queue. */
+	CAwarenessRayBatch* m_pAwarenessRayBatch { nullptr };
+
+	/** Poses the needles of the time pieces and gauges. */
+	CNeedleSystem* m_pNeedleSystem { nullptr };
 };
 }
\ No newline at end of file
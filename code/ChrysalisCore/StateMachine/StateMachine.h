@@ -4,6 +4,7 @@
 #include <CryString/StringUtils.h>
 #include <Utility/AutoEnum.h>
 #include <Utility/CryHash.h>
+#include <type_traits>
 
 
 namespace Chrysalis
@@ -27,6 +28,8 @@ AUTOENUM_BUILDENUMWITHTYPE_WITHNUMEQUALS_WITHZERO(EStateEvent, eStateEvents, STA
 
 #define MAX_NUM_PENDING_EVENTS 4
 #define MAX_HSMEVENT_DATA	5
+#define MAX_STATE_DEPTH	12
+#define MAX_STATE_COUNT	32
 
 
 template<typename HOST>
@@ -72,42 +75,33 @@ struct SStateEvent
 {
 public:
 
-	typedef CryFixedArray<SStateEventData, MAX_HSMEVENT_DATA>			TStateEventData;
-
-	SStateEvent() : m_eventType(EVENT_NONE)
+	SStateEvent() : m_eventType(EVENT_NONE), m_dataSize(0)
 #ifdef STATE_DEBUG
 		, m_debugContextAt(-1)
 #endif
 	{}
-	SStateEvent(int type) : m_eventType(type)
+	SStateEvent(int type) : m_eventType(type), m_dataSize(0)
 #ifdef STATE_DEBUG
 		, m_debugContextAt(-1)
 #endif
 	{}
 #ifdef STATE_DEBUG
-	SStateEvent(int type, SStateDebugContext& context) : m_eventType(type)
+	SStateEvent(int type, SStateDebugContext& context) : m_eventType(type), m_dataSize(0)
 		, m_debugContextAt(-1) {
 		AddDebugContext(context);
 	}
 #endif
 
-	SStateEvent(const SStateEvent& rhs)
-		: m_eventType(rhs.m_eventType)
-#ifdef STATE_DEBUG
-		, m_debugContextAt(rhs.m_debugContextAt)
-#endif
-	{
-		for (unsigned int i = 0; i < rhs.GetDataSize(); ++i)
-		{
-			AddData(rhs.GetData(i));
-		}
-	}
+	// Events are copied for every pending event and every debug log, so they're kept to plain data which copies as a
+	// single block.
+	SStateEvent(const SStateEvent& rhs) = default;
+	SStateEvent& operator=(const SStateEvent& rhs) = default;
 
-	void AddData(const SStateEventData& data) { m_data.push_back(data); }
-	const SStateEventData& GetData(uint8 index) const { return m_data [index]; }
+	void AddData(const SStateEventData& data) { CRY_ASSERT(m_dataSize < MAX_HSMEVENT_DATA); m_data [m_dataSize++] = data; }
+	const SStateEventData& GetData(uint8 index) const { CRY_ASSERT(index < m_dataSize); return m_data [index]; }
 	ILINE int GetEventId() const { return m_eventType; }
-	const unsigned int GetDataSize() const { return m_data.size(); }
-	void ClearData() { m_data.clear(); }
+	const unsigned int GetDataSize() const { return m_dataSize; }
+	void ClearData() { m_dataSize = 0; }
 
 	static SStateEvent CreateStateEvent(int type, const SStateEventData& data) { SStateEvent event(type); event.AddData(data); return event; }
 
@@ -115,11 +109,10 @@ public:
 	mutable int m_debugContextAt;
 	const SStateEvent& AddDebugContext(const SStateDebugContext& context) const
 	{
-		if (m_debugContextAt == -1 && m_data.size() < m_data.max_size())
+		if (m_debugContextAt == -1 && m_dataSize < MAX_HSMEVENT_DATA)
 		{
-			m_debugContextAt = m_data.size();
-			SStateEventData tmpData(&context);
-			m_data.push_back(tmpData);
+			m_debugContextAt = m_dataSize;
+			m_data [m_dataSize++] = SStateEventData(&context);
 		}
 		return *this;
 	}
@@ -131,9 +124,15 @@ private:
 #ifdef STATE_DEBUG
 	mutable
 #endif
-		TStateEventData	m_data;
+		uint8 m_dataSize;
+#ifdef STATE_DEBUG
+	mutable
+#endif
+		SStateEventData m_data [MAX_HSMEVENT_DATA];
 };
 
+static_assert(std::is_trivially_copyable<SStateEvent>::value, "State events are copied often and must stay trivially copyable.");
+
 struct SStateEventSerialize : public SStateEvent
 {
 	explicit SStateEventSerialize(TSerialize& ser)
@@ -331,7 +330,7 @@ class CStateProxy
 public:
 	typedef const SStateIndex<HOST>(CStateHierarchy<HOST>::*StatePtr)(HOST&, const SStateEvent&);
 	typedef CStateHierarchy<HOST>* (*CreateStatePtr)(CStateMachineRegistration<HOST>& stateMachineReg);
-	typedef void(*DeleteStatePtr)(CStateHierarchy<HOST>*&);
+	typedef void*(*DeleteStatePtr)(CStateHierarchy<HOST>*&);
 };
 
 template< typename HOST >
@@ -344,6 +343,9 @@ class CStateMachineRegistration
 		typename CStateProxy<HOST>::CreateStatePtr m_createPtr;
 		typename CStateProxy<HOST>::DeleteStatePtr m_deletePtr;
 
+		// Memory from deleted states of this type, kept to construct the next one in.
+		std::vector<void*> m_freeBlocks;
+
 		SStateFactory() {}
 		SStateFactory(typename CStateProxy<HOST>::CreateStatePtr createPtr, typename CStateProxy<HOST>::DeleteStatePtr deletePtr) :
 			m_createPtr(createPtr), m_deletePtr(deletePtr) {}
@@ -352,8 +354,18 @@ class CStateMachineRegistration
 	typedef std::vector<SStateFactory> TStateFactory;
 	TStateFactory m_factories;
 
+	// Counts of the state hierarchies for this host type.
+	uint32 m_liveCount { 0 };
+	uint32 m_peakCount { 0 };
+	uint32 m_allocatedCount { 0 };
+
 public:
 
+	~CStateMachineRegistration()
+	{
+		ReleaseFreeStates();
+	}
+
 	void RegisterState(typename CStateProxy<HOST>::CreateStatePtr createPtr, typename CStateProxy<HOST>::DeleteStatePtr deletePtr, const uint stateID)
 	{
 		const uint trueStateID = stateID - STATE_FIRST;
@@ -385,9 +397,67 @@ public:
 		const uint trueStateID = pState->GetStateID() - STATE_FIRST;
 		if (trueStateID < m_factories.size())
 		{
-			CALL_STATE_DELETE_FN(trueStateID)(pState);
+			// The state is destroyed, but its memory is kept for the next state of the same type.
+			m_factories [trueStateID].m_freeBlocks.push_back(CALL_STATE_DELETE_FN(trueStateID)(pState));
+			--m_liveCount;
+		}
+	}
+
+	/**
+	Gets memory for a new state hierarchy, from the states of the same type which have been deleted if possible. Only
+	the state class macros should need to call this.
+
+	\param	stateID	Identifier for the state hierarchy.
+	\param	size   	The size of the state hierarchy class.
+
+	\return Memory to construct the state hierarchy in.
+	**/
+	void* AllocateState(const uint stateID, size_t size)
+	{
+		const uint trueStateID = stateID - STATE_FIRST;
+		CRY_ASSERT(trueStateID < m_factories.size());
+
+		void* pBlock;
+		std::vector<void*>& freeBlocks = m_factories [trueStateID].m_freeBlocks;
+		if (!freeBlocks.empty())
+		{
+			pBlock = freeBlocks.back();
+			freeBlocks.pop_back();
+		}
+		else
+		{
+			pBlock = ::operator new(size);
+			++m_allocatedCount;
+		}
+
+		m_peakCount = max(m_peakCount, ++m_liveCount);
+
+		return pBlock;
+	}
+
+	/** Frees the memory kept from deleted state hierarchies. */
+	void ReleaseFreeStates()
+	{
+		for (auto& factory : m_factories)
+		{
+			for (void* pBlock : factory.m_freeBlocks)
+			{
+				::operator delete(pBlock);
+			}
+
+			m_allocatedCount -= static_cast<uint32>(factory.m_freeBlocks.size());
+			stl::free_container(factory.m_freeBlocks);
 		}
 	}
+
+	/** Gets the number of state hierarchies in use. */
+	uint32 GetLiveCount() const { return m_liveCount; }
+
+	/** Gets the most state hierarchies which have been in use at once. */
+	uint32 GetPeakCount() const { return m_peakCount; }
+
+	/** Gets the number of state hierarchies allocated, whether in use or waiting to be reused. */
+	uint32 GetAllocatedCount() const { return m_allocatedCount; }
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -399,32 +469,36 @@ struct SStateIndex
 	enum { UNDEFINED = -1 };
 
 	SStateIndex()
-		: m_name(CryHash(UNDEFINED)), m_func(0), m_stateID(UNDEFINED), m_hierarchy(UNDEFINED) {
+		: m_name(CryHash(UNDEFINED)), m_func(0), m_stateID(UNDEFINED), m_hierarchy(UNDEFINED), m_depth(0) {
 		DebugInit("UNDEFINED_NEED_TO_ADD_STATE_TO_HIERARCHY_BEFORE_TRANSITIONING_TO_IT");
 	}
 	SStateIndex(CryHash hashName)
-		: m_name(hashName), m_func(0), m_parent(nullptr), m_stateID(0), m_hierarchy(0) {
+		: m_name(hashName), m_func(0), m_parent(nullptr), m_stateID(0), m_hierarchy(0), m_depth(0) {
 		DebugInit("UnknownHash");
 	}
 	explicit SStateIndex(const char* pName)
-		: m_name(CryStringUtils::HashString(pName)), m_func(), m_parent(nullptr), m_stateID(0), m_hierarchy(0) {
+		: m_name(CryStringUtils::HashString(pName)), m_func(), m_parent(nullptr), m_stateID(0), m_hierarchy(0), m_depth(0) {
 		DebugInit(pName);
 	}
 	SStateIndex(const char* pName, typename CStateProxy<HOST>::StatePtr func, const SStateIndex<HOST>* parent, uint stateID)
-		: m_name(CryStringUtils::HashString(pName)), m_func(func), m_parent(parent), m_stateID((1ULL << static_cast<uint64>(stateID))), m_hierarchy(0) {
-		DebugInit(pName); RecursiveGenerateHierarchy(*this, m_hierarchy);
+		: m_name(CryStringUtils::HashString(pName)), m_func(func), m_parent(parent), m_stateID((1ULL << static_cast<uint64>(stateID))), m_hierarchy(0), m_depth(0) {
+		DebugInit(pName); RecursiveGenerateHierarchy(*this, m_hierarchy); GenerateChain(stateID);
 	}
-	SStateIndex(const SStateIndex& rhs) : m_name(rhs.m_name), m_func(rhs.m_func), m_parent(rhs.m_parent), m_stateID(rhs.m_stateID), m_hierarchy(rhs.m_hierarchy)
+	SStateIndex(const SStateIndex& rhs) : m_name(rhs.m_name), m_func(rhs.m_func), m_parent(rhs.m_parent), m_stateID(rhs.m_stateID), m_hierarchy(rhs.m_hierarchy),
+		m_depth(rhs.m_depth)
 #ifdef STATE_DEBUG
 		, m_pDebugName(rhs.m_pDebugName)
 #endif
-	{}
+	{
+		memcpy(m_chain, rhs.m_chain, m_depth);
+	}
 
 	bool operator==(const SStateIndex& rhs) const { return(m_name == rhs.m_name); }
 	bool operator!=(const SStateIndex& rhs) const { return(m_name != rhs.m_name); }
 	SStateIndex& operator=(const SStateIndex& rhs)
 	{
 		m_name = rhs.m_name; m_func = rhs.m_func; m_parent = rhs.m_parent;  m_stateID = rhs.m_stateID; m_hierarchy = rhs.m_hierarchy;
+		m_depth = rhs.m_depth; memcpy(m_chain, rhs.m_chain, m_depth);
 #ifdef STATE_DEBUG
 		m_pDebugName = rhs.m_pDebugName;
 #endif
@@ -437,6 +511,12 @@ struct SStateIndex
 	uint64 m_hierarchy;
 	uint m_stateID;
 
+	// The handler chain for this state, flattened when the hierarchy is declared. Entry 0 is this state and each entry
+	// after is the next parent up, through to the root. The entries index the hierarchy's m_stateIndexContainer, so
+	// dispatching an event is a walk along this array rather than along the m_parent pointers.
+	uint8 m_chain [MAX_STATE_DEPTH];
+	uint8 m_depth;
+
 #ifdef STATE_DEBUG
 	const char* m_pDebugName;
 #endif
@@ -455,6 +535,22 @@ private:
 			}
 		}
 	}
+
+	void GenerateChain(uint stateID)
+	{
+		// The state macros number the states from 1 in the order they are added to m_stateIndexContainer.
+		m_chain [0] = static_cast<uint8>(stateID - 1);
+		m_depth = 1;
+
+		if (m_parent)
+		{
+			CRY_ASSERT_MESSAGE(m_parent->m_depth < MAX_STATE_DEPTH, "HSM: State hierarchy is deeper than MAX_STATE_DEPTH.");
+
+			const uint8 parentDepth = min<uint8>(m_parent->m_depth, MAX_STATE_DEPTH - 1);
+			memcpy(m_chain + 1, m_parent->m_chain, parentDepth);
+			m_depth += parentDepth;
+		}
+	}
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -518,124 +614,156 @@ public:
 		}
 	}
 
-	static uint64 GenerateCommonParent(SStateIndex<HOST> stateCurrent, SStateIndex<HOST> stateCommon)
+	static uint64 GenerateCommonParent(const SStateIndex<HOST>& stateCurrent, const SStateIndex<HOST>& stateCommon)
 	{
-#ifdef STATE_DEBUG
-		SStateIndex<HOST> stateCurrentOriginal = stateCurrent;
-#endif
+		const SStateIndex<HOST>* pStateCurrent = &stateCurrent;
 
 		uint64 stateResult = stateCurrent.m_hierarchy & stateCommon.m_hierarchy;
 		if (stateResult != 0)
 		{
 			do
 			{
-				if ((stateResult & stateCurrent.m_stateID) == stateCurrent.m_stateID)
+				if ((stateResult & pStateCurrent->m_stateID) == pStateCurrent->m_stateID)
 				{
-					STATE_DEBUG_LOG(nullptr, "GenerateCommonParent: For: <%s> And: <%s> Is: <%s>", stateCurrentOriginal.m_pDebugName, stateCommon.m_pDebugName, stateCurrent.m_pDebugName);
+					STATE_DEBUG_LOG(nullptr, "GenerateCommonParent: For: <%s> And: <%s> Is: <%s>", stateCurrent.m_pDebugName, stateCommon.m_pDebugName, pStateCurrent->m_pDebugName);
 
-					return stateCurrent.m_stateID;
+					return pStateCurrent->m_stateID;
 				}
 
-				if (stateCurrent.m_parent)
+				if (pStateCurrent->m_parent)
 				{
-					stateCurrent = *stateCurrent.m_parent;
+					pStateCurrent = pStateCurrent->m_parent;
 				}
 			}
-			while (stateCurrent.m_parent != nullptr);
+			while (pStateCurrent->m_parent != nullptr);
 		}
-		return stateCurrent.m_stateID;
+		return pStateCurrent->m_stateID;
+	}
+
+	/** Gets the state at a level of a state's handler chain. Level 0 is the state itself. */
+	ILINE static const SStateIndex<HOST>& GetChainState(const STATE* pState, const SStateIndex<HOST>& state, uint level)
+	{
+		return *pState->m_stateIndexContainer [state.m_chain [level]];
 	}
 
-	static void RecursiveToCommonReverse(HOST& host, SStateIndex<HOST> stateCurrent, const uint64 stateCommonID, STATE* pState, const SStateEvent& event)
+	/** Gets the level of a state's handler chain which is the common parent, or the chain depth if it isn't on the chain. */
+	static uint GetChainCommonLevel(const STATE* pState, const SStateIndex<HOST>& state, const uint64 stateCommonID)
 	{
-		if (stateCurrent.m_stateID != stateCommonID)
+		for (uint level = 0; level < state.m_depth; ++level)
 		{
+			if (GetChainState(pState, state, level).m_stateID == stateCommonID)
+				return level;
+		}
 
-			if (stateCurrent.m_parent)
-			{
-				RecursiveToCommonReverse(host, *stateCurrent.m_parent, stateCommonID, pState, event);
-			}
+		return state.m_depth;
+	}
 
-			STATE_DEBUG_LOG(pState, "RecursiveToCommonReverse: Name: <%s>", stateCurrent.m_pDebugName);
+	static void RecursiveToCommonReverse(HOST& host, const SStateIndex<HOST>& stateCurrent, const uint64 stateCommonID, STATE* pState, const SStateEvent& event)
+	{
+		// Parents first, down to the state itself.
+		for (uint level = GetChainCommonLevel(pState, stateCurrent, stateCommonID); level-- > 0; )
+		{
+			const SStateIndex<HOST>& stateLevel = GetChainState(pState, stateCurrent, level);
 
-			CALL_SUBSTATE_FN(pState, stateCurrent)(host, STATE_DEBUG_RAW_EVENT_LOG(pState, STATE_DEBUG_EVENTONLY(stateCurrent.m_pDebugName, event)));
+			STATE_DEBUG_LOG(pState, "RecursiveToCommonReverse: Name: <%s>", stateLevel.m_pDebugName);
+
+			CALL_SUBSTATE_FN(pState, stateLevel)(host, STATE_DEBUG_RAW_EVENT_LOG(pState, STATE_DEBUG_EVENTONLY(stateLevel.m_pDebugName, event)));
 		}
 	}
 
-	static void RecursiveToCommon(HOST& host, SStateIndex<HOST> stateCurrent, const uint64 stateCommonID, STATE* pState, const SStateEvent& event)
+	static void RecursiveToCommon(HOST& host, const SStateIndex<HOST>& stateCurrent, const uint64 stateCommonID, STATE* pState, const SStateEvent& event)
 	{
-		if (stateCurrent.m_stateID != stateCommonID)
+		for (uint level = 0; level < stateCurrent.m_depth; ++level)
 		{
-			STATE_DEBUG_LOG(pState, "RecursiveToCommon: Name: <%s>", stateCurrent.m_pDebugName);
+			const SStateIndex<HOST>& stateLevel = GetChainState(pState, stateCurrent, level);
+			if (stateLevel.m_stateID == stateCommonID)
+				break;
 
-			const SStateIndex<HOST> stateReturn = CALL_SUBSTATE_FN(pState, stateCurrent)(host, STATE_DEBUG_RAW_EVENT_LOG(pState, STATE_DEBUG_EVENTONLY(stateCurrent.m_pDebugName, event)));
+			STATE_DEBUG_LOG(pState, "RecursiveToCommon: Name: <%s>", stateLevel.m_pDebugName);
 
-			if (stateCurrent.m_parent && stateReturn != pState->State_Done)
-			{
-				RecursiveToCommon(host, *stateCurrent.m_parent, stateCommonID, pState, event);
-			}
+			const SStateIndex<HOST> stateReturn = CALL_SUBSTATE_FN(pState, stateLevel)(host, STATE_DEBUG_RAW_EVENT_LOG(pState, STATE_DEBUG_EVENTONLY(stateLevel.m_pDebugName, event)));
+			if (stateReturn == pState->State_Done)
+				break;
 		}
 	}
 
-	static void StateMachineHandleEventForState(HOST& host, CStateMachineRegistration<HOST>& stateMachineReg, STATE*& pState, const SStateEvent& event, const uint64 commonID)
+	/**
+	Passes an event along the current state's handler chain, stopping at the first handler which doesn't return
+	State_Continue, or at the common parent.
+
+	\return The state which handled the event, or null if every handler continued. The handler's result is returned in
+	stateResult.
+	**/
+	static const SStateIndex<HOST>* BubbleEvent(HOST& host, STATE* pState, const SStateEvent& event, const uint64 commonID, SStateIndex<HOST>& stateResult)
 	{
-		STATE_DEBUG_LOG(pState, "HandleEvent: Name: <%s> Event: <%d>", pState->m_currentState.m_pDebugName, event.GetEventId());
+		const SStateIndex<HOST>& currentState = pState->m_currentState;
+
+		for (uint level = 0; level < currentState.m_depth; ++level)
+		{
+			const SStateIndex<HOST>& stateLevel = GetChainState(pState, currentState, level);
+			if (stateLevel.m_stateID == commonID)
+				break;
+
+			stateResult = CALL_SUBSTATE_FN(pState, stateLevel)(host, event);
+			if (stateResult.m_name != STATE_CONTINUE)
+				return &stateLevel;
+		}
+
+		stateResult = STATE_DONE;
+		return nullptr;
+	}
+
+	/**
+	Does the same as BubbleEvent by following the m_parent pointers, the way events were dispatched before the handler
+	chains were flattened. Only used to benchmark against.
+	**/
+	static void BubbleEventByParentWalk(HOST& host, STATE* pState, const SStateEvent& event, const uint64 commonID, SStateIndex<HOST>& stateResult)
+	{
+		SStateIndex<HOST> currentState = pState->m_currentState;
+		stateResult = STATE_DONE;
 
-		typename STATE::TStateIndex currentState = pState->m_currentState;
-		typename STATE::TStateIndex stateResult = STATE_DONE;
 		if (commonID != currentState.m_stateID)
 		{
 			stateResult = CALL_SUBSTATE_FN(pState, currentState)(host, event);
 		}
 
-		do
+		while (stateResult.m_name == STATE_CONTINUE)
 		{
-			STATE_DEBUG_LOG(pState, "HandleEvent: Name: <%s> Event: <%d>", pState->m_currentState.m_pDebugName, event.GetEventId());
+			if (currentState.m_parent != nullptr && currentState.m_parent->m_stateID != commonID)
+			{
+				stateResult = CALL_SUBSTATE_PARENT_FN(pState, currentState)(host, event);
 
-			switch (stateResult.m_name)
+				currentState = *currentState.m_parent;
+			}
+			else
 			{
-				case STATE_DONE:
-					break;
-				case STATE_CONTINUE:
-					if (currentState.m_parent != nullptr && currentState.m_parent->m_stateID != commonID)
-					{
-						stateResult = CALL_SUBSTATE_PARENT_FN(pState, currentState)(host, event);
+				stateResult = STATE_DONE;
+			}
+		}
+	}
 
-						currentState = *currentState.m_parent;
-					}
-					else
-					{
-						stateResult = STATE_DONE;
-					}
-					break;
-				default:
-					if (pState->m_currentState != stateResult)
-					{
-						// transition to new sub state.
-						pState->TransitionFromCurrentToSubState(host, stateMachineReg, stateResult);
+	static void StateMachineHandleEventForState(HOST& host, CStateMachineRegistration<HOST>& stateMachineReg, STATE*& pState, const SStateEvent& event, const uint64 commonID)
+	{
+		STATE_DEBUG_LOG(pState, "HandleEvent: Name: <%s> Event: <%d>", pState->m_currentState.m_pDebugName, event.GetEventId());
 
-						typename STATE::TStateIndex oldState = currentState;
+		typename STATE::TStateIndex stateResult = STATE_DONE;
+		const typename STATE::TStateIndex* pHandledBy = BubbleEvent(host, pState, event, commonID, stateResult);
 
-						// set the current state to the transitioned state
-						currentState = stateResult = pState->m_currentState;
+		// Any result other than done or continue is a state to transition to.
+		if (pHandledBy && (stateResult.m_name != STATE_DONE) && (pState->m_currentState != stateResult))
+		{
+			// transition to new sub state.
+			pState->TransitionFromCurrentToSubState(host, stateMachineReg, stateResult);
 
-						// then call the new state with the event which caused the transition,
-						// unless it was a system event (e.g. STATE_ENTER)
-						if (event.GetEventId() >= STATE_EVENT_CUSTOM)
-						{
-							const uint64 commonParent = CStateHelper<HOST, CStateHierarchy<HOST> >::GenerateCommonParent(oldState, pState->m_currentState);
+			// then call the new state with the event which caused the transition,
+			// unless it was a system event (e.g. STATE_ENTER)
+			if (event.GetEventId() >= STATE_EVENT_CUSTOM)
+			{
+				const uint64 commonParent = CStateHelper<HOST, CStateHierarchy<HOST> >::GenerateCommonParent(*pHandledBy, pState->m_currentState);
 
-							StateMachineHandleEventForState(host, stateMachineReg, pState, event, commonParent);
-						}
-					}
-					else
-					{
-						stateResult = STATE_DONE;
-					}
-					break;
+				StateMachineHandleEventForState(host, stateMachineReg, pState, event, commonParent);
 			}
 		}
-		while (stateResult.m_name != STATE_DONE && (currentState.m_parent != nullptr || stateResult.m_func != nullptr));
 
 		if (pState->m_pTransitionStateHierarchy)
 		{
@@ -717,7 +845,8 @@ protected:
 	const TStateIndex State_Done;
 	const TStateIndex State_Continue;
 
-	typedef std::vector<SStateIndex<HOST>*> TStateIndexContainer;
+	// Fixed size, so a state hierarchy is a single allocation which can be reused whole.
+	typedef CryFixedArray<SStateIndex<HOST>*, MAX_STATE_COUNT> TStateIndexContainer;
 	TStateIndexContainer m_stateIndexContainer;
 
 #ifdef STATE_DEBUG
@@ -761,24 +890,23 @@ private:
 	{
 		if ((m_currentState.m_stateID != stateID) || (m_currentState.m_hierarchy != stateHierarchy) || (m_currentState.m_name != stateName))
 		{
-			typename TStateIndexContainer::iterator it = m_stateIndexContainer.begin();
-			const typename TStateIndexContainer::const_iterator iEnd = m_stateIndexContainer.end();
-			for (; it != iEnd; ++it)
+			for (uint i = 0; i < m_stateIndexContainer.size(); ++i)
 			{
-				if ((*it)->m_stateID == stateID)
+				const TStateIndex* pStateIndex = m_stateIndexContainer [i];
+				if (pStateIndex->m_stateID == stateID)
 				{
-					if ((*it)->m_hierarchy != stateHierarchy)
+					if (pStateIndex->m_hierarchy != stateHierarchy)
 					{
 						CryLog("StateMachine: Failed to Serialize state as the hierarchy has changed!");
 						return false;
 					}
-					if ((*it)->m_name != stateName)
+					if (pStateIndex->m_name != stateName)
 					{
 						CryLog("StateMachine: Failed to Serialize state as the name has changed!");
 						return false;
 					}
 
-					TransitionFromCurrentToSubState(host, stateMachineReg, *(*it));
+					TransitionFromCurrentToSubState(host, stateMachineReg, *pStateIndex);
 					return true;
 				}
 			}
@@ -1115,7 +1243,7 @@ const SStateEvent SStateDebugContext::StateDebugAndLog(CStateHierarchy<HOST>* pS
 		public:\
 			stateClass( CStateMachineRegistration<host>& stateMachineReg ); \
 			static CStateHierarchy<host>* Create( CStateMachineRegistration<host>& stateMachineReg ); \
-			static void					 Delete( CStateHierarchy<host>*& pState ); \
+			static void*				 Delete( CStateHierarchy<host>*& pState ); \
 			static uint					 Register(); \
 			static void					 UnRegister(); \
 		private:
@@ -1131,8 +1259,8 @@ const SStateEvent SStateDebugContext::StateDebugAndLog(CStateHierarchy<HOST>* pS
 		DECLARE_STATE_CLASS_ADD( host, Root )
 
 #define DEFINE_STATE_CLASS_BEGIN( host, stateClass, stateId, defaultState )\
-		CStateHierarchy<host>* stateClass::Create( CStateMachineRegistration<host>& stateMachineReg ) { return new stateClass(stateMachineReg); } \
-		void					stateClass::Delete( CStateHierarchy<host>*& pState ) { SAFE_DELETE( pState ); } \
+		CStateHierarchy<host>* stateClass::Create( CStateMachineRegistration<host>& stateMachineReg ) { return new (stateMachineReg.AllocateState( stateId, sizeof(stateClass) )) stateClass(stateMachineReg); } \
+		void*					stateClass::Delete( CStateHierarchy<host>*& pState ) { stateClass* pStateClass = static_cast<stateClass*>(pState); pStateClass->~stateClass(); pState = nullptr; return pStateClass; } \
 		uint stateClass::Register() \
 		{ \
 			host::RegisterState( &stateClass::Create, &stateClass::Delete, stateId );\
@@ -0,0 +1,124 @@
+#include <StdAfx.h>
+
+#include "StateMachineBenchmark.h"
+
+
+namespace Chrysalis
+{
+DEFINE_STATE_MACHINE(CStateMachineBenchmark, Benchmark);
+
+
+class CStateBenchmark : private CStateHierarchy<CStateMachineBenchmark>
+{
+	DECLARE_STATE_CLASS_BEGIN(CStateMachineBenchmark, CStateBenchmark)
+	DECLARE_STATE_CLASS_ADD(CStateMachineBenchmark, Level1);
+	DECLARE_STATE_CLASS_ADD(CStateMachineBenchmark, Level2);
+	DECLARE_STATE_CLASS_ADD(CStateMachineBenchmark, Level3);
+	DECLARE_STATE_CLASS_ADD(CStateMachineBenchmark, Level4);
+	DECLARE_STATE_CLASS_ADD(CStateMachineBenchmark, Level5);
+	DECLARE_STATE_CLASS_END(CStateMachineBenchmark);
+};
+
+
+DEFINE_STATE_CLASS_BEGIN(CStateMachineBenchmark, CStateBenchmark, STATE_FIRST, Level5)
+DEFINE_STATE_CLASS_ADD(CStateMachineBenchmark, CStateBenchmark, Level1, Root)
+DEFINE_STATE_CLASS_ADD(CStateMachineBenchmark, CStateBenchmark, Level2, Level1)
+DEFINE_STATE_CLASS_ADD(CStateMachineBenchmark, CStateBenchmark, Level3, Level2)
+DEFINE_STATE_CLASS_ADD(CStateMachineBenchmark, CStateBenchmark, Level4, Level3)
+DEFINE_STATE_CLASS_ADD(CStateMachineBenchmark, CStateBenchmark, Level5, Level4)
+DEFINE_STATE_CLASS_END(CStateMachineBenchmark, CStateBenchmark);
+
+
+const CStateBenchmark::TStateIndex CStateBenchmark::Root(CStateMachineBenchmark& host, const SStateEvent& event)
+{
+	++host.m_handlerCalls;
+
+	return State_Done;
+}
+
+
+const CStateBenchmark::TStateIndex CStateBenchmark::Level1(CStateMachineBenchmark& host, const SStateEvent& event)
+{
+	++host.m_handlerCalls;
+
+	return State_Continue;
+}
+
+
+const CStateBenchmark::TStateIndex CStateBenchmark::Level2(CStateMachineBenchmark& host, const SStateEvent& event)
+{
+	++host.m_handlerCalls;
+
+	return State_Continue;
+}
+
+
+const CStateBenchmark::TStateIndex CStateBenchmark::Level3(CStateMachineBenchmark& host, const SStateEvent& event)
+{
+	++host.m_handlerCalls;
+
+	return State_Continue;
+}
+
+
+const CStateBenchmark::TStateIndex CStateBenchmark::Level4(CStateMachineBenchmark& host, const SStateEvent& event)
+{
+	++host.m_handlerCalls;
+
+	return State_Continue;
+}
+
+
+const CStateBenchmark::TStateIndex CStateBenchmark::Level5(CStateMachineBenchmark& host, const SStateEvent& event)
+{
+	++host.m_handlerCalls;
+
+	return State_Continue;
+}
+
+
+void CStateMachineBenchmark::Run(int iterations)
+{
+	typedef CStateHelper<CStateMachineBenchmark, CStateHierarchy<CStateMachineBenchmark>> TStateHelper;
+
+	iterations = max(iterations, 1);
+
+	CStateMachineBenchmark host;
+	CStateBenchmark state(*s_pStateMachineRegistrationBenchmark);
+	state.m_currentState = state.State_Level5;
+
+	CStateHierarchy<CStateMachineBenchmark>* pState = &state;
+	CStateHierarchy<CStateMachineBenchmark>::TStateIndex stateResult;
+
+	// Carry some data, the same as the movement update events do.
+	SStateEvent event(STATE_EVENT_CUSTOM);
+	event.AddData(0.016f);
+
+	auto timeDispatch = [iterations](const std::function<void()>& dispatch)
+	{
+		const CTimeValue startTime = gEnv->pTimer->GetAsyncTime();
+		for (int i = 0; i < iterations; ++i)
+			dispatch();
+
+		return (gEnv->pTimer->GetAsyncTime() - startTime).GetMilliSeconds() * 1000000.0f / static_cast<float>(iterations);
+	};
+
+	const float chainTime = timeDispatch([&]() { TStateHelper::BubbleEvent(host, pState, event, 0, stateResult); });
+	const uint32 chainCalls = host.m_handlerCalls;
+
+	host.m_handlerCalls = 0;
+	const float walkTime = timeDispatch([&]() { TStateHelper::BubbleEventByParentWalk(host, pState, event, 0, stateResult); });
+	const uint32 walkCalls = host.m_handlerCalls;
+
+	// The whole path a pending event takes through the state machine, including copying it out of the queue.
+	const float fullTime = timeDispatch([&]()
+	{
+		const SStateEvent pendingEvent = event;
+		TStateHelper::StateMachineHandleEventForState(host, *s_pStateMachineRegistrationBenchmark, pState, pendingEvent, 0);
+	});
+
+	CryLogAlways("State machine benchmark, %d events through %u handlers. Times are in nanoseconds per event.", iterations, static_cast<uint32>(state.State_Level5.m_depth));
+	CryLogAlways("%12s %12s %12s  %s", "chain", "parent walk", "full", "handlers");
+	CryLogAlways("%12.1f %12.1f %12.1f  %s", chainTime, walkTime, fullTime, chainCalls == walkCalls ? "match" : "MISMATCH");
+}
+}
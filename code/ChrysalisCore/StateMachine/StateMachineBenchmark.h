@@ -0,0 +1,31 @@
+/**
+\file	StateMachine\StateMachineBenchmark.h
+
+A small host and state hierarchy for timing event dispatch through the state machine. The hierarchy is as deep as the
+deepest of the actor movement states, and every state passes the event on to its parent, so each event visits the whole
+handler chain.
+**/
+#pragma once
+
+#include <StateMachine/StateMachine.h>
+
+
+namespace Chrysalis
+{
+class CStateMachineBenchmark
+{
+	DECLARE_STATE_MACHINE(CStateMachineBenchmark, Benchmark);
+
+public:
+	/**
+	Times dispatching events through the flattened handler chains against walking the parent states, and outputs the
+	results to the log.
+
+	\param	iterations	The number of events to dispatch for each timing.
+	**/
+	static void Run(int iterations);
+
+	/** Counts the handlers called, so the work can't be optimised away. */
+	uint32 m_handlerCalls { 0 };
+};
+}
@@ -103,30 +103,219 @@ bool AutoEnum_GetEnumValFromString(const char* inString, const char** inArray, i
 	return done;
 }
 
-#if !defined(_RELEASE) || defined(PERFORMANCE_BUILD)
-string AutoEnum_GetStringFromBitfield(TBitfield bitfield, const char** inArray, int arraySize)
+int SAutoEnumNameLookup::Find(const char* token, size_t length) const
 {
-	string    output;
-	TBitfield checkThis = 1;
+	for (uint32 slot = AutoEnum_HashName(token, length) & slotMask;; slot = (slot + 1) & slotMask)
+	{
+		if (slots [slot] == 0)
+			return -1;
 
-	assert(arraySize > 0);
+		const int index = slots [slot] - 1;
+		const char* name = names [index] + skipChars;
+		if ((strnicmp(name, token, length) == 0) && (name [length] == '\0'))
+			return index;
+	}
+}
 
-	char   skipThisString [32];
-	size_t skipChars = cry_copyStringUntilFindChar(skipThisString, inArray [0], sizeof(skipThisString), '_');
+TBitfield AutoEnum_GetBitfieldFromString(const char* inString, const SAutoEnumNameLookup& lookup)
+{
+	TBitfield reply = 0;
 
-	for (int i = 0; i < arraySize; ++i, checkThis <<= 1)
+	if (inString && inString [0] != '\0') // Avoid a load of work if the string's nullptr or empty
 	{
-		if (bitfield & checkThis)
+		const char* startFrom = inString;
+
+		for (;;)
 		{
-			if (!output.empty())
+			const char* endAt = strchr(startFrom, '|');
+			const size_t length = endAt ? static_cast<size_t>(endAt - startFrom) : strlen(startFrom);
+
+			const int index = lookup.Find(startFrom, length);
+			if (index >= 0)
 			{
-				output.append("|");
+				CRY_ASSERT_MESSAGE((reply & BIT(index)) == 0, string().Format("Bit '%.*s' already turned on! Does it feature more than once in string '%s'?", static_cast<int>(length), startFrom, inString));
+				reply |= BIT(index);
 			}
-			output.append(inArray [i] + skipChars);
+			CRY_ASSERT_MESSAGE(index >= 0, string().Format("No flag called '%.*s' in list", static_cast<int>(length), startFrom));
+
+			if (!endAt)
+				break;
+
+			startFrom = endAt + 1;
+		}
+	}
+
+	return reply;
+}
+
+bool AutoEnum_GetEnumValFromString(const char* inString, const SAutoEnumNameLookup& lookup, int* outVal)
+{
+	bool done = false;
+
+	if (inString && (inString [0] != '\0'))  // avoid a load of work if the string's nullptr or empty
+	{
+		const int index = lookup.Find(inString, strlen(inString));
+		if (index >= 0)
+		{
+			if (outVal)
+				(*outVal) = index;
+			done = true;
 		}
+		CRY_ASSERT_MESSAGE(done, string().Format("No flag called '%s' in enum list", inString));
 	}
 
-	return string().Format("%s%s", output.empty() ? "none" : output.c_str(), (bitfield >= checkThis) ? ", invalid bits found!" : "");
+	return done;
+}
+
+const char* AutoEnum_FormatBitfield(char* outBuffer, size_t bufferSize, TBitfield bitfield, const char* const* inArray, int arraySize)
+{
+	CRY_ASSERT(bufferSize > 0);
+	assert(arraySize > 0);
+
+	const size_t skipChars = AutoEnum_GetSkipChars(inArray [0]);
+	size_t length = 0;
+
+	auto append = [outBuffer, bufferSize, &length](const char* text)
+	{
+		while (*text && (length + 1 < bufferSize))
+			outBuffer [length++] = *text++;
+	};
+
+	for (int i = 0; i < arraySize; ++i)
+	{
+		if (bitfield & BIT(i))
+		{
+			if (length > 0)
+				append("|");
+
+			append(inArray [i] + skipChars);
+		}
+	}
+
+	if (length == 0)
+		append("none");
+
+	outBuffer [length] = '\0';
+
+	return outBuffer;
+}
+
+#if !defined(_RELEASE) || defined(PERFORMANCE_BUILD)
+string AutoEnum_GetStringFromBitfield(TBitfield bitfield, const char** inArray, int arraySize)
+{
+	char output [512];
+	AutoEnum_FormatBitfield(output, sizeof(output), bitfield, inArray, arraySize);
+
+	const bool hasInvalidBits = (arraySize < 32) && (bitfield >= BIT(arraySize));
+
+	return string().Format("%s%s", output, hasInvalidBits ? ", invalid bits found!" : "");
 }
 #endif
+
+#define autoEnumBenchmarkFlags(f) \
+	f(eAEB_Crouching) \
+	f(eAEB_Prone) \
+	f(eAEB_Sprinting) \
+	f(eAEB_Swimming) \
+	f(eAEB_Flying) \
+	f(eAEB_Ladder) \
+	f(eAEB_Ledge) \
+	f(eAEB_Sliding) \
+	f(eAEB_Falling) \
+	f(eAEB_Jumping) \
+	f(eAEB_Landing) \
+	f(eAEB_Stunned) \
+	f(eAEB_Dead) \
+	f(eAEB_InVehicle) \
+	f(eAEB_Aiming) \
+	f(eAEB_Firing) \
+	f(eAEB_Reloading) \
+	f(eAEB_Interacting) \
+	f(eAEB_Carrying) \
+	f(eAEB_Throwing) \
+	f(eAEB_Hidden) \
+	f(eAEB_Invulnerable) \
+	f(eAEB_Cinematic) \
+	f(eAEB_Ragdoll)
+
+AUTOENUM_BUILDNAMETABLE(s_autoEnumBenchmarkTable, autoEnumBenchmarkFlags);
+
+
+void AutoEnum_RunBenchmark(int iterations)
+{
+	const int stringCount = 64;
+	const char** names = const_cast<const char**>(s_autoEnumBenchmarkTable.GetNames());
+	const int nameCount = s_autoEnumBenchmarkTable.Size();
+
+	iterations = max(iterations, 1);
+
+	// A spread of flag strings, from one flag up to a handful, in mixed case as they tend to be in data files.
+	std::vector<string> flagStrings;
+	std::vector<TBitfield> bitfields;
+	for (int i = 0; i < stringCount; ++i)
+	{
+		TBitfield bitfield = 0;
+		const int flagCount = 1 + (i % 6);
+		for (int j = 0; j < flagCount; ++j)
+			bitfield |= BIT(cry_random(0, nameCount - 1));
+
+		char buffer [512];
+		string flagString = AutoEnum_FormatBitfield(buffer, sizeof(buffer), bitfield, names, nameCount);
+		if (i & 1)
+			flagString.MakeLower();
+
+		flagStrings.push_back(flagString);
+		bitfields.push_back(bitfield);
+	}
+
+	auto timeStrings = [iterations, stringCount](const std::function<void()>& process)
+	{
+		const CTimeValue startTime = gEnv->pTimer->GetAsyncTime();
+		for (int i = 0; i < iterations; ++i)
+			process();
+
+		return (gEnv->pTimer->GetAsyncTime() - startTime).GetMilliSeconds() * 1000000.0f / static_cast<float>(iterations * stringCount);
+	};
+
+	TBitfield checksum [2] = { 0, 0 };
+	bool isMatch = true;
+
+	const float scanTime = timeStrings([&]()
+	{
+		for (const auto& flagString : flagStrings)
+			checksum [0] += AutoEnum_GetBitfieldFromString(flagString.c_str(), names, nameCount);
+	});
+
+	const float hashTime = timeStrings([&]()
+	{
+		for (const auto& flagString : flagStrings)
+			checksum [1] += AutoEnum_GetBitfieldFromString(flagString.c_str(), s_autoEnumBenchmarkTable);
+	});
+
+	for (int i = 0; i < stringCount; ++i)
+		isMatch &= AutoEnum_GetBitfieldFromString(flagStrings [i].c_str(), s_autoEnumBenchmarkTable) == bitfields [i];
+
+	size_t formatLength = 0;
+	const float bufferTime = timeStrings([&]()
+	{
+		char buffer [512];
+		for (const auto bitfield : bitfields)
+			formatLength += strlen(AutoEnum_FormatBitfield(buffer, sizeof(buffer), bitfield, names, nameCount));
+	});
+
+#if !defined(_RELEASE) || defined(PERFORMANCE_BUILD)
+	const float stringTime = timeStrings([&]()
+	{
+		for (const auto bitfield : bitfields)
+			formatLength += AutoEnum_GetStringFromBitfield(bitfield, names, nameCount).length();
+	});
+#else
+	const float stringTime = 0.0f;
+#endif
+
+	CryLogAlways("AutoEnum benchmark, %d flag strings over %d names, %d iterations. Times are in nanoseconds per string.", stringCount, nameCount, iterations);
+	CryLogAlways("%12s %12s  %12s %12s  %s", "parse scan", "parse hash", "format str", "format buf", "results");
+	CryLogAlways("%12.1f %12.1f  %12.1f %12.1f  %s", scanTime, hashTime, stringTime, bufferTime,
+		(isMatch && (checksum [0] == checksum [1])) ? "match" : "MISMATCH");
+}
 }
\ No newline at end of file
@@ -31,12 +31,134 @@ typedef uint32 TBitfield;
 #define AUTOENUM_BUILDENUMWITHTYPE_WITHNUMEQUALS_WITHZERO(t,list,numName, num, zeroName) \
 	enum t { zeroName = 0, list(AUTOENUM_PARAM_1_COMMA) numName = num }
 #define AUTOENUM_BUILDNAMEARRAY(n,list)                                         const char* n[] =  {               list(AUTOENUM_PARAM_1_AS_STRING_COMMA) }
+#define AUTOENUM_BUILDNAMETABLE(n,list)                                         constexpr const char* n ## _names[] = { list(AUTOENUM_PARAM_1_AS_STRING_COMMA) }; \
+	constexpr CAutoEnumNameTable<sizeof(n ## _names) / sizeof(n ## _names [0])> n(n ## _names)
 #define AUTOENUM_BUILDFLAGS_WITHZERO(list,zeroName)                             enum                { zeroName = 0, list ## _neg1 = -1, list(AUTOENUM_DO_BITINDEX) list ## _numBits, list(AUTOENUM_DO_FLAG) }
 #define AUTOENUM_BUILDFLAGS_WITHZERO_WITHBITSUFFIX(list,zeroName)               enum                { zeroName = 0, list ## _neg1 = -1, list(AUTOENUM_DO_BITINDEX) list ## _numBits, list(AUTOENUM_DO_FLAG_WITHBITSUFFIX) }
 
+
+// Case folded FNV-1a hash of a name, stopping at the end of the string or after maxLength characters.
+constexpr uint32 AutoEnum_HashName(const char* name, size_t maxLength = ~size_t(0))
+{
+	uint32 hash = 2166136261u;
+	for (size_t i = 0; (i < maxLength) && (name [i] != '\0'); ++i)
+	{
+		const char c = ((name [i] >= 'A') && (name [i] <= 'Z')) ? static_cast<char>(name [i] - 'A' + 'a') : name [i];
+		hash = (hash ^ static_cast<uint8>(c)) * 16777619u;
+	}
+
+	return hash;
+}
+
+
+// The number of characters to skip at the start of each name, being everything up to and including the first
+// underscore in the first name. This matches the way the name array functions have always treated prefixes.
+constexpr size_t AutoEnum_GetSkipChars(const char* firstName)
+{
+	for (size_t i = 0; (i < 31) && (firstName [i] != '\0'); ++i)
+	{
+		if (firstName [i] == '_')
+			return i + 1;
+	}
+
+	return 0;
+}
+
+
+// The number of slots in the name table for an enumeration, a power of two at least twice the number of names.
+constexpr uint32 AutoEnum_GetSlotCount(size_t count)
+{
+	uint32 slotCount = 8;
+	while (slotCount < count * 2)
+		slotCount *= 2;
+
+	return slotCount;
+}
+
+
+// A view of a name table which the parsing functions can use, whatever the size of the table.
+struct SAutoEnumNameLookup
+{
+	const char* const* names;
+	int count;
+	size_t skipChars;
+	const uint8* slots;
+	uint32 slotMask;
+
+
+	/**
+	Finds a name, ignoring case and the skipped prefix.
+
+	\param	token 	The name to find. Doesn't need to be null terminated.
+	\param	length	The length of the name.
+
+	\return	The index of the name, or -1 if it isn't in the table.
+	**/
+	int Find(const char* token, size_t length) const;
+};
+
+
+// A hash table of the names in an enumeration, built at compile time by AUTOENUM_BUILDNAMETABLE. Open addressed at a
+// load factor of a half or below, so parsing a name is a hash and usually a single compare, however long the list.
+// The macro can be used at namespace scope, or prefixed with static inside a function.
+template <size_t Count>
+class CAutoEnumNameTable
+{
+	static_assert(Count < 255, "Name tables use a byte for each slot.");
+
+public:
+	static constexpr uint32 SlotCount = AutoEnum_GetSlotCount(Count);
+
+	constexpr CAutoEnumNameTable(const char* const (&names) [Count])
+		: m_names(names)
+		, m_skipChars(AutoEnum_GetSkipChars(names [0]))
+		, m_slots {}
+	{
+		for (size_t i = 0; i < Count; ++i)
+		{
+			uint32 slot = AutoEnum_HashName(names [i] + m_skipChars) & (SlotCount - 1);
+			while (m_slots [slot] != 0)
+				slot = (slot + 1) & (SlotCount - 1);
+
+			// Stored plus one, so zero is an empty slot.
+			m_slots [slot] = static_cast<uint8>(i + 1);
+		}
+	}
+
+	SAutoEnumNameLookup GetLookup() const { return { m_names, static_cast<int>(Count), m_skipChars, m_slots, SlotCount - 1 }; }
+
+	const char* const* GetNames() const { return m_names; }
+	static constexpr int Size() { return static_cast<int>(Count); }
+
+private:
+	const char* const* m_names;
+	size_t m_skipChars;
+	uint8 m_slots [SlotCount];
+};
+
+
 TBitfield AutoEnum_GetBitfieldFromString(const char* inString, const char** inArray, int arraySize);
 bool      AutoEnum_GetEnumValFromString(const char* inString, const char** inArray, int arraySize, int* outVal);
 
+// Versions which use a name table from AUTOENUM_BUILDNAMETABLE, so each name is found by hash rather than a scan.
+TBitfield AutoEnum_GetBitfieldFromString(const char* inString, const SAutoEnumNameLookup& lookup);
+bool      AutoEnum_GetEnumValFromString(const char* inString, const SAutoEnumNameLookup& lookup, int* outVal);
+
+template <size_t Count>
+TBitfield AutoEnum_GetBitfieldFromString(const char* inString, const CAutoEnumNameTable<Count>& table) { return AutoEnum_GetBitfieldFromString(inString, table.GetLookup()); }
+
+template <size_t Count>
+bool AutoEnum_GetEnumValFromString(const char* inString, const CAutoEnumNameTable<Count>& table, int* outVal) { return AutoEnum_GetEnumValFromString(inString, table.GetLookup(), outVal); }
+
+// Writes the names of the bits which are set into a buffer, separated by '|', or "none" if none are. The result is
+// truncated to fit the buffer. Returns the buffer, for convenience when logging. Unlike AutoEnum_GetStringFromBitfield
+// this is available in every build, since it doesn't allocate.
+const char* AutoEnum_FormatBitfield(char* outBuffer, size_t bufferSize, TBitfield bitfield, const char* const* inArray, int arraySize);
+
+// Times parsing a set of flag strings with the name tables against the scan of the name array, and formatting into a
+// buffer against building a string. Writes the results to the log.
+void AutoEnum_RunBenchmark(int iterations);
+
 #if !defined(_RELEASE) || defined(PERFORMANCE_BUILD)
 string AutoEnum_GetStringFromBitfield(TBitfield bitfield, const char** inArray, int arraySize);
 #else
@@ -0,0 +1,107 @@
+#include <StdAfx.h>
+
+#include "CharacterBindings.h"
+#include <CryCore/CryCrc32.h>
+
+
+namespace Chrysalis
+{
+void CCharacterBindings::Refresh(ICharacterInstance* pCharacter)
+{
+	if (!pCharacter)
+	{
+		Invalidate();
+		return;
+	}
+
+	IAttachmentManager* pAttachmentManager = pCharacter->GetIAttachmentManager();
+	const int32 attachmentCount = pAttachmentManager ? pAttachmentManager->GetAttachmentCount() : 0;
+
+	// Attachment indices shift when attachments are added or removed, so a change in the count needs them found again.
+	if ((pCharacter != m_pCharacter) || (&pCharacter->GetIDefaultSkeleton() != m_pSkeleton)
+		|| (pAttachmentManager != m_pAttachmentManager) || (attachmentCount != m_attachmentCount))
+	{
+		m_pCharacter = pCharacter;
+		m_pSkeleton = &pCharacter->GetIDefaultSkeleton();
+		m_pAttachmentManager = pAttachmentManager;
+		m_attachmentCount = attachmentCount;
+
+		Resolve();
+	}
+}
+
+
+void CCharacterBindings::Invalidate()
+{
+	m_pCharacter = nullptr;
+	m_pSkeleton = nullptr;
+	m_pAttachmentManager = nullptr;
+	m_attachmentCount = -1;
+
+	for (auto& binding : m_bindings)
+		binding.index = -1;
+}
+
+
+IAttachment* CCharacterBindings::GetAttachment(THandle handle) const
+{
+	CRY_ASSERT_MESSAGE((handle >= 0) && (handle < static_cast<THandle>(m_bindings.size())), "Invalid character binding handle.");
+	CRY_ASSERT_MESSAGE(m_bindings [handle].type == EBindingType::Attachment, "The character binding isn't an attachment.");
+
+	const SBinding& binding = m_bindings [handle];
+	if ((binding.index < 0) || !m_pAttachmentManager)
+		return nullptr;
+
+	IAttachment* pAttachment = m_pAttachmentManager->GetInterfaceByIndex(binding.index);
+
+	// An attachment could have been swapped for another without the count changing. Checking the CRC catches that
+	// without going back to the name.
+	if (pAttachment && (pAttachment->GetNameCRC() == binding.nameCRC))
+		return pAttachment;
+
+	return m_pAttachmentManager->GetInterfaceByNameCRC(binding.nameCRC);
+}
+
+
+int32 CCharacterBindings::GetJointId(THandle handle) const
+{
+	CRY_ASSERT_MESSAGE((handle >= 0) && (handle < static_cast<THandle>(m_bindings.size())), "Invalid character binding handle.");
+	CRY_ASSERT_MESSAGE(m_bindings [handle].type == EBindingType::Joint, "The character binding isn't a joint.");
+
+	return m_bindings [handle].index;
+}
+
+
+CCharacterBindings::THandle CCharacterBindings::AddBinding(const char* szName, EBindingType type)
+{
+	SBinding binding;
+	binding.type = type;
+	binding.nameCRC = CCrc32::ComputeLowercase(szName);
+	binding.index = -1;
+	m_bindings.push_back(binding);
+
+	// Bind it straight away if we already have a character.
+	if (m_pCharacter)
+		Resolve();
+
+	return static_cast<THandle>(m_bindings.size()) - 1;
+}
+
+
+void CCharacterBindings::Resolve()
+{
+	for (auto& binding : m_bindings)
+	{
+		switch (binding.type)
+		{
+			case EBindingType::Attachment:
+				binding.index = m_pAttachmentManager ? m_pAttachmentManager->GetIndexByNameCRC(binding.nameCRC) : -1;
+				break;
+
+			case EBindingType::Joint:
+				binding.index = m_pSkeleton->GetJointIDByCRC32(binding.nameCRC);
+				break;
+		}
+	}
+}
+}
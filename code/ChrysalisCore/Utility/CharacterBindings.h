@@ -0,0 +1,112 @@
+#pragma once
+
+#include <CryAnimation/ICryAnimation.h>
+
+
+namespace Chrysalis
+{
+/**
+Resolves a set of named attachments and joints on a character once, and hands back index-based handles so code which
+queries them every frame doesn't hash their names each time.
+
+Add the names up front, usually when the component is initialised, and keep the handles. Call Refresh with the current
+character before using the handles each frame. It re-resolves the names only when the character, its skeleton or its
+number of attachments has changed, so for the usual case it is a few pointer compares.
+**/
+class CCharacterBindings
+{
+public:
+	/** A handle to a binding, being its index in the order the names were added. */
+	typedef int THandle;
+
+	/** Magic number to signify a handle that was never bound. */
+	static const THandle InvalidHandle = -1;
+
+
+	/**
+	Adds an attachment to be bound on the character.
+
+	\param	szName	The name of the attachment.
+
+	\return	A handle to the binding.
+	**/
+	THandle AddAttachment(const char* szName) { return AddBinding(szName, EBindingType::Attachment); }
+
+
+	/**
+	Adds a joint to be bound on the character's skeleton.
+
+	\param	szName	The name of the joint.
+
+	\return	A handle to the binding.
+	**/
+	THandle AddJoint(const char* szName) { return AddBinding(szName, EBindingType::Joint); }
+
+
+	/**
+	Makes sure the bindings belong to this character, resolving them again if it or its skeleton has changed since the
+	last call.
+
+	\param [in,out]	pCharacter	The character, which may be null if it hasn't loaded yet.
+	**/
+	void Refresh(ICharacterInstance* pCharacter);
+
+
+	/** Forgets the character, so the next call to Refresh resolves the names again. */
+	void Invalidate();
+
+
+	/**
+	Gets an attachment bound by AddAttachment.
+
+	\param	handle	The handle returned when the attachment was added.
+
+	\return	The attachment, or null if the character doesn't have one with that name.
+	**/
+	IAttachment* GetAttachment(THandle handle) const;
+
+
+	/**
+	Gets the Id of a joint bound by AddJoint.
+
+	\param	handle	The handle returned when the joint was added.
+
+	\return	The joint Id, or -1 if the skeleton doesn't have one with that name.
+	**/
+	int32 GetJointId(THandle handle) const;
+
+
+	/** Gets the character the bindings were last resolved against. */
+	ICharacterInstance* GetCharacter() const { return m_pCharacter; }
+
+private:
+	enum class EBindingType
+	{
+		Attachment,
+		Joint
+	};
+
+	struct SBinding
+	{
+		EBindingType type;
+
+		/** The lower case CRC of the name, which is how the attachment manager and skeleton index their names. */
+		uint32 nameCRC;
+
+		/** The attachment index or joint Id, or -1 if it wasn't found on this character. */
+		int32 index;
+	};
+
+	THandle AddBinding(const char* szName, EBindingType type);
+	void Resolve();
+
+	std::vector<SBinding> m_bindings;
+
+	// The character, skeleton and attachment count the bindings were resolved against. The character owns the
+	// skeleton and attachments, so none of these are held.
+	ICharacterInstance* m_pCharacter { nullptr };
+	const IDefaultSkeleton* m_pSkeleton { nullptr };
+	IAttachmentManager* m_pAttachmentManager { nullptr };
+	int32 m_attachmentCount { -1 };
+};
+}
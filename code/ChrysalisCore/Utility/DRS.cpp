@@ -35,5 +35,24 @@ bool GetValueOrDefault(const DRS::IVariableCollectionSharedPtr pContextVariables
 	auto variable = pContextVariables->GetVariable(name);
 	return variable ? variable->GetValueAsBool() : default;
 }
+
+
+DRS::IVariableCollectionSharedPtr CContextCollectionPool::Acquire()
+{
+	// The DRS keeps hold of a collection while the signal it was sent with is queued or being responded to, so one
+	// we are the only owner of is free to use again.
+	for (auto& pCollection : m_collections)
+	{
+		if (pCollection.use_count() == 1)
+			return pCollection;
+	}
+
+	auto pCollection = gEnv->pDynamicResponseSystem->CreateContextCollection();
+
+	if (m_collections.size() < MaxPooledCollections)
+		m_collections.push_back(pCollection);
+
+	return pCollection;
+}
 }
 }
\ No newline at end of file
@@ -12,5 +12,32 @@ int GetValueOrDefault(const DRS::IVariableCollectionSharedPtr pContextVariables,
 float GetValueOrDefault(const DRS::IVariableCollectionSharedPtr pContextVariables, const CHashedString& name, const float default);
 CHashedString GetValueOrDefault(const DRS::IVariableCollectionSharedPtr pContextVariables, const CHashedString& name, const CHashedString default);
 bool GetValueOrDefault(const DRS::IVariableCollectionSharedPtr pContextVariables, const CHashedString& name, const bool default);
+
+
+/**
+Hands out context variable collections for sending with signals, reusing them once the DRS has finished with them.
+Each pool should only be used by one sender, which sets the same variables every time, so any variables left over from
+the last use are overwritten rather than carried along.
+**/
+class CContextCollectionPool
+{
+public:
+	/**
+	Gets a collection which nothing else holds a reference to, creating a new one if they are all still in use.
+
+	\return	The collection.
+	**/
+	DRS::IVariableCollectionSharedPtr Acquire();
+
+
+	/** Releases all the pooled collections. */
+	void Clear() { m_collections.clear(); }
+
+private:
+	/** Beyond this many collections in use at once, new ones are handed out without being pooled. */
+	static const size_t MaxPooledCollections = 8;
+
+	std::vector<DRS::IVariableCollectionSharedPtr> m_collections;
+};
 }
 }
\ No newline at end of file
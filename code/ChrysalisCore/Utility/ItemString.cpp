@@ -0,0 +1,241 @@
+#include <StdAfx.h>
+
+#include "ItemString.h"
+
+
+namespace Chrysalis
+{
+namespace SharedString
+{
+CNameTable::SSlots::SSlots(uint32 slotCount)
+	: mask(slotCount - 1)
+	, slots(new std::atomic<SNameEntry*> [slotCount])
+{
+	CRY_ASSERT_MESSAGE((slotCount & mask) == 0, "The slot count must be a power of two.");
+
+	for (uint32 i = 0; i < slotCount; ++i)
+		slots [i].store(nullptr, std::memory_order_relaxed);
+}
+
+
+CNameTable::SShard::SShard()
+{
+	slotTables.emplace_back(new SSlots(InitialSlotCount));
+	pSlots.store(slotTables.back().get(), std::memory_order_release);
+}
+
+
+CNameTable::CNameTable()
+{
+#if SHARED_STRING_TRACK_LEVEL_HEAP_LEAKS
+	m_trackLevelHeapAllocs = false;
+#endif
+}
+
+
+CNameTable::~CNameTable()
+{
+	for (auto& shard : m_shards)
+	{
+		for (char* pBlock : shard.blocks)
+			free(pBlock);
+	}
+}
+
+
+SNameEntry* CNameTable::FindEntry(const char* str) const
+{
+	const uint32 hash = CryStringUtils::HashString(str);
+	const SSlots* pSlots = GetShard(hash).pSlots.load(std::memory_order_acquire);
+
+	return Probe(*pSlots, str, hash);
+}
+
+
+SNameEntry* CNameTable::GetEntry(const char* str)
+{
+	const uint32 hash = CryStringUtils::HashString(str);
+	SShard& shard = GetShard(hash);
+
+	// Most strings are already in the table, and finding them doesn't need the lock.
+	if (SNameEntry* pEntry = Probe(*shard.pSlots.load(std::memory_order_acquire), str, hash))
+		return pEntry;
+
+	CryAutoLock<CryCriticalSectionNonRecursive> lock(shard.lock);
+
+	// Another thread may have added it while we were waiting.
+	SSlots* pSlots = shard.pSlots.load(std::memory_order_relaxed);
+	if (SNameEntry* pEntry = Probe(*pSlots, str, hash))
+		return pEntry;
+
+	// Keep the load factor at a half or below, so probes stay short.
+	if ((shard.entryCount + 1) * 2 > pSlots->mask + 1)
+	{
+		Grow(shard);
+		pSlots = shard.pSlots.load(std::memory_order_relaxed);
+	}
+
+	SNameEntry* pEntry = Allocate(shard, str, static_cast<int>(strlen(str)), hash);
+	Insert(*pSlots, pEntry);
+	++shard.entryCount;
+
+	return pEntry;
+}
+
+
+size_t CNameTable::GetEntryCount() const
+{
+	size_t entryCount = 0;
+	for (const auto& shard : m_shards)
+		entryCount += shard.entryCount;
+
+	return entryCount;
+}
+
+
+void CNameTable::Dump()
+{
+	CryLogAlways("NameTable: %" PRISIZE_T " entries", GetEntryCount());
+
+	VisitEntries([](SNameEntry& entry)
+	{
+		CryLogAlways("'%s'", entry.GetStr());
+	});
+}
+
+
+void CNameTable::GetMemoryUsage(ICrySizer* pSizer) const
+{
+	for (const auto& shard : m_shards)
+	{
+		// The arena size includes the unused space at the end of each block.
+		pSizer->AddObject(shard.blocks.data(), shard.arenaSize);
+		pSizer->AddContainer(shard.blocks);
+		pSizer->AddContainer(shard.slotTables);
+
+		for (const auto& pSlots : shard.slotTables)
+			pSizer->AddObject(pSlots->slots.get(), (pSlots->mask + 1) * sizeof(std::atomic<SNameEntry*>));
+	}
+}
+
+
+#if SHARED_STRING_TRACK_LEVEL_HEAP_LEAKS
+void CNameTable::DumpLevelHeapLeakedStrings()
+{
+	VisitEntries([](SNameEntry& entry)
+	{
+		if (entry.allocatedOnLevelHeap && (entry.nRefCount > 0))
+		{
+			CRY_ASSERT_TRACE(false, ("Level allocated SharedString leaking '%s'", entry.GetStr()));
+			CryLogAlways("Level allocated SharedString leaking '%s' : Ref count: '%d'", entry.GetStr(), static_cast<int>(entry.nRefCount));
+		}
+	});
+}
+#endif
+
+
+SNameEntry* CNameTable::Probe(const SSlots& slots, const char* str, uint32 hash)
+{
+	for (uint32 index = hash & slots.mask;; index = (index + 1) & slots.mask)
+	{
+		SNameEntry* pEntry = slots.slots [index].load(std::memory_order_acquire);
+
+		// Entries are never removed, so the first empty slot ends the search.
+		if (!pEntry)
+			return nullptr;
+
+		if ((pEntry->nHash == hash) && (strcmp(pEntry->GetStr(), str) == 0))
+			return pEntry;
+	}
+}
+
+
+void CNameTable::Insert(SSlots& slots, SNameEntry* pEntry)
+{
+	uint32 index = pEntry->nHash & slots.mask;
+	while (slots.slots [index].load(std::memory_order_relaxed))
+		index = (index + 1) & slots.mask;
+
+	// Release, so a reader which sees the pointer also sees the entry it points to.
+	slots.slots [index].store(pEntry, std::memory_order_release);
+}
+
+
+template <typename TVisitor>
+void CNameTable::VisitEntries(TVisitor&& visitor)
+{
+	for (auto& shard : m_shards)
+	{
+		CryAutoLock<CryCriticalSectionNonRecursive> lock(shard.lock);
+
+		const SSlots& slots = *shard.pSlots.load(std::memory_order_relaxed);
+		for (uint32 i = 0; i <= slots.mask; ++i)
+		{
+			if (SNameEntry* pEntry = slots.slots [i].load(std::memory_order_relaxed))
+				visitor(*pEntry);
+		}
+	}
+}
+
+
+SNameEntry* CNameTable::Allocate(SShard& shard, const char* str, int length, uint32 hash)
+{
+	// Round up so the next entry in the block is aligned.
+	const size_t alignment = alignof(SNameEntry);
+	const size_t size = (sizeof(SNameEntry) + length + 1 + alignment - 1) & ~(alignment - 1);
+
+	char* pMemory;
+	if (size > ArenaBlockSize / 4)
+	{
+		// Long strings get a block to themselves, rather than wasting the rest of the current block.
+		pMemory = (char*)malloc(size);
+		shard.blocks.insert(shard.blocks.end() - (shard.blocks.empty() ? 0 : 1), pMemory);
+		shard.arenaSize += size;
+	}
+	else
+	{
+		if (shard.blockFree < size)
+		{
+			shard.blocks.push_back((char*)malloc(ArenaBlockSize));
+			shard.blockFree = ArenaBlockSize;
+			shard.arenaSize += ArenaBlockSize;
+		}
+
+		pMemory = shard.blocks.back() + (ArenaBlockSize - shard.blockFree);
+		shard.blockFree -= size;
+	}
+
+	SNameEntry* pEntry = new(pMemory) SNameEntry;
+	pEntry->nHash = hash;
+	pEntry->nLength = length;
+#if SHARED_STRING_TRACK_LEVEL_HEAP_LEAKS
+	pEntry->nRefCount = 0;
+	pEntry->allocatedOnLevelHeap = m_trackLevelHeapAllocs;
+#endif
+
+	// Copy string to the end of name entry.
+	memcpy(pEntry->GetStr(), str, length + 1);
+
+	return pEntry;
+}
+
+
+void CNameTable::Grow(SShard& shard)
+{
+	const SSlots& oldSlots = *shard.pSlots.load(std::memory_order_relaxed);
+
+	shard.slotTables.emplace_back(new SSlots((oldSlots.mask + 1) * 2));
+	SSlots& newSlots = *shard.slotTables.back();
+
+	for (uint32 i = 0; i <= oldSlots.mask; ++i)
+	{
+		if (SNameEntry* pEntry = oldSlots.slots [i].load(std::memory_order_relaxed))
+			Insert(newSlots, pEntry);
+	}
+
+	// Readers still probing the old slots will miss anything added from now on, but GetEntry checks again under the
+	// lock before adding, so a string is never added twice.
+	shard.pSlots.store(&newSlots, std::memory_order_release);
+}
+}
+}
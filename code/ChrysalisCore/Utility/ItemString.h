@@ -17,7 +17,9 @@
 #endif
 
 #include <CrySystem/ISystem.h>
-#include <StlUtils.h>
+#include <CryThreading/CryThread.h>
+#include <atomic>
+#include <memory>
 
 namespace Chrysalis
 {
@@ -29,89 +31,51 @@ namespace Chrysalis
 
 namespace SharedString
 {
-// Name entry header, immediately after this header in memory starts actual string data.
+// Name entry header, immediately after this header in memory starts actual string data. Entries live in the name table's
+// arena and are never freed individually, so a pointer to one stays valid for the life of the table and can be shared
+// between threads freely.
 struct SNameEntry
 {
-	int nRefCount;      // Reference count of this string.
-	int nLength;        // Current length of string.
-	int nAllocSize;     // Size of memory allocated at the end of this class.
+	uint32 nHash;       // Hash of the string, compared before the characters when probing.
+	int nLength;        // Length of string.
 #if SHARED_STRING_TRACK_LEVEL_HEAP_LEAKS
+	std::atomic<int> nRefCount;     // Reference count of this string. Only kept to report leaked level strings.
 	bool allocatedOnLevelHeap;
 #endif
 
-	// Here in memory starts character buffer of size nAllocSize.
-	//char data[nAllocSize]
+	// Here in memory starts the character buffer of size nLength + 1.
+	//char data[nLength + 1]
 
 	char* GetStr() { return (char*)(this + 1); }
+#if SHARED_STRING_TRACK_LEVEL_HEAP_LEAKS
 	void AddRef() { ++nRefCount; }
 	int  Release() { return --nRefCount; }
+#endif
 };
 
 //////////////////////////////////////////////////////////////////////////
+// An intern table for the shared strings. The entries are split across shards by hash, and each shard is an open
+// addressed hash table of pointers to entries in an arena. Lookups never lock, so any thread can find a string. Adding a
+// string locks only the shard it belongs in, and a shard which grows keeps its old slots alive until the table is
+// destroyed, for the sake of any reader still probing them.
 class CNameTable
 {
 public:
-	CNameTable()
-	{
-#if SHARED_STRING_TRACK_LEVEL_HEAP_LEAKS
-		m_trackLevelHeapAllocs = false;
-#endif
-	}
-
-	~CNameTable()
-	{}
+	CNameTable();
+	~CNameTable();
 
 	// Only finds an existing name table entry, return 0 if not found.
-	SNameEntry* FindEntry(const char* str)
-	{
-		SNameEntry* pEntry = stl::find_in_map(m_nameMap, str, 0);
-		return pEntry;
-	}
+	SNameEntry* FindEntry(const char* str) const;
 
 	// Finds an existing name table entry, or creates a new one if not found.
-	SNameEntry* GetEntry(const char* str)
-	{
-		SNameEntry* pEntry = stl::find_in_map(m_nameMap, str, 0);
-		if (!pEntry)
-		{
-			// Create a new entry.
-			unsigned int nLen = strlen(str);
-			unsigned int allocLen = sizeof(SNameEntry) + (nLen + 1) * sizeof(char);
-			pEntry = (SNameEntry*)malloc(allocLen);
-			pEntry->nRefCount = 0;
-			pEntry->nLength = nLen;
-			pEntry->nAllocSize = allocLen;
-#if SHARED_STRING_TRACK_LEVEL_HEAP_LEAKS
-			pEntry->allocatedOnLevelHeap = (m_trackLevelHeapAllocs);
-#endif
-			// Copy string to the end of name entry.
-			memcpy(pEntry->GetStr(), str, nLen + 1);
+	SNameEntry* GetEntry(const char* str);
 
-			// put in map.
-			m_nameMap.insert(NameMap::value_type(pEntry->GetStr(), pEntry));
-		}
-		return pEntry;
-	}
+	// Gets the number of entries in the table.
+	size_t GetEntryCount() const;
 
-	// Release existing name table entry.
-	void Release(SNameEntry* pEntry)
-	{
-		assert(pEntry);
-		m_nameMap.erase(pEntry->GetStr());
-		free(pEntry);
-	}
+	void Dump();
 
-	void Dump()
-	{
-		CryLogAlways("NameTable: %" PRISIZE_T " entries", m_nameMap.size());
-		NameMap::const_iterator iter = m_nameMap.begin();
-		NameMap::const_iterator iterEnd = m_nameMap.end();
-		while (iter != iterEnd)
-		{
-			CryLogAlways("'%s'", iter->first);
-			++iter;
-		}
-	}
+	void GetMemoryUsage(ICrySizer* pSizer) const;
 
 #if SHARED_STRING_TRACK_LEVEL_HEAP_LEAKS
 	void TrackLevelHeapAllocs(bool trackAllocs)
@@ -119,27 +83,62 @@ public:
 		m_trackLevelHeapAllocs = trackAllocs;
 	}
 
-	void DumpLevelHeapLeakedStrings()
-	{
-		NameMap::const_iterator iter = m_nameMap.begin();
-		NameMap::const_iterator iterEnd = m_nameMap.end();
-		while (iter != iterEnd)
-		{
-			if (iter->second->allocatedOnLevelHeap)
-			{
-				CRY_ASSERT_TRACE(false, ("Level allocated SharedString leaking '%s'", iter->first));
-				CryLogAlways("Level allocated SharedString leaking '%s' : Ref count: '%d'", iter->first, iter->second->nRefCount);
-			}
-			++iter;
-		}
-	}
+	void DumpLevelHeapLeakedStrings();
 #endif
 
 private:
-	typedef std::unordered_map<const char*, SNameEntry*, stl::hash_strcmp<const char*>, stl::hash_strcmp<const char*> > NameMap;
-	NameMap m_nameMap;
+	static const uint32 ShardBits = 4;
+	static const uint32 ShardCount = 1 << ShardBits;
+	static const uint32 InitialSlotCount = 64;
+	static const size_t ArenaBlockSize = 16 * 1024;
+
+	// An open addressed table of entries. Empty slots are null.
+	struct SSlots
+	{
+		explicit SSlots(uint32 slotCount);
+
+		uint32 mask;
+		std::unique_ptr<std::atomic<SNameEntry*> []> slots;
+	};
+
+	struct SShard
+	{
+		SShard();
+
+		// The slots readers should probe. Replaced when the shard grows.
+		std::atomic<SSlots*> pSlots;
+
+		// Everything below is only touched while holding the lock.
+		CryCriticalSectionNonRecursive lock;
+
+		std::atomic<uint32> entryCount { 0 };
+
+		// The current slots and all those it has replaced.
+		std::vector<std::unique_ptr<SSlots>> slotTables;
+
+		// The arena, with the free space remaining in the last block.
+		std::vector<char*> blocks;
+		size_t blockFree { 0 };
+		size_t arenaSize { 0 };
+	};
+
+	static SNameEntry* Probe(const SSlots& slots, const char* str, uint32 hash);
+	static void Insert(SSlots& slots, SNameEntry* pEntry);
+
+	SShard& GetShard(uint32 hash) { return m_shards [hash >> (32 - ShardBits)]; }
+	const SShard& GetShard(uint32 hash) const { return m_shards [hash >> (32 - ShardBits)]; }
+
+	// Visits every entry. Locks each shard in turn.
+	template <typename TVisitor>
+	void VisitEntries(TVisitor&& visitor);
+
+	SNameEntry* Allocate(SShard& shard, const char* str, int length, uint32 hash);
+	void Grow(SShard& shard);
+
+	SShard m_shards [ShardCount];
+
 #if SHARED_STRING_TRACK_LEVEL_HEAP_LEAKS
-	bool m_trackLevelHeapAllocs;
+	std::atomic<bool> m_trackLevelHeapAllocs;
 #endif
 };
 
@@ -199,7 +198,7 @@ public:
 
 	void GetMemoryUsage(ICrySizer* pSizer) const
 	{
-		/*nothing for now*/
+		// The characters belong to the name table.
 	}
 private:
 	operator int() { return 0; }
@@ -214,15 +213,15 @@ private:
 
 	SNameEntry* _entry(const char* pBuffer) const { assert(pBuffer); return ((SNameEntry*)pBuffer) - 1; }
 	int         _length() const { return (m_str) ? _entry(m_str)->nLength : 0; }
+
+	// Entries are never released, so references only need counting when tracking strings leaked by a level.
+#if SHARED_STRING_TRACK_LEVEL_HEAP_LEAKS
 	void        _addref(const char* pBuffer) { if (pBuffer) _entry(pBuffer)->AddRef(); }
-	void        _release(const char* pBuffer)
-	{
-		if (pBuffer && _entry(pBuffer)->Release() <= 0)
-		{
-			if (CNameTable* pNT = GetNameTable())
-				pNT->Release(_entry(pBuffer));
-		}
-	}
+	void        _release(const char* pBuffer) { if (pBuffer) _entry(pBuffer)->Release(); }
+#else
+	void        _addref(const char* pBuffer) {}
+	void        _release(const char* pBuffer) {}
+#endif
 
 	const char* m_str;
 };
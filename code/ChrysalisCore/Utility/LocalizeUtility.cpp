@@ -4,12 +4,229 @@
 #include <CryString/StringUtils.h>
 #include <Utility/StringUtils.h>
 #include "LocalizeUtility.h"
+#include <unordered_map>
 
 
 namespace Chrysalis
 {
 namespace LocalizeUtility
 {
+	/** Formatted results which haven't been asked for in this many frames are dropped. */
+	static const int maxUnusedFrames = 30;
+
+	/** Formatting is done on the stack, and results longer than this are truncated. */
+	static const size_t maxFormattedLength = 2048;
+
+
+	/** The caches for one thread. */
+	struct SLocalizationCache
+	{
+		struct SKeyEntry
+		{
+			string key;
+			string localized;
+		};
+
+		struct SFormattedEntry
+		{
+			// The text and arguments, separated by nulls.
+			string key;
+			string result;
+			int lastUsedFrame { 0 };
+		};
+
+		// Keyed on the hash of the key. Entries whose hashes collide sit side by side, and an entry is never overwritten,
+		// so the pointers handed out to the text stay valid until it's dropped.
+		std::unordered_multimap<uint32, SKeyEntry> keys;
+
+		// Keyed on the hash of the text and arguments, in the same way.
+		std::unordered_multimap<uint32, SFormattedEntry> formatted;
+
+		// Holds a result whose key was too long to cache, until the next one.
+		string uncachedResult;
+
+		int frameId { -1 };
+		string language;
+	};
+
+
+	/** Gets the caches for this thread, dropping anything stale the first time it's called each frame. */
+	static SLocalizationCache& GetCache()
+	{
+		static thread_local SLocalizationCache cache;
+
+		const int frameId = gEnv->nMainFrameID;
+		if (cache.frameId != frameId)
+		{
+			cache.frameId = frameId;
+
+			// Everything we have is in the wrong language.
+			const char* szLanguage = gEnv->pSystem->GetLocalizationManager()->GetLanguage();
+			if (cache.language.compare(szLanguage ? szLanguage : "") != 0)
+			{
+				cache.language = szLanguage ? szLanguage : "";
+				cache.keys.clear();
+				cache.formatted.clear();
+			}
+
+			for (auto it = cache.formatted.begin(); it != cache.formatted.end();)
+			{
+				if (frameId - it->second.lastUsedFrame > maxUnusedFrames)
+					it = cache.formatted.erase(it);
+				else
+					++it;
+			}
+		}
+
+		return cache;
+	}
+
+
+	/** Resolves a piece of text, looking it up if it's an '@' key. */
+	static const char* ResolveText(SLocalizationCache& cache, const char* text)
+	{
+		if (!text)
+			return "";
+
+		if (text [0] != '@')
+			return text;
+
+		const uint32 hash = CryStringUtils::HashString(text);
+
+		auto range = cache.keys.equal_range(hash);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second.key.compare(text) == 0)
+				return it->second.localized.c_str();
+		}
+
+		SLocalizationCache::SKeyEntry& entry = cache.keys.emplace(hash, SLocalizationCache::SKeyEntry())->second;
+		entry.key = text;
+		gEnv->pSystem->GetLocalizationManager()->LocalizeString(text, entry.localized);
+
+		return entry.localized.c_str();
+	}
+
+
+	/** Copies the text to the buffer, replacing %1 to %4 with the parameters. Returns the length written. */
+	static size_t FormatText(char* dest, size_t bufferSizeInBytes, const char* text, const char* const params [4])
+	{
+		if (bufferSizeInBytes == 0)
+			return 0;
+
+		size_t length = 0;
+		const size_t maxLength = bufferSizeInBytes - 1;
+
+		for (const char* pChar = text; *pChar && (length < maxLength); ++pChar)
+		{
+			if ((pChar [0] == '%') && (pChar [1] >= '1') && (pChar [1] <= '4'))
+			{
+				for (const char* pParam = params [pChar [1] - '1']; *pParam && (length < maxLength); ++pParam)
+					dest [length++] = *pParam;
+
+				++pChar;
+			}
+			else
+			{
+				dest [length++] = *pChar;
+			}
+		}
+
+		dest [length] = '\0';
+
+		return length;
+	}
+
+
+	/** Formats a string into a buffer using the cached keys. */
+	static size_t FormatWithCache(SLocalizationCache& cache, char* dest, size_t bufferSizeInBytes, const char *text, const char *arg1, const char *arg2, const char *arg3, const char *arg4)
+	{
+		const char* params [4] = { ResolveText(cache, arg1), ResolveText(cache, arg2), ResolveText(cache, arg3), ResolveText(cache, arg4) };
+
+		return FormatText(dest, bufferSizeInBytes, ResolveText(cache, text), params);
+	}
+
+
+	/** Finds or makes the cached result for the text and arguments. */
+	static const string& GetFormattedString(const char *text, const char *arg1, const char *arg2, const char *arg3, const char *arg4)
+	{
+		SLocalizationCache& cache = GetCache();
+
+		// The text and arguments are joined into one key. Each is written as a marker byte followed by the text and a
+		// null, so "ab" + "c" can't match "a" + "bc". A missing argument is just a different marker, so it is a different
+		// key to an empty one, though they format the same, which is harmless.
+		const char missingMarker = '\x01';
+		const char presentMarker = '\x02';
+
+		const char* parts [5] = { text, arg1, arg2, arg3, arg4 };
+		char key [maxFormattedLength];
+		size_t keyLength = 0;
+		uint32 hash = 0;
+		bool isKeyTooLong = false;
+
+		for (const char* pPart : parts)
+		{
+			if (!pPart)
+			{
+				if (keyLength + 1 > sizeof(key))
+				{
+					isKeyTooLong = true;
+					break;
+				}
+
+				key [keyLength++] = missingMarker;
+				hash = (hash * 16777619u) ^ missingMarker;
+				continue;
+			}
+
+			const size_t partLength = strlen(pPart);
+			if (keyLength + partLength + 2 > sizeof(key))
+			{
+				isKeyTooLong = true;
+				break;
+			}
+
+			key [keyLength++] = presentMarker;
+			memcpy(key + keyLength, pPart, partLength);
+			keyLength += partLength;
+			key [keyLength++] = '\0';
+
+			hash = (hash * 16777619u) ^ CryStringUtils::HashString(pPart);
+		}
+
+		// Truncating the key would let different inputs share a result, so anything this long is formatted every time.
+		if (isKeyTooLong)
+		{
+			char result [maxFormattedLength];
+			const size_t length = FormatWithCache(cache, result, sizeof(result), text, arg1, arg2, arg3, arg4);
+			cache.uncachedResult.assign(result, length);
+
+			return cache.uncachedResult;
+		}
+
+		auto range = cache.formatted.equal_range(hash);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			SLocalizationCache::SFormattedEntry& entry = it->second;
+			if ((entry.key.length() == keyLength) && (memcmp(entry.key.data(), key, keyLength) == 0))
+			{
+				entry.lastUsedFrame = cache.frameId;
+				return entry.result;
+			}
+		}
+
+		char result [maxFormattedLength];
+		const size_t length = FormatWithCache(cache, result, sizeof(result), text, arg1, arg2, arg3, arg4);
+
+		SLocalizationCache::SFormattedEntry& entry = cache.formatted.emplace(hash, SLocalizationCache::SFormattedEntry())->second;
+		entry.key.assign(key, keyLength);
+		entry.result.assign(result, length);
+		entry.lastUsedFrame = cache.frameId;
+
+		return entry.result;
+	}
+
+
 	// ***
 	// *** Localize strings.
 	//  ***
@@ -41,58 +258,16 @@ namespace LocalizeUtility
 			return;
 		}
 
-		string localizedString, param1, param2, param3, param4;
-		ILocalizationManager* pLocMgr = gEnv->pSystem->GetLocalizationManager();
-
-		if (text [0] == '@')
-			pLocMgr->LocalizeString(text, localizedString);
-		else
-			localizedString = text;
-
-		if (arg1)
-		{
-			if (arg1 [0] == '@')
-				pLocMgr->LocalizeString(arg1, param1);
-			else
-				param1 = arg1;
-		}
-
-		if (arg2)
-		{
-			if (arg2 [0] == '@')
-				pLocMgr->LocalizeString(arg2, param2);
-			else
-				param2 = arg2;
-		}
-
-		if (arg3)
-		{
-			if (arg3 [0] == '@')
-				pLocMgr->LocalizeString(arg3, param3);
-			else
-				param3 = arg3;
-		}
-
-		if (arg4)
-		{
-			if (arg4 [0] == '@')
-				pLocMgr->LocalizeString(arg4, param4);
-			else
-				param4 = arg4;
-		}
-
-		out.resize(0);
-		pLocMgr->FormatStringMessage(out, localizedString, param1.c_str(), param2.c_str(), param3.c_str(), param4.c_str());
+		out = GetFormattedString(text, arg1, arg2, arg3, arg4);
 	}
 
 
 	const char * LocalizeString(const char *text, const char *arg1, const char *arg2, const char *arg3, const char *arg4)
 	{
-		//ScopedSwitchToGlobalHeap globalHeap;
-		static string charstr;
-		LocalizeString(charstr, text, arg1, arg2, arg3, arg4);
+		if (!text)
+			return "";
 
-		return charstr.c_str();
+		return GetFormattedString(text, arg1, arg2, arg3, arg4).c_str();
 	}
 
 
@@ -102,6 +277,12 @@ namespace LocalizeUtility
 	}
 
 
+	size_t FormatLocalizedString(char* dest, size_t bufferSizeInBytes, const char *text, const char *arg1, const char *arg2, const char *arg3, const char *arg4)
+	{
+		return FormatWithCache(GetCache(), dest, bufferSizeInBytes, text, arg1, arg2, arg3, arg4);
+	}
+
+
 	// ***
 	// *** Localize numbers.
 	// ***
@@ -111,7 +292,7 @@ namespace LocalizeUtility
 		ILocalizationManager* pLocMgr = gEnv->pSystem->GetLocalizationManager();
 
 		//ScopedSwitchToGlobalHeap globalHeap;
-		static string charstr;
+		static thread_local string charstr;
 		pLocMgr->LocalizeNumber(number, charstr);
 
 		return charstr.c_str();
@@ -137,7 +318,7 @@ namespace LocalizeUtility
 		ILocalizationManager* pLocMgr = gEnv->pSystem->GetLocalizationManager();
 
 		//ScopedSwitchToGlobalHeap globalHeap;
-		static string charstr;
+		static thread_local string charstr;
 		pLocMgr->LocalizeNumber(number, decimals, charstr);
 
 		return charstr.c_str();
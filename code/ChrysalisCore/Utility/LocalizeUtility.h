@@ -15,20 +15,50 @@ namespace LocalizeUtility
 // *** Localize strings.
 //  ***
 
+/*
+Text and arguments starting with '@' are looked up in the localization tables, and the arguments replace %1 to %4 in the
+text. Looked up keys are cached, as are the formatted results, so the same label asked for every frame costs a hash and
+a compare rather than a trip through the localization manager. A result which isn't asked for again within a short time
+is dropped, and everything is dropped when the language changes. The caches are per thread, so these can be called from
+any thread.
+*/
+
+/**
+Localizes and formats a string. The result is cached, and the pointer remains valid at least until the end of the next
+frame, so it can be passed along but shouldn't be kept. Text and arguments too long to cache are formatted each time,
+and the pointer is only valid until the next call on the same thread.
+**/
 const char * LocalizeString(const char *text, const char *arg1 = 0, const char *arg2 = 0, const char *arg3 = 0, const char *arg4 = 0);
 void LocalizeString(string &out, const char *text, const char *arg1, const char *arg2, const char *arg3, const char *arg4);
 void LocalizeStringn(char* dest, size_t bufferSizeInBytes, const char *text, const char *arg1 = 0, const char *arg2 = 0, const char *arg3 = 0, const char *arg4 = 0);
 
 
+/**
+Localizes and formats a string straight into a buffer, without touching the cache of formatted results. Useful for text
+which changes too often to be worth caching. Nothing is allocated unless a key has to be looked up for the first time.
+
+\param [out]	dest			 	The buffer. Always null terminated, and the result is truncated to fit.
+\param	bufferSizeInBytes	The size of the buffer.
+\param	text			 	The text, or '@' key for it.
+\param	arg1			 	(Optional) The text for %1, or '@' key for it.
+\param	arg2			 	(Optional) The text for %2, or '@' key for it.
+\param	arg3			 	(Optional) The text for %3, or '@' key for it.
+\param	arg4			 	(Optional) The text for %4, or '@' key for it.
+
+\return	The length of the result.
+**/
+size_t FormatLocalizedString(char* dest, size_t bufferSizeInBytes, const char *text, const char *arg1 = 0, const char *arg2 = 0, const char *arg3 = 0, const char *arg4 = 0);
+
+
 // ***
 // *** Localize numbers.
 // ***
 
 const char* LocalizeNumber(const int number);
 void LocalizeNumber(string &out, const int number);
-void LocalizeNumbern(const char* dest, size_t bufferSizeInBytes, const int number);
+void LocalizeNumbern(char* dest, size_t bufferSizeInBytes, const int number);
 const char* LocalizeNumber(const float number, int decimals);
 void LocalizeNumber(string &out, const float number, int decimals);
-void LocalizeNumbern(const char* dest, size_t bufferSizeInBytes, const float number, int decimals);
+void LocalizeNumbern(char* dest, size_t bufferSizeInBytes, const float number, int decimals);
 }
 }
\ No newline at end of file
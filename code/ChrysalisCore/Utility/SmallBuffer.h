@@ -0,0 +1,122 @@
+/**
+\file	Utility\SmallBuffer.h
+
+A non-owning view over a contiguous run of values, and a growable buffer which keeps its first few values inline.
+
+The buffer is intended for results which are rebuilt often, such as per-frame queries. Up to InlineCapacity values are
+held inside the buffer itself. Past that it spills to heap storage, which is kept when the buffer is cleared, so once
+a buffer has seen its largest result it never allocates again.
+**/
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+
+namespace Chrysalis
+{
+template<typename T>
+class CSpan
+{
+public:
+	CSpan() = default;
+	CSpan(const T* pData, size_t size) : m_pData(pData), m_size(size) {}
+
+	const T* begin() const { return m_pData; }
+	const T* end() const { return m_pData + m_size; }
+	const T* data() const { return m_pData; }
+
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+
+	const T& operator[](size_t index) const { CRY_ASSERT(index < m_size); return m_pData [index]; }
+	const T& front() const { CRY_ASSERT(m_size > 0); return m_pData [0]; }
+
+private:
+	const T* m_pData { nullptr };
+	size_t m_size { 0 };
+};
+
+
+template<typename T, size_t InlineCapacity>
+class CSmallBuffer
+{
+	static_assert(std::is_trivially_copyable<T>::value, "CSmallBuffer only supports trivially copyable types.");
+
+public:
+	CSmallBuffer() = default;
+
+	// Copies would need to fix up the data pointer, and are almost always a mistake for a result buffer anyway.
+	CSmallBuffer(const CSmallBuffer&) = delete;
+	CSmallBuffer& operator=(const CSmallBuffer&) = delete;
+
+
+	void push_back(const T& value)
+	{
+		if (m_size == m_capacity)
+			Grow(m_capacity * 2);
+
+		m_pData [m_size++] = value;
+	}
+
+
+	/** Removes all values. Any heap storage is kept for reuse. */
+	void clear() { m_size = 0; }
+
+
+	void reserve(size_t capacity)
+	{
+		if (capacity > m_capacity)
+			Grow(capacity);
+	}
+
+
+	T* begin() { return m_pData; }
+	T* end() { return m_pData + m_size; }
+	const T* begin() const { return m_pData; }
+	const T* end() const { return m_pData + m_size; }
+
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	size_t capacity() const { return m_capacity; }
+
+	T& operator[](size_t index) { CRY_ASSERT(index < m_size); return m_pData [index]; }
+	const T& operator[](size_t index) const { CRY_ASSERT(index < m_size); return m_pData [index]; }
+
+
+	/** Gets a view of the current values. It remains valid until the buffer is next changed. */
+	CSpan<T> GetSpan() const { return CSpan<T>(m_pData, m_size); }
+
+
+	void GetMemoryUsage(ICrySizer* s) const
+	{
+		s->AddContainer(m_heap);
+	}
+
+private:
+	void Grow(size_t capacity)
+	{
+		const bool isInline = m_pData != m_heap.data();
+
+		// Resizing keeps the existing values if we had already spilled to the heap.
+		if (m_heap.size() < capacity)
+			m_heap.resize(capacity);
+
+		if (isInline)
+			std::copy(m_inline, m_inline + m_size, m_heap.begin());
+
+		m_pData = m_heap.data();
+		m_capacity = m_heap.size();
+	}
+
+
+	T m_inline [InlineCapacity];
+	T* m_pData { m_inline };
+	size_t m_size { 0 };
+	size_t m_capacity { InlineCapacity };
+
+	// Storage for when there are too many values to hold inline.
+	std::vector<T> m_heap;
+};
+}